@@ -10,15 +10,16 @@ struct vOut
     float2 uv : TEXCOORD1;
 };
 
-vOut vs(vIn i)
+vOut vs(vIn i, uint instanceId : SV_InstanceID)
 {
     vOut o;
-    float4 pos = mul(float4(i.position.xyz, 1.0f), cbRenderObject.ToWorld);
+    InstanceData instance = cbInstances.Instances[instanceId];
+    float4 pos = mul(float4(i.position.xyz, 1.0f), instance.ToWorld);
     o.wPos = pos.xyz;
     pos = mul(pos, cbCamera.ViewProjection);
     o.position = pos;
 
-    o.normal = mul(float4(i.normal.xyz, 0.0f), cbRenderObject.ToWorld).xyz;
+    o.normal = mul(float4(i.normal.xyz, 0.0f), instance.ToWorld).xyz;
     o.uv = i.uv;
     return o;
 }
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Math/MathBatch.h"
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 SmallCount = 1000;
+constexpr uint32 LargeCount = 1000000;
+constexpr uint64 ElementsPerSize = 20000000; // Elements processed by one case, so both sizes run for similar time.
+
+struct BatchInputs
+{
+    std::vector<Vector3> Points;
+    std::vector<Vector3> Scales;
+    std::vector<Quaternion> Rotations;
+    std::vector<Matrix4> Matrices;
+    std::vector<Matrix4> OtherMatrices;
+};
+
+BatchInputs MakeInputs(uint32 count)
+{
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float32> value(-10.0f, 10.0f);
+    std::uniform_real_distribution<float32> angle(-Math::PI, Math::PI);
+    std::uniform_real_distribution<float32> scale(0.5f, 2.0f);
+    BatchInputs inputs;
+    inputs.Points.resize(count);
+    inputs.Scales.resize(count);
+    inputs.Rotations.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        inputs.Points[i] = { value(random), value(random), value(random) };
+        inputs.Scales[i] = { scale(random), scale(random), scale(random) };
+        inputs.Rotations[i] = Quaternion::FromEuler(angle(random), angle(random), angle(random));
+    }
+    inputs.Matrices.resize(count);
+    inputs.OtherMatrices.resize(count);
+    Math::Batch::ComposeMatrices(inputs.Points.data(), inputs.Rotations.data(), inputs.Scales.data(), inputs.Matrices.data(), count);
+    Math::Batch::ComposeMatrices(inputs.Points.data(), inputs.Rotations.data(), inputs.Scales.data(), inputs.OtherMatrices.data(), count);
+    std::reverse(inputs.OtherMatrices.begin(), inputs.OtherMatrices.end());
+    return inputs;
+}
+
+void MeasureSize(uint32 count, const char* sizeName)
+{
+    const BatchInputs inputs = MakeInputs(count);
+    const Matrix4& m = inputs.Matrices[0];
+    const uint32 iterationsCount = static_cast<uint32>(ElementsPerSize / count);
+    std::vector<Vector3> points(count);
+    std::vector<Matrix4> matrices(count);
+    auto name = [sizeName](const char* caseName) { return std::string(caseName) + ", " + sizeName; };
+
+    Measure(name("Transform points one by one").c_str(), count, iterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const Vector3& p = inputs.Points[i];
+            Vector4 res = Vector4(p.x, p.y, p.z, 1.0f) * m;
+            points[i] = { res.x, res.y, res.z };
+        }
+    });
+    KeepAlive(points[count / 2]);
+    Measure(name("TransformPoints").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::TransformPoints(m, inputs.Points.data(), points.data(), count);
+    });
+    KeepAlive(points[count / 2]);
+    Measure(name("TransformNormals").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::TransformNormals(m, inputs.Points.data(), sizeof(Vector3), points.data(), sizeof(Vector3), count);
+    });
+    KeepAlive(points[count / 2]);
+
+    std::vector<float32> x(count);
+    std::vector<float32> y(count);
+    std::vector<float32> z(count);
+    Math::Batch::AosToSoa(inputs.Points.data(), sizeof(Vector3), count, x.data(), y.data(), z.data());
+    Measure(name("TransformPointsSoa").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::TransformPointsSoa(m, x.data(), y.data(), z.data(), count);
+    });
+    KeepAlive(x[count / 2]);
+    Measure(name("AosToSoa and SoaToAos").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::AosToSoa(inputs.Points.data(), sizeof(Vector3), count, x.data(), y.data(), z.data());
+        Math::Batch::SoaToAos(x.data(), y.data(), z.data(), count, points.data(), sizeof(Vector3));
+    });
+    KeepAlive(points[count / 2]);
+
+    Measure(name("Multiply matrices one by one").c_str(), count, iterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+            matrices[i] = inputs.Matrices[i] * inputs.OtherMatrices[i];
+    });
+    KeepAlive(matrices[count / 2]);
+    Measure(name("MultiplyMatrices").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::MultiplyMatrices(inputs.Matrices.data(), inputs.OtherMatrices.data(), matrices.data(), count);
+    });
+    KeepAlive(matrices[count / 2]);
+    Measure(name("ComposeMatrices").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::ComposeMatrices(inputs.Points.data(), inputs.Rotations.data(), inputs.Scales.data(), matrices.data(), count);
+    });
+    KeepAlive(matrices[count / 2]);
+    Measure(name("InverseMatrices").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::InverseMatrices(inputs.Matrices.data(), matrices.data(), count);
+    });
+    KeepAlive(matrices[count / 2]);
+    Measure(name("InverseOrthonormMatrices").c_str(), count, iterationsCount, [&]()
+    {
+        Math::Batch::InverseOrthonormMatrices(inputs.Matrices.data(), matrices.data(), count);
+    });
+    KeepAlive(matrices[count / 2]);
+}
+}
+
+void RunBatchMathBenchmarks()
+{
+    MeasureSize(SmallCount, "1K");
+    MeasureSize(LargeCount, "1M");
+}
+}
\ No newline at end of file
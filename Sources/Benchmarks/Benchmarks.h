@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Benchmarks
+{
+///
+/// Sink for results of measured code, written through volatile so the optimizer can't drop the computation.
+///
+inline volatile uint64 ResultsSink = 0;
+
+///
+/// Benchmark groups, each group is one function measuring all its cases.
+///
+void RunEcsBenchmarks();
+void RunJobBenchmarks();
+void RunMathBenchmarks();
+void RunBatchMathBenchmarks();
+void RunTransformBenchmarks();
+void RunRenderCommandBenchmarks();
+void RunFrameBenchmarks();
+void RunCullingBenchmarks();
+void RunBoundingVolumeHierarchyBenchmarks();
+void RunHandleTableBenchmarks();
+
+///
+/// Call f once to warm caches up, then iterationsCount times, and print average time of a call and of one of its elementsCount elements.
+///
+template <typename F>
+void Measure(const char* name, uint64 elementsCount, uint32 iterationsCount, F&& f);
+
+///
+/// Make value observable, so code computing it is not optimized out.
+///
+template <typename T>
+void KeepAlive(const T& value);
+
+template <typename F>
+void Measure(const char* name, uint64 elementsCount, uint32 iterationsCount, F&& f)
+{
+    f();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32 i = 0; i < iterationsCount; ++i)
+        f();
+    std::chrono::duration<float64, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+    float64 callTime = time.count() / iterationsCount;
+    std::printf("  %-56s %12.3f ms %12.2f ns/element\n", name, callTime, callTime * 1000000.0 / static_cast<float64>(elementsCount));
+}
+
+template <typename T>
+inline void KeepAlive(const T& value)
+{
+    ResultsSink = ResultsSink + *reinterpret_cast<const volatile byte*>(&value);
+}
+}
\ No newline at end of file
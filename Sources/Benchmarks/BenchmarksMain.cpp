@@ -0,0 +1,44 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <cstring>
+
+namespace
+{
+struct BenchmarkGroup
+{
+    const char* Name;
+    void(*Run)();
+};
+
+const BenchmarkGroup Groups[] =
+{
+    { "Ecs", &Kioto::Benchmarks::RunEcsBenchmarks },
+    { "Jobs", &Kioto::Benchmarks::RunJobBenchmarks },
+    { "Transforms", &Kioto::Benchmarks::RunTransformBenchmarks },
+    { "Math", &Kioto::Benchmarks::RunMathBenchmarks },
+    { "BatchMath", &Kioto::Benchmarks::RunBatchMathBenchmarks },
+    { "RenderCommands", &Kioto::Benchmarks::RunRenderCommandBenchmarks },
+    { "Culling", &Kioto::Benchmarks::RunCullingBenchmarks },
+    { "BoundingVolumeHierarchy", &Kioto::Benchmarks::RunBoundingVolumeHierarchyBenchmarks },
+    { "HandleTable", &Kioto::Benchmarks::RunHandleTableBenchmarks },
+    { "Frames", &Kioto::Benchmarks::RunFrameBenchmarks },
+};
+}
+
+///
+/// CPU benchmarks of engine parts which don't need window or GPU. Runs all groups, or only groups whose name contains the first argument.
+/// Build in Release, Debug timings are meaningless.
+///
+int main(int argc, char* argv[])
+{
+    for (const auto& group : Groups)
+    {
+        if (argc > 1 && std::strstr(group.Name, argv[1]) == nullptr)
+            continue;
+        std::printf("%s\n", group.Name);
+        group.Run();
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Core/DataStructures/BoundingVolumeHierarchy.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Frustum.h"
+#include "Math/Matrix4.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+using Hierarchy = BoundingVolumeHierarchy<uint32>;
+
+constexpr float32 SceneHalfSize = 500.0f;
+constexpr uint32 QueriesCount = 1000;
+constexpr uint32 IterationsCount = 10;
+constexpr float32 JitterOffset = 0.05f; // Less than fat margin of the smallest box, such moves don't change the tree.
+constexpr float32 FarOffset = 20.0f; // Leaves the fat box of any box, such moves reinsert the leaf.
+
+std::vector<BoundingBox> MakeBoxes(uint32 count)
+{
+    std::mt19937 random(29);
+    std::uniform_real_distribution<float32> position(-SceneHalfSize, SceneHalfSize);
+    std::uniform_real_distribution<float32> size(0.5f, 2.0f);
+    std::vector<BoundingBox> boxes(count);
+    for (auto& box : boxes)
+    {
+        Vector3 center = { position(random), position(random), position(random) };
+        float32 halfSize = size(random);
+        box.Min = { center.x - halfSize, center.y - halfSize, center.z - halfSize };
+        box.Max = { center.x + halfSize, center.y + halfSize, center.z + halfSize };
+    }
+    return boxes;
+}
+
+BoundingBox Offset(const BoundingBox& box, float32 offset)
+{
+    return { { box.Min.x + offset, box.Min.y, box.Min.z }, { box.Max.x + offset, box.Max.y, box.Max.z } };
+}
+
+void Build(Hierarchy& hierarchy, const std::vector<BoundingBox>& boxes, std::vector<uint32>& proxies)
+{
+    hierarchy.Clear();
+    for (uint32 i = 0; i < static_cast<uint32>(boxes.size()); ++i)
+        proxies[i] = hierarchy.Insert(boxes[i], i);
+}
+
+void MeasureSize(uint32 count, const char* sizeName, uint32 buildIterationsCount)
+{
+    const std::vector<BoundingBox> boxes = MakeBoxes(count);
+    auto name = [sizeName](const char* caseName) { return std::string(caseName) + ", " + sizeName; };
+
+    Hierarchy hierarchy;
+    std::vector<uint32> proxies(count);
+    Measure(name("Build by insertion").c_str(), count, buildIterationsCount, [&]()
+    {
+        Build(hierarchy, boxes, proxies);
+    });
+    std::printf("    height %u\n", hierarchy.GetHeight());
+
+    // Every iteration moves boxes there and back, so the tree doesn't drift away from the built one.
+    float32 direction = 1.0f;
+    Measure(name("Move all boxes inside fat boxes").c_str(), count, IterationsCount, [&]()
+    {
+        direction = -direction;
+        float32 offset = direction > 0.0f ? JitterOffset : 0.0f;
+        for (uint32 i = 0; i < count; ++i)
+            hierarchy.Move(proxies[i], Offset(boxes[i], offset));
+    });
+    const uint32 farMovesCount = count / 100;
+    const uint32 farMovesStep = count / farMovesCount;
+    Measure(name("Move 1% of boxes out of fat boxes").c_str(), farMovesCount, IterationsCount, [&]()
+    {
+        direction = -direction;
+        float32 offset = direction > 0.0f ? FarOffset : 0.0f;
+        for (uint32 i = 0; i < farMovesCount; ++i)
+            hierarchy.Move(proxies[i * farMovesStep], Offset(boxes[i * farMovesStep], offset));
+    });
+
+    Matrix4 view = Matrix4::BuildLookAt({ 0.0f, 0.0f, -1.5f * SceneHalfSize }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    const Frustum wideFrustum = Frustum::FromViewProjection(view * Matrix4::BuildProjectionFov(1.0f, 16.0f / 9.0f, 0.1f, 4.0f * SceneHalfSize));
+    const Frustum narrowFrustum = Frustum::FromViewProjection(view * Matrix4::BuildProjectionFov(0.1f, 16.0f / 9.0f, 0.1f, 4.0f * SceneHalfSize));
+    uint32 visibleCount = 0;
+    Measure(name("Frustum test of every box").c_str(), count, IterationsCount, [&]()
+    {
+        visibleCount = 0;
+        for (const auto& box : boxes)
+            visibleCount += narrowFrustum.Intersects(box) ? 1 : 0;
+    });
+    std::printf("    visible %u\n", visibleCount);
+    Measure(name("QueryFrustum, narrow frustum").c_str(), count, IterationsCount, [&]()
+    {
+        visibleCount = 0;
+        hierarchy.QueryFrustum(narrowFrustum, [&visibleCount](uint32) { ++visibleCount; });
+    });
+    std::printf("    visible %u\n", visibleCount);
+    Measure(name("QueryFrustum, wide frustum").c_str(), count, IterationsCount, [&]()
+    {
+        visibleCount = 0;
+        hierarchy.QueryFrustum(wideFrustum, [&visibleCount](uint32) { ++visibleCount; });
+    });
+    std::printf("    visible %u\n", visibleCount);
+
+    std::mt19937 random(31);
+    std::uniform_real_distribution<float32> position(-SceneHalfSize, SceneHalfSize);
+    std::vector<Vector3> points(QueriesCount);
+    for (auto& point : points)
+        point = { position(random), position(random), position(random) };
+    uint64 hitsCount = 0;
+    Measure(name("1000 QuerySphere of radius 10").c_str(), QueriesCount, IterationsCount, [&]()
+    {
+        for (const auto& point : points)
+            hierarchy.QuerySphere(point, 10.0f, [&hitsCount](uint32) { ++hitsCount; });
+    });
+    KeepAlive(hitsCount);
+    Measure(name("1000 closest hit RayCast").c_str(), QueriesCount, IterationsCount, [&]()
+    {
+        for (const auto& point : points)
+        {
+            Vector3 origin = { point.x, point.y, -SceneHalfSize };
+            hierarchy.RayCast(origin, { 0.0f, 0.0f, 1.0f }, 2.0f * SceneHalfSize, [&hitsCount](uint32, float32 distance)
+            {
+                ++hitsCount;
+                return distance;
+            });
+        }
+    });
+    KeepAlive(hitsCount);
+}
+}
+
+void RunBoundingVolumeHierarchyBenchmarks()
+{
+    MeasureSize(100000, "100k", 5);
+    MeasureSize(1000000, "1M", 2);
+}
+}
\ No newline at end of file
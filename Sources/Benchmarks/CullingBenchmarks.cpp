@@ -0,0 +1,149 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Core/Jobs/JobSystem.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Frustum.h"
+#include "Math/Matrix4.h"
+#include "Render/Culling.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 ObjectsCount = 1000000;
+constexpr uint32 IterationsCount = 20;
+constexpr float32 SceneHalfSize = 500.0f; // Camera stands outside of the scene box, about three quarters of objects are visible.
+
+struct CullingInputs
+{
+    std::vector<BoundingSphere> Spheres;
+    std::vector<BoundingBox> Boxes;
+    std::vector<Matrix4> ToWorld;
+    std::vector<float32> X;
+    std::vector<float32> Y;
+    std::vector<float32> Z;
+    std::vector<float32> Radius;
+};
+
+Frustum MakeFrustum()
+{
+    Matrix4 view = Matrix4::BuildLookAt({ 0.0f, 0.0f, -1.5f * SceneHalfSize }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    Matrix4 projection = Matrix4::BuildProjectionFov(1.0f, 16.0f / 9.0f, 0.1f, 4.0f * SceneHalfSize);
+    return Frustum::FromViewProjection(view * projection);
+}
+
+CullingInputs MakeInputs()
+{
+    std::mt19937 random(23);
+    std::uniform_real_distribution<float32> position(-SceneHalfSize, SceneHalfSize);
+    std::uniform_real_distribution<float32> size(0.5f, 2.0f);
+    CullingInputs inputs;
+    inputs.Spheres.resize(ObjectsCount);
+    inputs.Boxes.resize(ObjectsCount);
+    inputs.ToWorld.resize(ObjectsCount);
+    inputs.X.resize(ObjectsCount);
+    inputs.Y.resize(ObjectsCount);
+    inputs.Z.resize(ObjectsCount);
+    inputs.Radius.resize(ObjectsCount);
+    for (uint32 i = 0; i < ObjectsCount; ++i)
+    {
+        Vector3 center = { position(random), position(random), position(random) };
+        float32 halfSize = size(random);
+        inputs.Spheres[i].Center = center;
+        inputs.Spheres[i].Radius = halfSize * 1.7320508f;
+        inputs.Boxes[i].Min = { center.x - halfSize, center.y - halfSize, center.z - halfSize };
+        inputs.Boxes[i].Max = { center.x + halfSize, center.y + halfSize, center.z + halfSize };
+        inputs.ToWorld[i] = Matrix4::BuildTranslation(center);
+        inputs.X[i] = center.x;
+        inputs.Y[i] = center.y;
+        inputs.Z[i] = center.z;
+        inputs.Radius[i] = inputs.Spheres[i].Radius;
+    }
+    return inputs;
+}
+
+uint32 CountVisible(const std::vector<uint8>& visible)
+{
+    uint32 res = 0;
+    for (uint8 v : visible)
+        res += v;
+    return res;
+}
+}
+
+void RunCullingBenchmarks()
+{
+    const Frustum frustum = MakeFrustum();
+    const CullingInputs inputs = MakeInputs();
+    std::vector<uint8> visible(ObjectsCount);
+
+    Measure("Cull 1M spheres one by one", ObjectsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ObjectsCount; ++i)
+            visible[i] = frustum.Intersects(inputs.Spheres[i]) ? 1 : 0;
+    });
+    std::printf("    visible %u\n", CountVisible(visible));
+    Measure("Cull 1M spheres, CullSpheres", ObjectsCount, IterationsCount, [&]()
+    {
+        Renderer::Culling::CullSpheres(frustum, inputs.X.data(), inputs.Y.data(), inputs.Z.data(), inputs.Radius.data(), ObjectsCount, visible.data());
+    });
+    std::printf("    visible %u\n", CountVisible(visible));
+    Measure("Cull 1M boxes one by one", ObjectsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ObjectsCount; ++i)
+            visible[i] = frustum.Intersects(inputs.Boxes[i]) ? 1 : 0;
+    });
+    std::printf("    visible %u\n", CountVisible(visible));
+
+    // Objects keep local bounds and world matrix, as render objects do, so bounds are transformed every frame.
+    const BoundingSphere localSphere = { { 0.0f, 0.0f, 0.0f }, 1.7320508f };
+    const BoundingBox localBox = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+    Measure("Transform and cull 1M boxes one by one", ObjectsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ObjectsCount; ++i)
+            visible[i] = frustum.Intersects(localBox.Transformed(inputs.ToWorld[i])) ? 1 : 0;
+    });
+    KeepAlive(visible[ObjectsCount / 2]);
+
+    auto transformAndCullSpheres = [&](uint32 begin, uint32 end)
+    {
+        constexpr uint32 grainSize = Renderer::Culling::GrainSize;
+        float32 x[grainSize];
+        float32 y[grainSize];
+        float32 z[grainSize];
+        float32 radius[grainSize];
+        for (uint32 first = begin; first < end; first += grainSize)
+        {
+            uint32 count = (std::min)(grainSize, end - first);
+            for (uint32 i = 0; i < count; ++i)
+            {
+                BoundingSphere sphere = localSphere.Transformed(inputs.ToWorld[first + i]);
+                x[i] = sphere.Center.x;
+                y[i] = sphere.Center.y;
+                z[i] = sphere.Center.z;
+                radius[i] = sphere.Radius;
+            }
+            Renderer::Culling::CullSpheres(frustum, x, y, z, radius, count, visible.data() + first);
+        }
+    };
+    Measure("Transform and cull 1M spheres, CullSpheres", ObjectsCount, IterationsCount, [&]()
+    {
+        transformAndCullSpheres(0, ObjectsCount);
+    });
+    KeepAlive(visible[ObjectsCount / 2]);
+
+    JobSystem::Init();
+    Measure("Transform and cull 1M spheres, CullSpheres on workers", ObjectsCount, IterationsCount, [&]()
+    {
+        JobSystem::ParallelFor(0, ObjectsCount, Renderer::Culling::GrainSize, transformAndCullSpheres);
+    });
+    std::printf("    visible %u\n", CountVisible(visible));
+    JobSystem::Shutdown();
+}
+}
\ No newline at end of file
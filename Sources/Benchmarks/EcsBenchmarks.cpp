@@ -0,0 +1,108 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Core/ECS/ComponentPool.h"
+#include "Math/Vector3.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 ComponentsCount = 100000;
+constexpr uint32 IterationsCount = 50;
+constexpr uint32 BenchSceneIndex = 0;
+
+///
+/// Size of a small gameplay component, e.g. transform with cached state.
+///
+struct BenchComponent
+{
+    Vector3 Position;
+    Vector3 Velocity;
+    float32 Payload[10] = {};
+};
+
+void Integrate(BenchComponent& component)
+{
+    component.Position += component.Velocity * 0.016f;
+}
+
+///
+/// Components allocated one by one with other allocations in between and visited in entity order, as with per-entity pointer vectors.
+///
+void MeasureScatteredPointers()
+{
+    std::vector<std::unique_ptr<BenchComponent>> components;
+    std::vector<std::unique_ptr<byte[]>> fragmentation;
+    components.reserve(ComponentsCount);
+    fragmentation.reserve(ComponentsCount);
+    for (uint32 i = 0; i < ComponentsCount; ++i)
+    {
+        components.push_back(std::make_unique<BenchComponent>());
+        components.back()->Velocity = { 1.0f, 2.0f, 3.0f };
+        fragmentation.push_back(std::make_unique<byte[]>(64 + i % 7 * 48));
+    }
+
+    std::vector<BenchComponent*> order(ComponentsCount);
+    for (uint32 i = 0; i < ComponentsCount; ++i)
+        order[i] = components[i].get();
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+    Measure("Iterate 100k scattered components by pointers", ComponentsCount, IterationsCount, [&order]()
+    {
+        for (BenchComponent* component : order)
+            Integrate(*component);
+    });
+    KeepAlive(order[0]->Position);
+}
+
+void MeasurePool()
+{
+    ComponentPool<BenchComponent> pool;
+    std::vector<BenchComponent*> components(ComponentsCount);
+    Measure("Allocate and free 100k pooled components", ComponentsCount, IterationsCount, [&pool, &components]()
+    {
+        for (uint32 i = 0; i < ComponentsCount; ++i)
+            components[i] = new (pool.Allocate()) BenchComponent();
+        for (uint32 i = 0; i < ComponentsCount; ++i)
+            pool.Deallocate(components[i]);
+    });
+
+    for (uint32 i = 0; i < ComponentsCount; ++i)
+    {
+        components[i] = new (pool.Allocate()) BenchComponent();
+        components[i]->Velocity = { 1.0f, 2.0f, 3.0f };
+        ComponentPoolBase::SetActive(components[i], BenchSceneIndex, true);
+    }
+
+    Measure("Iterate 100k pooled components with ForEach", ComponentsCount, IterationsCount, [&pool]()
+    {
+        pool.ForEach(BenchSceneIndex, [](BenchComponent& component) { Integrate(component); });
+    });
+
+    // Every other component is inactive, e.g. entities of the other scene.
+    for (uint32 i = 0; i < ComponentsCount; i += 2)
+        ComponentPoolBase::SetActive(components[i], BenchSceneIndex, false);
+    Measure("Iterate 50k of 100k pooled components with ForEach", ComponentsCount / 2, IterationsCount, [&pool]()
+    {
+        pool.ForEach(BenchSceneIndex, [](BenchComponent& component) { Integrate(component); });
+    });
+    KeepAlive(components[1]->Position);
+
+    for (auto component : components)
+        pool.Deallocate(component);
+}
+}
+
+void RunEcsBenchmarks()
+{
+    MeasureScatteredPointers();
+    MeasurePool();
+}
+}
\ No newline at end of file
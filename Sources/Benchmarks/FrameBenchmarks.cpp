@@ -0,0 +1,108 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <random>
+#include <string>
+
+#include "Component/CameraComponent.h"
+#include "Component/RenderComponent.h"
+#include "Component/TransformComponent.h"
+#include "Core/ECS/Entity.h"
+#include "Core/KiotoEngine.h"
+#include "Core/Scene.h"
+#include "Render/Renderer.h"
+#include "Render/RenderOptions.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 WarmupFramesCount = 16; // Pipeline states finish compiling and frame arenas grow to the peak.
+constexpr float32 SceneHalfSize = 50.0f;
+
+///
+/// Cubes sharing material and mesh, scattered in a box which main camera sees whole, so all of them pass culling.
+///
+void CreateScene(uint32 objectsCount)
+{
+    Scene* scene = new Scene("FrameBenchmarks");
+    SetScene(scene);
+
+    Entity* camera = new Entity();
+    camera->SetName("Camera");
+    camera->AddComponent(new TransformComponent());
+    CameraComponent* cameraComponent = new CameraComponent(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    cameraComponent->SetIsMain(true);
+    camera->AddComponent(cameraComponent);
+    camera->GetTransform()->SetLocalPosition({ 0.0f, 0.0f, -10.0f * SceneHalfSize });
+    scene->AddEntity(camera);
+
+    std::mt19937 random(19);
+    std::uniform_real_distribution<float32> position(-SceneHalfSize, SceneHalfSize);
+    for (uint32 i = 0; i < objectsCount; ++i)
+    {
+        Entity* entity = new Entity();
+        entity->SetName("Box" + std::to_string(i));
+        entity->AddComponent(new TransformComponent());
+        RenderComponent* renderComponent = new RenderComponent();
+        renderComponent->SetMaterial("Materials/UnlitRandMbrick.mt");
+        renderComponent->SetMesh("Models/Cube.glb");
+        entity->AddComponent(renderComponent);
+        entity->GetTransform()->SetLocalPosition({ position(random), position(random), position(random) });
+        scene->AddEntity(entity);
+    }
+}
+
+void MeasureFrames(const char* name, uint32 objectsCount, uint32 iterationsCount)
+{
+    for (uint32 i = 0; i < WarmupFramesCount; ++i)
+        KiotoCore::Update();
+    Measure(name, objectsCount, iterationsCount, []()
+    {
+        KiotoCore::Update();
+    });
+    const Renderer::RenderStats& stats = Renderer::GetLastFrameStats();
+    std::printf("    draws %u, instances %u, cb bindings %u, validation errors %u\n", stats.DrawsCount, stats.InstancesCount, stats.ConstantBufferBindings,
+        stats.ValidationErrors);
+}
+
+void MeasureInstancing(uint32 objectsCount, const char* sizeName, uint32 iterationsCount)
+{
+    CreateScene(objectsCount);
+    RenderOptions& settings = KiotoCore::GetRenderSettings();
+    settings.Instancing = false;
+    MeasureFrames((std::string("Frame of ") + sizeName + " cubes, instancing off").c_str(), objectsCount, iterationsCount);
+    settings.Instancing = true;
+    MeasureFrames((std::string("Frame of ") + sizeName + " cubes, instancing on").c_str(), objectsCount, iterationsCount);
+}
+
+///
+/// Without instancing every object goes through BuildRenderPackets as its own packet, resolving its buffers, constants and
+/// texture set by interned ids.
+///
+void MeasureRenderPackets()
+{
+    CreateScene(50000);
+    RenderOptions& settings = KiotoCore::GetRenderSettings();
+    settings.Instancing = false;
+    MeasureFrames("Frame of 50k cubes, packet per object", 50000, 20);
+    settings.Instancing = true;
+}
+
+///
+/// Engine is initialized once per process, so all cases run inside the init callback of one headless run of zero frames.
+///
+void RunCases()
+{
+    MeasureInstancing(10000, "10k", 50);
+    MeasureInstancing(100000, "100k", 10);
+    MeasureRenderPackets();
+}
+}
+
+void RunFrameBenchmarks()
+{
+    KiotoHeadlessMain("", 0, &RunCases);
+}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Render/HandleTable.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+using namespace Renderer;
+
+constexpr uint32 LookupsCount = 1000000;
+constexpr uint32 IterationsCount = 20;
+constexpr uint32 HandlesStep = 3; // Handles are shared by all resource types, so one table gets every few handles.
+
+struct Resource
+{
+    uint64 Data[4] = {};
+};
+
+void MeasureSize(uint32 resourcesCount, const char* sizeName)
+{
+    std::vector<Resource> resources(resourcesCount);
+    std::vector<MeshHandle> handles(resourcesCount);
+    HandleTable<MeshHandle, Resource*> table;
+    std::map<MeshHandle, Resource*> map;
+    std::unordered_map<uint32, Resource*> unorderedMap;
+    for (uint32 i = 0; i < resourcesCount; ++i)
+    {
+        handles[i] = MeshHandle(1 + i * HandlesStep);
+        resources[i].Data[0] = i;
+        table[handles[i]] = &resources[i];
+        map[handles[i]] = &resources[i];
+        unorderedMap[handles[i].GetHandle()] = &resources[i];
+    }
+
+    // Draws come in sort key order, which is unrelated to the order resources were created in.
+    std::mt19937 random(37);
+    std::uniform_int_distribution<uint32> index(0, resourcesCount - 1);
+    std::vector<MeshHandle> lookups(LookupsCount);
+    for (auto& handle : lookups)
+        handle = handles[index(random)];
+
+    auto name = [sizeName](const char* caseName) { return std::string("1M lookups in ") + sizeName + " resources, " + caseName; };
+    uint64 sum = 0;
+    Measure(name("HandleTable").c_str(), LookupsCount, IterationsCount, [&]()
+    {
+        for (MeshHandle handle : lookups)
+            sum += (*table.Find(handle))->Data[0];
+    });
+    KeepAlive(sum);
+    Measure(name("std::map").c_str(), LookupsCount, IterationsCount, [&]()
+    {
+        for (MeshHandle handle : lookups)
+            sum += map.find(handle)->second->Data[0];
+    });
+    KeepAlive(sum);
+    Measure(name("std::unordered_map").c_str(), LookupsCount, IterationsCount, [&]()
+    {
+        for (MeshHandle handle : lookups)
+            sum += unorderedMap.find(handle.GetHandle())->second->Data[0];
+    });
+    KeepAlive(sum);
+}
+}
+
+void RunHandleTableBenchmarks()
+{
+    MeasureSize(1000, "1k");
+    MeasureSize(100000, "100k");
+}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Jobs/JobSystem.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 EmptyJobsCount = 100000;
+constexpr uint32 ElementsCount = 1 << 20;
+constexpr uint32 GrainSize = 4096;
+constexpr uint32 MaxWorkersCount = 64;
+constexpr uint32 IterationsCount = 20;
+
+void MeasureSpawnOverhead(uint32 workersCount)
+{
+    JobSystem::Init(workersCount);
+    std::atomic<uint32> doneCount = 0;
+    std::string name = "Run and wait 100k empty jobs, " + std::to_string(workersCount) + " workers";
+    Measure(name.c_str(), EmptyJobsCount, IterationsCount, [&doneCount]()
+    {
+        JobSystem::JobCounter counter;
+        for (uint32 i = 0; i < EmptyJobsCount; ++i)
+            JobSystem::Run([&doneCount]() { doneCount.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        JobSystem::Wait(&counter);
+    });
+    KeepAlive(doneCount.load());
+    JobSystem::Shutdown();
+}
+
+void MeasureParallelFor(uint32 workersCount, std::vector<float32>& values)
+{
+    JobSystem::Init(workersCount);
+    std::string name = "ParallelFor over 1M elements, " + std::to_string(workersCount) + " workers";
+    Measure(name.c_str(), ElementsCount, IterationsCount, [&values]()
+    {
+        JobSystem::ParallelFor(0, ElementsCount, GrainSize, [&values](uint32 begin, uint32 end)
+        {
+            for (uint32 i = begin; i < end; ++i)
+                values[i] = std::sqrt(values[i] * 0.5f + 1.0f) + std::sin(values[i]);
+        });
+    });
+    KeepAlive(values[ElementsCount / 2]);
+    JobSystem::Shutdown();
+}
+}
+
+void RunJobBenchmarks()
+{
+    // Engine is not initialized by the benchmarks, so every case starts its own workers.
+    uint32 hardwareThreadsCount = (std::min)((std::max)(std::thread::hardware_concurrency(), 1u), MaxWorkersCount);
+    MeasureSpawnOverhead(1); // Jobs run inline, no queues.
+    MeasureSpawnOverhead((std::max)(hardwareThreadsCount, 2u));
+
+    std::vector<float32> values(ElementsCount, 1.0f);
+    for (uint32 workersCount = 1; workersCount < hardwareThreadsCount; workersCount *= 2)
+        MeasureParallelFor(workersCount, values);
+    MeasureParallelFor(hardwareThreadsCount, values);
+}
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector4.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 ElementsCount = 10000; // Inputs and outputs stay in cache, so arithmetic is measured rather than memory.
+constexpr uint32 IterationsCount = 200;
+
+///
+/// Formulas of the generic Matrix4_<T> templates, which float32 specializations replace, as the baseline for SIMD code.
+///
+namespace Scalar
+{
+void Multiply(const Matrix4& a, const Matrix4& b, Matrix4& res)
+{
+    for (uint32 row = 0; row < 4; ++row)
+    {
+        for (uint32 col = 0; col < 4; ++col)
+        {
+            res.data[row * 4 + col] = a.data[row * 4] * b.data[col] + a.data[row * 4 + 1] * b.data[4 + col]
+                + a.data[row * 4 + 2] * b.data[8 + col] + a.data[row * 4 + 3] * b.data[12 + col];
+        }
+    }
+}
+
+Vector4 Transform(const Vector4& v, const Matrix4& m)
+{
+    return {
+        v.x * m._00 + v.y * m._10 + v.z * m._20 + v.w * m._30,
+        v.x * m._01 + v.y * m._11 + v.z * m._21 + v.w * m._31,
+        v.x * m._02 + v.y * m._12 + v.z * m._22 + v.w * m._32,
+        v.x * m._03 + v.y * m._13 + v.z * m._23 + v.w * m._33
+    };
+}
+
+Matrix4 Transposed(const Matrix4& m)
+{
+    Matrix4 res;
+    for (uint32 row = 0; row < 4; ++row)
+    {
+        for (uint32 col = 0; col < 4; ++col)
+            res.data[col * 4 + row] = m.data[row * 4 + col];
+    }
+    return res;
+}
+
+bool Inversed(const Matrix4& m, Matrix4& res)
+{
+    float32 d = m.Determinant();
+    if (Math::IsZero(d))
+        return false;
+    d = 1.0f / d;
+
+    res._00 = d * (m._11 * (m._22 * m._33 - m._32 * m._23) + m._21 * (m._32 * m._13 - m._12 * m._33) + m._31 * (m._12 * m._23 - m._22 * m._13));
+    res._10 = d * (m._12 * (m._20 * m._33 - m._30 * m._23) + m._22 * (m._30 * m._13 - m._10 * m._33) + m._32 * (m._10 * m._23 - m._20 * m._13));
+    res._20 = d * (m._13 * (m._20 * m._31 - m._30 * m._21) + m._23 * (m._30 * m._11 - m._10 * m._31) + m._33 * (m._10 * m._21 - m._20 * m._11));
+    res._30 = d * (m._10 * (m._31 * m._22 - m._21 * m._32) + m._20 * (m._11 * m._32 - m._31 * m._12) + m._30 * (m._21 * m._12 - m._11 * m._22));
+    res._01 = d * (m._21 * (m._02 * m._33 - m._32 * m._03) + m._31 * (m._22 * m._03 - m._02 * m._23) + m._01 * (m._32 * m._23 - m._22 * m._33));
+    res._11 = d * (m._22 * (m._00 * m._33 - m._30 * m._03) + m._32 * (m._20 * m._03 - m._00 * m._23) + m._02 * (m._30 * m._23 - m._20 * m._33));
+    res._21 = d * (m._23 * (m._00 * m._31 - m._30 * m._01) + m._33 * (m._20 * m._01 - m._00 * m._21) + m._03 * (m._30 * m._21 - m._20 * m._31));
+    res._31 = d * (m._20 * (m._31 * m._02 - m._01 * m._32) + m._30 * (m._01 * m._22 - m._21 * m._02) + m._00 * (m._21 * m._32 - m._31 * m._22));
+    res._02 = d * (m._31 * (m._02 * m._13 - m._12 * m._03) + m._01 * (m._12 * m._33 - m._32 * m._13) + m._11 * (m._32 * m._03 - m._02 * m._33));
+    res._12 = d * (m._32 * (m._00 * m._13 - m._10 * m._03) + m._02 * (m._10 * m._33 - m._30 * m._13) + m._12 * (m._30 * m._03 - m._00 * m._33));
+    res._22 = d * (m._33 * (m._00 * m._11 - m._10 * m._01) + m._03 * (m._10 * m._31 - m._30 * m._11) + m._13 * (m._30 * m._01 - m._00 * m._31));
+    res._32 = d * (m._30 * (m._11 * m._02 - m._01 * m._12) + m._00 * (m._31 * m._12 - m._11 * m._32) + m._10 * (m._01 * m._32 - m._31 * m._02));
+    res._03 = d * (m._01 * (m._22 * m._13 - m._12 * m._23) + m._11 * (m._02 * m._23 - m._22 * m._03) + m._21 * (m._12 * m._03 - m._02 * m._13));
+    res._13 = d * (m._02 * (m._20 * m._13 - m._10 * m._23) + m._12 * (m._00 * m._23 - m._20 * m._03) + m._22 * (m._10 * m._03 - m._00 * m._13));
+    res._23 = d * (m._03 * (m._20 * m._11 - m._10 * m._21) + m._13 * (m._00 * m._21 - m._20 * m._01) + m._23 * (m._10 * m._01 - m._00 * m._11));
+    res._33 = d * (m._00 * (m._11 * m._22 - m._21 * m._12) + m._10 * (m._21 * m._02 - m._01 * m._22) + m._20 * (m._01 * m._12 - m._11 * m._02));
+    return true;
+}
+}
+
+struct MathInputs
+{
+    std::vector<Matrix4> Matrices;
+    std::vector<Matrix4> OtherMatrices;
+    std::vector<Vector4> Vectors;
+    std::vector<Quaternion> Rotations;
+};
+
+Matrix4 MakeTransform(std::mt19937& random)
+{
+    std::uniform_real_distribution<float32> angle(-Math::PI, Math::PI);
+    std::uniform_real_distribution<float32> position(-100.0f, 100.0f);
+    Matrix4 res = Quaternion::FromEuler(angle(random), angle(random), angle(random)).ToMatrix();
+    res._30 = position(random);
+    res._31 = position(random);
+    res._32 = position(random);
+    return res;
+}
+
+MathInputs MakeInputs()
+{
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float32> value(-10.0f, 10.0f);
+    std::uniform_real_distribution<float32> angle(-Math::PI, Math::PI);
+    MathInputs inputs;
+    for (uint32 i = 0; i < ElementsCount; ++i)
+    {
+        inputs.Matrices.push_back(MakeTransform(random));
+        inputs.OtherMatrices.push_back(MakeTransform(random));
+        inputs.Vectors.push_back({ value(random), value(random), value(random), 1.0f });
+        inputs.Rotations.push_back(Quaternion::FromEuler(angle(random), angle(random), angle(random)));
+    }
+    return inputs;
+}
+}
+
+void RunMathBenchmarks()
+{
+    const MathInputs inputs = MakeInputs();
+    std::vector<Matrix4> matrices(ElementsCount);
+    std::vector<Vector4> vectors(ElementsCount);
+
+    Measure("Matrix4 multiply, scalar", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            Scalar::Multiply(inputs.Matrices[i], inputs.OtherMatrices[i], matrices[i]);
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+    Measure("Matrix4 multiply", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            matrices[i] = inputs.Matrices[i] * inputs.OtherMatrices[i];
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+
+    Measure("Vector4 * Matrix4, scalar", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            vectors[i] = Scalar::Transform(inputs.Vectors[i], inputs.Matrices[i]);
+    });
+    KeepAlive(vectors[ElementsCount / 2]);
+    Measure("Vector4 * Matrix4", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            vectors[i] = inputs.Vectors[i] * inputs.Matrices[i];
+    });
+    KeepAlive(vectors[ElementsCount / 2]);
+
+    Measure("Matrix4 inverse, scalar", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            Scalar::Inversed(inputs.Matrices[i], matrices[i]);
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+    Measure("Matrix4 inverse", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            inputs.Matrices[i].Inversed(matrices[i]);
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+    Measure("Matrix4 orthonormal inverse", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            matrices[i] = inputs.Matrices[i].InversedOrthonorm();
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+
+    Measure("Matrix4 transpose, scalar", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            matrices[i] = Scalar::Transposed(inputs.Matrices[i]);
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+    Measure("Matrix4 transpose", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            matrices[i] = inputs.Matrices[i].Tranposed();
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+
+    Measure("Quaternion to Matrix4", ElementsCount, IterationsCount, [&]()
+    {
+        for (uint32 i = 0; i < ElementsCount; ++i)
+            matrices[i] = inputs.Rotations[i].ToMatrix();
+    });
+    KeepAlive(matrices[ElementsCount / 2]);
+}
+}
\ No newline at end of file
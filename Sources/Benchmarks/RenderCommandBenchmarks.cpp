@@ -0,0 +1,135 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include "Core/Memory/FrameAllocator.h"
+#include "Render/RenderCommand.h"
+#include "Render/RenderPacket.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+using namespace Renderer;
+
+constexpr uint32 PacketsCount = 100000;
+constexpr uint32 ConstantBuffersCount = 2; // Per object and per material buffers, as packets of forward pass have.
+constexpr uint32 UniformConstantsCount = 2;
+constexpr uint32 IterationsCount = 50;
+constexpr size_t FrameSize = 32 * 1024 * 1024; // Fits the list with all its regrowths and the sorted copy, so nothing goes to heap.
+
+std::vector<RenderPacket> MakePackets()
+{
+    std::mt19937 random(17);
+    std::uniform_int_distribution<uint32> handle(0, 4095);
+    std::vector<RenderPacket> packets(PacketsCount);
+    for (auto& packet : packets)
+    {
+        packet.Material = handle(random);
+        packet.Pass = 1;
+        packet.Shader = handle(random) % 64;
+        packet.VertexLayout = handle(random) % 8;
+        packet.TextureSet = handle(random);
+        packet.Mesh = handle(random);
+        packet.SortKey = SortKey::Build(eRenderLayerType::Opaque, packet.Pass, packet.Shader, packet.Material, packet.TextureSet, packet.Mesh,
+            static_cast<float32>(handle(random)) / 4095.0f);
+    }
+    return packets;
+}
+
+void Record(const std::vector<RenderPacket>& packets, CommandList& list, StringId passName)
+{
+    constexpr uint32 extraSize = ConstantBuffersCount * sizeof(ConstantBufferHandle) + UniformConstantsCount * sizeof(uint32);
+    uint32 index = 0;
+    for (const auto& packet : packets)
+    {
+        SubmitRenderPacketCommand& command = list.PushCommand<SubmitRenderPacketCommand>(passName, extraSize);
+        command.Material = packet.Material;
+        command.Pass = packet.Pass;
+        command.Shader = packet.Shader;
+        command.VertexLayout = packet.VertexLayout;
+        command.TextureSet = packet.TextureSet;
+        command.Mesh = packet.Mesh;
+        command.SortKey = packet.SortKey;
+        command.InstanceCount = packet.InstanceCount;
+        command.ConstantBuffersCount = ConstantBuffersCount;
+        command.UniformConstantsCount = UniformConstantsCount;
+        ConstantBufferHandle* buffers = command.GetConstantBufferHandles();
+        buffers[0] = index;
+        buffers[1] = packet.Material.GetHandle();
+        uint32* constants = command.GetUniformConstants();
+        constants[0] = index++;
+        constants[1] = packet.Mesh.GetHandle();
+    }
+}
+
+///
+/// Reads every command the way the backend does, binds are replaced with summing handles.
+///
+uint64 Replay(const CommandList& list)
+{
+    uint64 res = 0;
+    for (const RenderCommandHeader& header : list)
+    {
+        switch (header.CommandType)
+        {
+        case eRenderCommandType::eSubmitRenderPacket:
+        {
+            const SubmitRenderPacketCommand& command = header.GetCommand<SubmitRenderPacketCommand>();
+            res += command.Shader.GetHandle() + command.Material.GetHandle() + command.TextureSet.GetHandle() + command.Mesh.GetHandle();
+            const ConstantBufferHandle* buffers = command.GetConstantBufferHandles();
+            for (uint32 i = 0; i < command.ConstantBuffersCount; ++i)
+                res += buffers[i].GetHandle();
+            const uint32* constants = command.GetUniformConstants();
+            for (uint32 i = 0; i < command.UniformConstantsCount; ++i)
+                res += constants[i];
+            break;
+        }
+        default:
+            ++res;
+            break;
+        }
+    }
+    return res;
+}
+}
+
+void RunRenderCommandBenchmarks()
+{
+    FrameAllocator::Init(FrameSize);
+    {
+        const std::vector<RenderPacket> packets = MakePackets();
+        const StringId passName = StringTable::Intern("BenchmarkPass");
+
+        Measure("Record 100k render packets", PacketsCount, IterationsCount, [&]()
+        {
+            FrameAllocator::BeginFrame();
+            CommandList list;
+            Record(packets, list, passName);
+            KeepAlive(list.GetDataSize());
+        });
+
+        FrameAllocator::BeginFrame();
+        CommandList recorded;
+        Record(packets, recorded, passName);
+        Measure("Replay 100k render packets", PacketsCount, IterationsCount, [&]()
+        {
+            KeepAlive(Replay(recorded));
+        });
+
+        Measure("Record and sort 100k render packets", PacketsCount, IterationsCount, [&]()
+        {
+            FrameAllocator::BeginFrame();
+            CommandList list;
+            Record(packets, list, passName);
+            CommandList sorted(list.GetDataSize());
+            sorted.AppendSorted(list);
+            KeepAlive(sorted.GetDataSize());
+        });
+    }
+    FrameAllocator::Shutdown();
+}
+}
\ No newline at end of file
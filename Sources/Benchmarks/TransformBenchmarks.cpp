@@ -0,0 +1,96 @@
+#include "stdafx.h"
+
+#include "Benchmarks/Benchmarks.h"
+
+#include <iterator>
+#include <vector>
+
+#include "Component/TransformComponent.h"
+#include "Core/ECS/Entity.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Scene.h"
+#include "Systems/TransformSystem.h"
+
+namespace Kioto::Benchmarks
+{
+namespace
+{
+constexpr uint32 RootsCount = 100;
+constexpr uint32 ChildrenCounts[] = { 9, 10, 10 }; // Per depth, 1000 transforms under every root.
+constexpr uint32 IterationsCount = 20;
+
+struct Hierarchy
+{
+    std::vector<TransformComponent*> Roots;
+    std::vector<TransformComponent*> Leaves;
+    uint32 TransformsCount = 0;
+};
+
+TransformComponent* AddTransform(Scene& scene, TransformComponent* parent, Hierarchy& hierarchy)
+{
+    Entity* entity = new Entity();
+    TransformComponent* transform = new TransformComponent();
+    entity->AddComponent(transform);
+    transform->SetParent(parent);
+    transform->SetLocalPosition({ 1.0f, 0.5f, 0.25f });
+    transform->SetLocalScale({ 1.0f, 1.0f, 1.0f });
+    scene.AddEntity(entity);
+    ++hierarchy.TransformsCount;
+    return transform;
+}
+
+void AddChildren(Scene& scene, TransformComponent* parent, uint32 depth, Hierarchy& hierarchy)
+{
+    if (depth == std::size(ChildrenCounts))
+    {
+        hierarchy.Leaves.push_back(parent);
+        return;
+    }
+    for (uint32 i = 0; i < ChildrenCounts[depth]; ++i)
+        AddChildren(scene, AddTransform(scene, parent, hierarchy), depth + 1, hierarchy);
+}
+}
+
+void RunTransformBenchmarks()
+{
+    JobSystem::Init();
+    {
+        Scene scene("TransformBenchmarks");
+        TransformSystem* system = new TransformSystem();
+        scene.AddSystem(system); // Only transforms are composed, scene is not initialized with render systems.
+
+        Hierarchy hierarchy;
+        for (uint32 i = 0; i < RootsCount; ++i)
+        {
+            hierarchy.Roots.push_back(AddTransform(scene, nullptr, hierarchy));
+            AddChildren(scene, hierarchy.Roots.back(), 0, hierarchy);
+        }
+        system->Update(0.0f);
+
+        float32 offset = 0.0f;
+        Measure("Compose 100k transform hierarchy, all roots moved", hierarchy.TransformsCount, IterationsCount, [&]()
+        {
+            offset += 1.0f;
+            for (auto root : hierarchy.Roots)
+                root->SetLocalPosition({ offset, 0.0f, 0.0f });
+            system->Update(0.0f);
+        });
+
+        const uint32 movedLeavesCount = hierarchy.TransformsCount / 100;
+        Measure("Compose 100k transform hierarchy, 1% leaves moved", movedLeavesCount, IterationsCount, [&]()
+        {
+            offset += 1.0f;
+            for (uint32 i = 0; i < movedLeavesCount; ++i)
+                hierarchy.Leaves[i * (static_cast<uint32>(hierarchy.Leaves.size()) / movedLeavesCount)]->SetLocalPosition({ offset, 0.0f, 0.0f });
+            system->Update(0.0f);
+        });
+
+        Measure("Update 100k transform hierarchy, nothing moved", hierarchy.TransformsCount, IterationsCount, [&]()
+        {
+            system->Update(0.0f);
+        });
+        KeepAlive(hierarchy.Leaves.back()->GetToWorld());
+    }
+    JobSystem::Shutdown();
+}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "stdafx.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Core/KiotoEngine.h"
+
+namespace
+{
+constexpr Kioto::uint32 DefaultFramesCount = 1000;
+}
+
+///
+/// Run a saved scene on the null render backend and print frame timings and render stats.
+/// Usage: KiotoHeadless <scene path> [frames count]. Returns 1 if the backend reported validation errors.
+///
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Usage: KiotoHeadless <scene path> [frames count]\n");
+        return 2;
+    }
+
+    Kioto::uint32 framesCount = argc > 2 ? static_cast<Kioto::uint32>(std::strtoul(argv[2], nullptr, 10)) : DefaultFramesCount;
+    Kioto::HeadlessRunResult result = Kioto::KiotoHeadlessMain(argv[1], framesCount);
+    return result.ValidationErrors > 0 ? 1 : 0;
+}
\ No newline at end of file
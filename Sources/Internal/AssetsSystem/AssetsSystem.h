@@ -71,11 +71,11 @@ void UnloadAsset(T* asset)
     auto it = std::find(m_dynamicAssets.begin(), m_dynamicAssets.end(), asset);
     if (it != m_dynamicAssets.end())
     {
-        delete &(*it);
+        delete *it;
         m_dynamicAssets.erase(it);
         return;
     }
-    auto mapIt = std::find_if(m_assets.begin(), m_assets.end(), [&asset](const auto& pair) { return pair.second() == asset; });
+    auto mapIt = std::find_if(m_assets.begin(), m_assets.end(), [&asset](const auto& pair) { return pair.second == asset; });
     if (mapIt != m_assets.end())
     {
         SafeDelete(mapIt->second);
@@ -56,6 +56,7 @@ private:
     TransformComponent* m_transform = nullptr;
     bool m_hdr = true;
     bool m_isMainRT = false;
+    uint32 m_transformVersion = 0; // Version of the transform camera matrices were built from.
 
     Renderer::Camera m_camera{ true };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include "Core/CoreTypes.h"
 #include "Core/CoreHelpers.h"
 #include "Core/ECS/Component.h"
@@ -33,6 +35,9 @@ public:
     void SetRenderObject(Renderer::RenderObject* renderObject);
     Renderer::RenderObject* GetRenderObject() const;
 
+    void SetSpatialProxy(uint32 proxy);
+    uint32 GetSpatialProxy() const;
+
     void Serialize(YAML::Emitter& out) const override;
     void Deserialize(const YAML::Node& in) override;
 
@@ -41,6 +46,7 @@ private:
     std::string m_meshPath = "";
 
     Renderer::RenderObject* m_renderObject = nullptr;
+    uint32 m_spatialProxy = (std::numeric_limits<uint32>::max)(); // Leaf in the bounding volume hierarchy of RenderSystem.
 };
 REGISTER_COMPONENT(RenderComponent);
 
@@ -74,4 +80,14 @@ inline Renderer::RenderObject* RenderComponent::GetRenderObject() const
     return m_renderObject;
 }
 
+inline void RenderComponent::SetSpatialProxy(uint32 proxy)
+{
+    m_spatialProxy = proxy;
+}
+
+inline uint32 RenderComponent::GetSpatialProxy() const
+{
+    return m_spatialProxy;
+}
+
 }
\ No newline at end of file
@@ -3,20 +3,65 @@
 #include "Component/TransformComponent.h"
 
 #include "Core/Yaml/YamlParser.h"
+#include "Systems/TransformSystem.h"
 
 namespace Kioto
 {
+TransformComponent::~TransformComponent()
+{
+    SetParent(nullptr);
+    while (!m_children.empty())
+        m_children.back()->SetParent(nullptr);
+}
+
+void TransformComponent::SetParent(TransformComponent* parent)
+{
+    if (parent == m_parent)
+        return;
+#ifdef _DEBUG
+    for (auto p = parent; p != nullptr; p = p->m_parent)
+        assert(p != this && "Transform hierarchy cycle");
+#endif
+
+    if (m_parent != nullptr)
+    {
+        auto& siblings = m_parent->m_children;
+        auto it = std::find(siblings.begin(), siblings.end(), this);
+        *it = siblings.back();
+        siblings.pop_back();
+    }
+    m_parent = parent;
+    if (m_parent != nullptr)
+        m_parent->m_children.push_back(this);
+
+    if (m_system != nullptr)
+        m_system->OnParentChanged(this);
+    SetDirty();
+}
+
+void TransformComponent::SetDirty()
+{
+    if (m_isDirty.exchange(true))
+        return;
+    if (m_system != nullptr)
+        m_system->MarkDirty(this);
+}
+
 Component* TransformComponent::Clone() const
 {
     TransformComponent* t = new TransformComponent();
     t->m_toWorld = m_toWorld;
     t->m_toParent = m_toParent;
     t->m_toModel = m_toModel;
+    t->m_isWorldScaleUniform = m_isWorldScaleUniform;
+    t->m_worldUniformScale = m_worldUniformScale;
 
-    t->m_children = m_children;
-    t->m_parent = m_parent;
+    t->m_localPosition = m_localPosition;
+    t->m_localRotation = m_localRotation;
+    t->m_localScale = m_localScale;
     t->m_worldPosition = m_worldPosition;
     t->m_worldRotation = m_worldRotation;
+    t->SetParent(m_parent);
 
     return t;
 }
@@ -26,6 +71,7 @@ void TransformComponent::Serialize(YAML::Emitter& out) const
     using ::operator<<;
     out << YAML::Key << "WorldPosition" << YAML::Value << m_worldPosition;
     out << YAML::Key << "WorldRotation" << YAML::Value << m_worldRotation;
+    out << YAML::Key << "LocalScale" << YAML::Value << m_localScale;
 }
 
 void TransformComponent::Deserialize(const YAML::Node& in)
@@ -34,6 +80,10 @@ void TransformComponent::Deserialize(const YAML::Node& in)
         m_worldPosition = in["WorldPosition"].as<Vector3>();
     if (in["WorldRotation"])
         m_worldRotation = in["WorldRotation"].as<Quaternion>();
-    m_isDirty = true;
+    if (in["LocalScale"])
+        m_localScale = in["LocalScale"].as<Vector3>();
+    m_localPosition = m_worldPosition;
+    m_localRotation = m_worldRotation;
+    SetDirty();
 }
 }
\ No newline at end of file
@@ -1,39 +1,70 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "Core/CoreTypes.h"
 #include "Core/ECS/Component.h"
+#include "Math/MathBatch.h"
 #include "Math/Matrix4.h"
 #include "Math/Vector3.h"
 #include "Math/Quaternion.h"
 
 namespace Kioto
 {
+class TransformSystem;
+
+///
+/// Transform stores local position, rotation and scale relative to the parent. World matrices are composed by TransformSystem.
+///
 class TransformComponent : public Component
 {
     DECLARE_COMPONENT(TransformComponent);
 
 public:
     KIOTO_API TransformComponent() = default;
-    KIOTO_API ~TransformComponent() = default;
+    KIOTO_API ~TransformComponent();
 
     bool GetDirty() const;
+    ///
+    /// Version of world matrices, incremented every time they are composed or set.
+    ///
+    uint32 GetVersion() const;
     const Matrix4& GetToWorld() const;
     const Matrix4& GetToParent() const;
     const Matrix4& GetToModel() const;
     const Vector3& GetWorldPosition() const;
     const Quaternion& GetWorldRotation() const;
+    const Vector3& GetLocalPosition() const;
+    const Quaternion& GetLocalRotation() const;
+    const Vector3& GetLocalScale() const;
+    TransformComponent* GetParent() const;
+    const std::vector<TransformComponent*>& GetChildren() const;
 
     Vector3 TransformPointToWorld(const Vector3& localPoint) const;
     Vector3 TransformPointToModel(const Vector3& worldPoint) const;
+    ///
+    /// Batch versions of TransformPointToWorld/TransformPointToModel. in and out may be the same array.
+    ///
+    void TransformPointsToWorld(const Vector3* localPoints, Vector3* worldPoints, uint32 count) const;
+    void TransformPointsToModel(const Vector3* worldPoints, Vector3* localPoints, uint32 count) const;
 
     void SetToWorld(const Matrix4& m);
-    void SetToParent(const Matrix4& m);
-    void SetToModel(const Matrix4& m);
-    void SetParent(TransformComponent* parent);
+    ///
+    /// Attach transform to parent (nullptr to detach). Local position, rotation and scale are kept.
+    ///
+    KIOTO_API void SetParent(TransformComponent* parent);
+    ///
+    /// Set world position. Converted to local position using last composed parent matrices.
+    ///
     void SetWorldPosition(const Vector3& pos);
+    ///
+    /// Set world rotation. Converted to local rotation using last composed parent rotation.
+    ///
     void SetWorldRotation(const Quaternion& rot);
+    void SetLocalPosition(const Vector3& pos);
+    void SetLocalRotation(const Quaternion& rot);
+    void SetLocalScale(const Vector3& scale);
 
     Vector3 Up() const;
     Vector3 Right() const;
@@ -45,21 +76,36 @@ public:
     void Deserialize(const YAML::Node& in) override;
 
 private:
-    void SetDirty();
+    ///
+    /// Mark transform dirty and register it in the dirty list of the system.
+    ///
+    KIOTO_API void SetDirty();
     void RemoveDirty();
     void SetChildrenDirty();
 
     Matrix4 m_toWorld = Matrix4::Identity;
     Matrix4 m_toParent = Matrix4::Identity;
     Matrix4 m_toModel = Matrix4::Identity;
-    bool m_isDirty = false;
-
+    std::atomic<bool> m_isDirty{ false }; // Set from any thread, m_dirtyIndex is guarded by the dirty mutex of the system.
+    uint32 m_version = 1;
+    bool m_isWorldScaleUniform = true;
+    float32 m_worldUniformScale = 1.0f;
+
+    Vector3 m_localPosition{};
+    Quaternion m_localRotation{};
+    Vector3 m_localScale{ 1.0f, 1.0f, 1.0f };
     Vector3 m_worldPosition{};
     Quaternion m_worldRotation{}; // [a_vorontcov] TODO: quaternion.
 
     TransformComponent* m_parent = nullptr;
     std::vector<TransformComponent*> m_children;
 
+    TransformSystem* m_system = nullptr; // System which composes this transform, nullptr if entity is not in scene.
+    uint32 m_depth = 0; // Count of ancestors.
+    uint32 m_levelIndex = 0; // Index in the depth level of the system.
+    uint32 m_dirtyIndex = 0; // Index in the dirty list of the depth level, valid while transform is dirty.
+    uint32 m_movedIndex = 0; // Index in the moved list of the system, valid while transform is there.
+
     friend class TransformSystem;
 };
 REGISTER_COMPONENT(TransformComponent);
@@ -69,6 +115,11 @@ inline bool TransformComponent::GetDirty() const
     return m_isDirty;
 }
 
+inline uint32 TransformComponent::GetVersion() const
+{
+    return m_version;
+}
+
 inline const Matrix4& TransformComponent::GetToWorld() const
 {
     return m_toWorld;
@@ -94,57 +145,74 @@ inline const Quaternion& TransformComponent::GetWorldRotation() const
     return m_worldRotation;
 }
 
-inline void TransformComponent::SetToWorld(const Matrix4& m)
+inline const Vector3& TransformComponent::GetLocalPosition() const
 {
-    m_toWorld = m;
-    if (!m_isDirty)
-        SetChildrenDirty();
+    return m_localPosition;
 }
 
-inline void TransformComponent::SetToParent(const Matrix4& m)
+inline const Quaternion& TransformComponent::GetLocalRotation() const
 {
-    m_toParent = m;
-    if (!m_isDirty)
-        SetChildrenDirty();
-    m_isDirty = true;
+    return m_localRotation;
 }
 
-inline void TransformComponent::SetToModel(const Matrix4& m)
+inline const Vector3& TransformComponent::GetLocalScale() const
 {
-    m_toModel = m;
-    if (!m_isDirty)
-        SetChildrenDirty();
-    m_isDirty = true;
+    return m_localScale;
+}
+
+inline TransformComponent* TransformComponent::GetParent() const
+{
+    return m_parent;
 }
 
-inline void TransformComponent::SetParent(TransformComponent* parent)
+inline const std::vector<TransformComponent*>& TransformComponent::GetChildren() const
 {
-    m_parent = parent;
+    return m_children;
+}
+
+inline void TransformComponent::SetToWorld(const Matrix4& m)
+{
+    m_toWorld = m;
+    ++m_version;
     if (!m_isDirty)
         SetChildrenDirty();
-    m_isDirty = true;
 }
 
 inline void TransformComponent::SetWorldPosition(const Vector3& pos)
 {
     m_worldPosition = pos;
-    m_isDirty = true;
+    m_localPosition = m_parent != nullptr ? m_parent->TransformPointToModel(pos) : pos;
+    SetDirty();
 }
 
 inline void TransformComponent::SetWorldRotation(const Quaternion& rot)
 {
     m_worldRotation = rot;
-    m_isDirty = true;
+    m_localRotation = m_parent != nullptr ? m_parent->m_worldRotation.Inverse() * rot : rot;
+    SetDirty();
 }
 
-inline void TransformComponent::SetDirty()
+inline void TransformComponent::SetLocalPosition(const Vector3& pos)
 {
-    m_isDirty = true;
+    m_localPosition = pos;
+    SetDirty();
+}
+
+inline void TransformComponent::SetLocalRotation(const Quaternion& rot)
+{
+    m_localRotation = rot;
+    SetDirty();
+}
+
+inline void TransformComponent::SetLocalScale(const Vector3& scale)
+{
+    m_localScale = scale;
+    SetDirty();
 }
 
 inline void TransformComponent::RemoveDirty()
 {
-    m_isDirty = false;
+    m_isDirty.store(false);
 }
 
 inline void TransformComponent::SetChildrenDirty()
@@ -165,6 +233,16 @@ inline Vector3 TransformComponent::TransformPointToModel(const Vector3& worldPoi
     return { localPoint.x, localPoint.y, localPoint.z };
 }
 
+inline void TransformComponent::TransformPointsToWorld(const Vector3* localPoints, Vector3* worldPoints, uint32 count) const
+{
+    Math::Batch::TransformPoints(m_toWorld, localPoints, worldPoints, count);
+}
+
+inline void TransformComponent::TransformPointsToModel(const Vector3* worldPoints, Vector3* localPoints, uint32 count) const
+{
+    Math::Batch::TransformPoints(m_toModel, worldPoints, localPoints, count);
+}
+
 inline Vector3 TransformComponent::Up() const
 {
     return { m_toWorld._10, m_toWorld._11, m_toWorld._12 };
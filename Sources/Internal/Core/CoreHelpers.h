@@ -4,6 +4,7 @@
 #include <functional>
 #include <locale>
 #include <codecvt>
+#include <intrin.h>
 
 namespace Kioto
 {
@@ -40,11 +41,51 @@ inline uint64 PtrToUint(T* ptr)
     return static_cast<uint64>(reinterpret_cast<uintptr_t>(ptr));
 }
 
+///
+/// Get index of the lowest set bit. mask must not be zero.
+///
+inline uint32 FirstSetBit(uint64 mask)
+{
+    unsigned long index = 0;
+    _BitScanForward64(&index, mask);
+    return static_cast<uint32>(index);
+}
+
+///
+/// Get number of set bits.
+///
+inline uint32 BitCount(uint64 mask)
+{
+    return static_cast<uint32>(__popcnt64(mask));
+}
+
+///
+/// Compile time FNV-1a string hash. Unlike StringToHash result is stable between runs and platforms.
+///
+constexpr uint64 ConstStringToHash(const char* str)
+{
+    uint64 hash = 14695981039346656037ull;
+    for (; *str != '\0'; ++str)
+    {
+        hash ^= static_cast<uint64>(static_cast<unsigned char>(*str));
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 inline uint64 StringToHash(const std::string& str)
 {
     return StringHasher(str);
 }
 
+///
+/// Mix value hash into seed. Result depends on the order of combined values.
+///
+inline uint64 HashCombine(uint64 seed, uint64 value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
 // [a_vorontcov] See https://stackoverflow.com/questions/18039723/c-trying-to-get-function-address-from-a-stdfunction for details.
 template<typename T, typename... U>
 uint64 GetFunctionAddress(std::function<T(U...)> f) 
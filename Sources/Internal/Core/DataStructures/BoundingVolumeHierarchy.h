@@ -0,0 +1,474 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Frustum.h"
+
+namespace Kioto
+{
+///
+/// Dynamic bounding volume hierarchy of axis aligned boxes. Leaves are inserted one by one, going down the side that
+/// enlarges surface area less, and the tree is kept balanced by rotations. Leaves store fat boxes enlarged by FatMargin,
+/// so objects moving inside their fat box don't touch the tree. Queries report payloads of leaves whose fat boxes pass
+/// the test, so they are conservative.
+///
+template <typename T>
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr uint32 InvalidProxy = (std::numeric_limits<uint32>::max)();
+    static constexpr float32 FatMargin = 0.1f; // Part of the box size added on every side.
+
+    ///
+    /// Add box to the tree. Returns proxy identifying the leaf until it is removed.
+    ///
+    uint32 Insert(const BoundingBox& box, const T& payload);
+    void Remove(uint32 proxy);
+    ///
+    /// Update box of the leaf. Leaf is reinserted only if the box leaves its fat box. Returns true if tree has changed.
+    ///
+    bool Move(uint32 proxy, const BoundingBox& box);
+    void Clear();
+
+    const T& GetPayload(uint32 proxy) const;
+    const BoundingBox& GetFatBox(uint32 proxy) const;
+    uint32 GetProxiesCount() const;
+    uint32 GetHeight() const;
+
+    ///
+    /// Call f(const T& payload) for leaves intersecting frustum. Subtrees completely inside are reported without tests.
+    ///
+    template <typename F>
+    void QueryFrustum(const Frustum& frustum, F&& f) const;
+
+    ///
+    /// Call f(const T& payload) for leaves intersecting sphere.
+    ///
+    template <typename F>
+    void QuerySphere(const Vector3& center, float32 radius, F&& f) const;
+
+    ///
+    /// Call f(const T& payload) for leaves intersecting box.
+    ///
+    template <typename F>
+    void QueryBox(const BoundingBox& box, F&& f) const;
+
+    ///
+    /// Call f(const T& payload, float32 distance) for leaves hit by ray origin + t * direction, 0 <= t <= maxDistance,
+    /// distance is the distance to the leaf box entry in direction units. f returns new max distance, return the hit
+    /// distance to get the closest hit or maxDistance to get all hits.
+    ///
+    template <typename F>
+    void RayCast(const Vector3& origin, const Vector3& direction, float32 maxDistance, F&& f) const;
+
+private:
+    static constexpr uint32 MaxTraversalDepth = 128; // Tree is balanced, 128 levels are far beyond any practical count of leaves.
+
+    struct Node
+    {
+        BoundingBox Box;
+        T Payload = {};
+        uint32 Parent = InvalidProxy; // Next free node for the nodes in the free list.
+        uint32 Child1 = InvalidProxy;
+        uint32 Child2 = InvalidProxy;
+        int32 Height = -1; // 0 for leaves, -1 for free nodes.
+
+        bool IsLeaf() const
+        {
+            return Child1 == InvalidProxy;
+        }
+    };
+
+    uint32 AllocateNode();
+    void FreeNode(uint32 index);
+    void InsertLeaf(uint32 leaf);
+    void RemoveLeaf(uint32 leaf);
+    ///
+    /// Rotate the subtree if its children heights differ by more than one. Returns new root of the subtree.
+    ///
+    uint32 Balance(uint32 index);
+    void UpdateFromChildren(uint32 index);
+    void ReplaceChild(uint32 parent, uint32 oldChild, uint32 newChild);
+    static BoundingBox Fatten(const BoundingBox& box);
+
+    std::vector<Node> m_nodes;
+    uint32 m_root = InvalidProxy;
+    uint32 m_freeList = InvalidProxy;
+    uint32 m_proxiesCount = 0;
+};
+
+template <typename T>
+uint32 BoundingVolumeHierarchy<T>::Insert(const BoundingBox& box, const T& payload)
+{
+    uint32 leaf = AllocateNode();
+    m_nodes[leaf].Box = Fatten(box);
+    m_nodes[leaf].Payload = payload;
+    m_nodes[leaf].Height = 0;
+    InsertLeaf(leaf);
+    ++m_proxiesCount;
+    return leaf;
+}
+
+template <typename T>
+void BoundingVolumeHierarchy<T>::Remove(uint32 proxy)
+{
+    assert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].Height == 0);
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --m_proxiesCount;
+}
+
+template <typename T>
+bool BoundingVolumeHierarchy<T>::Move(uint32 proxy, const BoundingBox& box)
+{
+    assert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf() && m_nodes[proxy].Height == 0);
+    if (m_nodes[proxy].Box.Contains(box))
+        return false;
+
+    RemoveLeaf(proxy);
+    m_nodes[proxy].Box = Fatten(box);
+    InsertLeaf(proxy);
+    return true;
+}
+
+template <typename T>
+void BoundingVolumeHierarchy<T>::Clear()
+{
+    m_nodes.clear();
+    m_root = InvalidProxy;
+    m_freeList = InvalidProxy;
+    m_proxiesCount = 0;
+}
+
+template <typename T>
+inline const T& BoundingVolumeHierarchy<T>::GetPayload(uint32 proxy) const
+{
+    return m_nodes[proxy].Payload;
+}
+
+template <typename T>
+inline const BoundingBox& BoundingVolumeHierarchy<T>::GetFatBox(uint32 proxy) const
+{
+    return m_nodes[proxy].Box;
+}
+
+template <typename T>
+inline uint32 BoundingVolumeHierarchy<T>::GetProxiesCount() const
+{
+    return m_proxiesCount;
+}
+
+template <typename T>
+inline uint32 BoundingVolumeHierarchy<T>::GetHeight() const
+{
+    return m_root == InvalidProxy ? 0 : static_cast<uint32>(m_nodes[m_root].Height);
+}
+
+template <typename T>
+template <typename F>
+void BoundingVolumeHierarchy<T>::QueryFrustum(const Frustum& frustum, F&& f) const
+{
+    struct StackItem
+    {
+        uint32 Index;
+        bool IsInside; // Parent is completely inside the frustum.
+    };
+
+    if (m_root == InvalidProxy)
+        return;
+
+    std::array<StackItem, MaxTraversalDepth> stack;
+    uint32 stackSize = 0;
+    stack[stackSize++] = { m_root, false };
+    while (stackSize > 0)
+    {
+        StackItem item = stack[--stackSize];
+        const Node& node = m_nodes[item.Index];
+        if (!item.IsInside)
+        {
+            if (!frustum.Intersects(node.Box))
+                continue;
+            item.IsInside = frustum.Contains(node.Box);
+        }
+
+        if (node.IsLeaf())
+        {
+            f(node.Payload);
+            continue;
+        }
+        assert(stackSize + 2 <= MaxTraversalDepth);
+        stack[stackSize++] = { node.Child1, item.IsInside };
+        stack[stackSize++] = { node.Child2, item.IsInside };
+    }
+}
+
+template <typename T>
+template <typename F>
+void BoundingVolumeHierarchy<T>::QuerySphere(const Vector3& center, float32 radius, F&& f) const
+{
+    if (m_root == InvalidProxy)
+        return;
+
+    std::array<uint32, MaxTraversalDepth> stack;
+    uint32 stackSize = 0;
+    stack[stackSize++] = m_root;
+    while (stackSize > 0)
+    {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!node.Box.Intersects(center, radius))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            f(node.Payload);
+            continue;
+        }
+        assert(stackSize + 2 <= MaxTraversalDepth);
+        stack[stackSize++] = node.Child1;
+        stack[stackSize++] = node.Child2;
+    }
+}
+
+template <typename T>
+template <typename F>
+void BoundingVolumeHierarchy<T>::QueryBox(const BoundingBox& box, F&& f) const
+{
+    if (m_root == InvalidProxy)
+        return;
+
+    std::array<uint32, MaxTraversalDepth> stack;
+    uint32 stackSize = 0;
+    stack[stackSize++] = m_root;
+    while (stackSize > 0)
+    {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!node.Box.Intersects(box))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            f(node.Payload);
+            continue;
+        }
+        assert(stackSize + 2 <= MaxTraversalDepth);
+        stack[stackSize++] = node.Child1;
+        stack[stackSize++] = node.Child2;
+    }
+}
+
+template <typename T>
+template <typename F>
+void BoundingVolumeHierarchy<T>::RayCast(const Vector3& origin, const Vector3& direction, float32 maxDistance, F&& f) const
+{
+    if (m_root == InvalidProxy)
+        return;
+
+    Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    std::array<uint32, MaxTraversalDepth> stack;
+    uint32 stackSize = 0;
+    stack[stackSize++] = m_root;
+    while (stackSize > 0)
+    {
+        const Node& node = m_nodes[stack[--stackSize]];
+        float32 distance = 0.0f;
+        if (!node.Box.IntersectsRay(origin, invDirection, maxDistance, distance))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            maxDistance = f(node.Payload, distance);
+            continue;
+        }
+        assert(stackSize + 2 <= MaxTraversalDepth);
+        stack[stackSize++] = node.Child1;
+        stack[stackSize++] = node.Child2;
+    }
+}
+
+template <typename T>
+uint32 BoundingVolumeHierarchy<T>::AllocateNode()
+{
+    if (m_freeList == InvalidProxy)
+    {
+        m_nodes.emplace_back();
+        return static_cast<uint32>(m_nodes.size() - 1);
+    }
+
+    uint32 index = m_freeList;
+    m_freeList = m_nodes[index].Parent;
+    m_nodes[index] = Node();
+    return index;
+}
+
+template <typename T>
+void BoundingVolumeHierarchy<T>::FreeNode(uint32 index)
+{
+    m_nodes[index] = Node();
+    m_nodes[index].Parent = m_freeList;
+    m_freeList = index;
+}
+
+template <typename T>
+void BoundingVolumeHierarchy<T>::InsertLeaf(uint32 leaf)
+{
+    if (m_root == InvalidProxy)
+    {
+        m_root = leaf;
+        m_nodes[leaf].Parent = InvalidProxy;
+        return;
+    }
+
+    // Go down to the sibling which gives the smallest surface area of the new parent plus the growth of its ancestors.
+    BoundingBox leafBox = m_nodes[leaf].Box;
+    uint32 index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node& node = m_nodes[index];
+        float32 area = node.Box.GetSurfaceArea();
+        float32 combinedArea = BoundingBox::Union(node.Box, leafBox).GetSurfaceArea();
+        float32 cost = 2.0f * combinedArea; // New parent of this node and the leaf.
+        float32 inheritanceCost = 2.0f * (combinedArea - area); // Growth of this node if the leaf goes down.
+
+        auto getChildCost = [this, &leafBox, inheritanceCost](uint32 child)
+        {
+            const Node& childNode = m_nodes[child];
+            float32 childArea = BoundingBox::Union(childNode.Box, leafBox).GetSurfaceArea();
+            if (!childNode.IsLeaf())
+                childArea -= childNode.Box.GetSurfaceArea();
+            return childArea + inheritanceCost;
+        };
+        float32 cost1 = getChildCost(node.Child1);
+        float32 cost2 = getChildCost(node.Child2);
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? node.Child1 : node.Child2;
+    }
+
+    uint32 sibling = index;
+    uint32 oldParent = m_nodes[sibling].Parent;
+    uint32 newParent = AllocateNode();
+    m_nodes[newParent].Parent = oldParent;
+    m_nodes[newParent].Box = BoundingBox::Union(leafBox, m_nodes[sibling].Box);
+    m_nodes[newParent].Height = m_nodes[sibling].Height + 1;
+    m_nodes[newParent].Child1 = sibling;
+    m_nodes[newParent].Child2 = leaf;
+    m_nodes[sibling].Parent = newParent;
+    m_nodes[leaf].Parent = newParent;
+    if (oldParent != InvalidProxy)
+        ReplaceChild(oldParent, sibling, newParent);
+    else
+        m_root = newParent;
+
+    for (index = m_nodes[leaf].Parent; index != InvalidProxy; index = m_nodes[index].Parent)
+    {
+        index = Balance(index);
+        UpdateFromChildren(index);
+    }
+}
+
+template <typename T>
+void BoundingVolumeHierarchy<T>::RemoveLeaf(uint32 leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = InvalidProxy;
+        return;
+    }
+
+    uint32 parent = m_nodes[leaf].Parent;
+    uint32 grandParent = m_nodes[parent].Parent;
+    uint32 sibling = m_nodes[parent].Child1 == leaf ? m_nodes[parent].Child2 : m_nodes[parent].Child1;
+    FreeNode(parent);
+    m_nodes[leaf].Parent = InvalidProxy;
+    m_nodes[sibling].Parent = grandParent;
+    if (grandParent == InvalidProxy)
+    {
+        m_root = sibling;
+        return;
+    }
+
+    ReplaceChild(grandParent, parent, sibling);
+    for (uint32 index = grandParent; index != InvalidProxy; index = m_nodes[index].Parent)
+    {
+        index = Balance(index);
+        UpdateFromChildren(index);
+    }
+}
+
+template <typename T>
+uint32 BoundingVolumeHierarchy<T>::Balance(uint32 indexA)
+{
+    Node& a = m_nodes[indexA];
+    if (a.IsLeaf() || a.Height < 2)
+        return indexA;
+
+    uint32 indexB = a.Child1;
+    uint32 indexC = a.Child2;
+    int32 balance = m_nodes[indexC].Height - m_nodes[indexB].Height;
+    if (balance >= -1 && balance <= 1)
+        return indexA;
+
+    // Higher child takes place of A, A takes place of the higher child's lower child.
+    uint32 indexUp = balance > 1 ? indexC : indexB;
+    Node& up = m_nodes[indexUp];
+    uint32 indexF = up.Child1;
+    uint32 indexG = up.Child2;
+
+    up.Child1 = indexA;
+    up.Parent = a.Parent;
+    a.Parent = indexUp;
+    if (up.Parent != InvalidProxy)
+        ReplaceChild(up.Parent, indexA, indexUp);
+    else
+        m_root = indexUp;
+
+    if (m_nodes[indexF].Height > m_nodes[indexG].Height)
+        std::swap(indexF, indexG);
+    // G is the higher grandchild and stays under the risen node, F goes to A in place of the risen node.
+    up.Child2 = indexG;
+    if (balance > 1)
+        a.Child2 = indexF;
+    else
+        a.Child1 = indexF;
+    m_nodes[indexF].Parent = indexA;
+
+    UpdateFromChildren(indexA);
+    UpdateFromChildren(indexUp);
+    return indexUp;
+}
+
+template <typename T>
+inline void BoundingVolumeHierarchy<T>::UpdateFromChildren(uint32 index)
+{
+    Node& node = m_nodes[index];
+    const Node& child1 = m_nodes[node.Child1];
+    const Node& child2 = m_nodes[node.Child2];
+    node.Height = 1 + (std::max)(child1.Height, child2.Height);
+    node.Box = BoundingBox::Union(child1.Box, child2.Box);
+}
+
+template <typename T>
+inline void BoundingVolumeHierarchy<T>::ReplaceChild(uint32 parent, uint32 oldChild, uint32 newChild)
+{
+    if (m_nodes[parent].Child1 == oldChild)
+        m_nodes[parent].Child1 = newChild;
+    else
+        m_nodes[parent].Child2 = newChild;
+}
+
+template <typename T>
+inline BoundingBox BoundingVolumeHierarchy<T>::Fatten(const BoundingBox& box)
+{
+    Vector3 margin = (box.Max - box.Min) * FatMargin;
+    BoundingBox res;
+    res.Min = box.Min - margin;
+    res.Max = box.Max + margin;
+    return res;
+}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto
+{
+///
+/// Stable LSD radix sort by 64 bit key, one byte per pass. Passes where all keys have the same byte are skipped, so keys using
+/// only a part of the bits are sorted in fewer passes. temp must hold count items, sorted items are written back to items.
+/// getKey(const T&) -> uint64.
+///
+template <typename T, typename GetKey>
+void RadixSort(T* items, T* temp, uint32 count, GetKey&& getKey)
+{
+    constexpr uint32 DigitsCount = sizeof(uint64);
+    constexpr uint32 BucketsCount = 256;
+    if (count < 2)
+        return;
+
+    std::array<std::array<uint32, BucketsCount>, DigitsCount> histograms = {};
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint64 key = getKey(items[i]);
+        for (uint32 digit = 0; digit < DigitsCount; ++digit)
+            ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+    }
+
+    T* src = items;
+    T* dst = temp;
+    uint64 firstKey = getKey(items[0]);
+    for (uint32 digit = 0; digit < DigitsCount; ++digit)
+    {
+        std::array<uint32, BucketsCount>& histogram = histograms[digit];
+        if (histogram[(firstKey >> (digit * 8)) & 0xFF] == count)
+            continue;
+
+        uint32 offset = 0;
+        for (uint32& bucket : histogram)
+        {
+            uint32 bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+        for (uint32 i = 0; i < count; ++i)
+            dst[histogram[(getKey(src[i]) >> (digit * 8)) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != items)
+        std::copy(src, src + count, items);
+}
+}
\ No newline at end of file
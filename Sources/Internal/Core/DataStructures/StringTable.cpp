@@ -0,0 +1,51 @@
+#include "stdafx.h"
+
+#include "Core/DataStructures/StringTable.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace Kioto::StringTable
+{
+namespace
+{
+struct Table
+{
+    std::mutex Mutex;
+    std::unordered_map<std::string, StringId> Ids;
+    std::deque<std::string> Strings; // Deque keeps strings in place on push_back, so their c_str() stay valid.
+};
+
+// Strings are interned by constructors of global objects as well, so the table is created on the first use.
+Table& GetTable()
+{
+    static Table table;
+    return table;
+}
+}
+
+StringId Intern(const std::string& str)
+{
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.Mutex);
+    auto it = table.Ids.find(str);
+    if (it != table.Ids.end())
+        return it->second;
+
+    StringId id = static_cast<StringId>(table.Strings.size());
+    table.Strings.push_back(str);
+    table.Ids.emplace(str, id);
+    return id;
+}
+
+const char* GetString(StringId id)
+{
+    if (id == InvalidStringId)
+        return "";
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.Mutex);
+    assert(id < table.Strings.size());
+    return table.Strings[id].c_str();
+}
+}
\ No newline at end of file
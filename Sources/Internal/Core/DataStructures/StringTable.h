@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+#include "Core/Core.h"
+#include "Core/CoreTypes.h"
+
+namespace Kioto
+{
+///
+/// Id of the string interned in StringTable. Ids are stable for the whole run and cheap to copy into POD data.
+///
+using StringId = uint32;
+static constexpr StringId InvalidStringId = 0xFFFFFFFF;
+}
+
+namespace Kioto::StringTable
+{
+///
+/// Get id of the string, adding string to the table on the first call. Thread safe.
+///
+KIOTO_API StringId Intern(const std::string& str);
+///
+/// Get interned string by id. Returned pointer is valid for the whole run. Thread safe.
+///
+KIOTO_API const char* GetString(StringId id);
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Core/CoreTypes.h"
 #include "Core/Core.h"
 #include "Core/ECS/ComponentFactory.h"
+#include "Core/ECS/ComponentPool.h"
 
 #include <functional>
 
@@ -22,11 +23,22 @@ KIOTO_API uint64 GetType() const override \
 { \
     return type::GetTypeS(); \
 } \
-KIOTO_API static uint64 GetTypeS() \
+static constexpr uint64 GetTypeS() \
 { \
-    static std::hash<std::string> stringHasher; \
-    static uint64 hash = stringHasher(#type); \
-    return hash; \
+    return ConstStringToHash(#type); \
+} \
+KIOTO_API uint32 GetTypeIndex() const override \
+{ \
+    return type::GetTypeIndexS(); \
+} \
+KIOTO_API static uint32 GetTypeIndexS() \
+{ \
+    return type::GetTypeIndexStorageS(); \
+} \
+KIOTO_API static uint32& GetTypeIndexStorageS() \
+{ \
+    static uint32 index = ComponentFactory::InvalidTypeIndex; \
+    return index; \
 } \
 KIOTO_API const std::string& GetTypeName() const override \
 { \
@@ -37,6 +49,26 @@ KIOTO_API static const std::string& GetTypeNameS() \
 { \
     static std::string name = #type; \
     return name; \
+} \
+KIOTO_API static ComponentPool<type>& GetPoolS() \
+{ \
+    static ComponentPool<type> pool; \
+    return pool; \
+} \
+KIOTO_API ComponentPoolBase* GetPool() const override \
+{ \
+    return typeid(*this) == typeid(type) ? &type::GetPoolS() : nullptr; \
+} \
+static void* operator new(size_t size) \
+{ \
+    return size == sizeof(type) ? type::GetPoolS().Allocate() : ::operator new(size); \
+} \
+static void operator delete(void* ptr, size_t size) \
+{ \
+    if (size == sizeof(type)) \
+        type::GetPoolS().Deallocate(ptr); \
+    else \
+        ::operator delete(ptr); \
 }
 
 class Component
@@ -47,8 +79,19 @@ public:
 
     KIOTO_API Entity* GetEntity() const;
     KIOTO_API virtual Component* Clone() const abstract;
+    ///
+    /// Get serialized type id. Stable between runs.
+    ///
     KIOTO_API virtual uint64 GetType() const;
+    ///
+    /// Get dense type index assigned by ComponentFactory on registration. Not stable between runs, do not serialize it.
+    ///
+    KIOTO_API virtual uint32 GetTypeIndex() const;
     KIOTO_API virtual const std::string& GetTypeName() const;
+    ///
+    /// Get pool this component was allocated from. nullptr if component lives outside of the component pools.
+    ///
+    KIOTO_API virtual ComponentPoolBase* GetPool() const;
 
     KIOTO_API virtual bool GetIsEnabled() const;
     KIOTO_API virtual void SetIsEnabled(bool enabled);
@@ -76,11 +119,21 @@ inline uint64 Component::GetType() const
     return -1;
 }
 
+inline uint32 Component::GetTypeIndex() const
+{
+    return ComponentFactory::InvalidTypeIndex;
+}
+
 inline const std::string& Component::GetTypeName() const
 {
     return this->GetTypeName();
 }
 
+inline ComponentPoolBase* Component::GetPool() const
+{
+    return nullptr;
+}
+
 inline bool Component::GetIsEnabled() const
 {
     return m_isEnabled;
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <map>
-#include <functional>
+#include <array>
 
 #include "Core/Core.h"
 #include "Core/CoreTypes.h"
@@ -10,24 +9,49 @@ namespace Kioto
 {
 class Component;
 
+///
+/// Registry of component types. Every registered type gets dense type index in [0, MaxTypesCount),
+/// serialized type id (component GetTypeS) is mapped to the index on registration.
+///
 class ComponentFactory
 {
 public:
+    static constexpr uint32 MaxTypesCount = 64;
+    static constexpr uint32 InvalidTypeIndex = 0xFFFFFFFF;
+
     KIOTO_API static ComponentFactory& Instance()
     {
         static ComponentFactory i;
         return i;
     }
 
-    Component* CreateComponent(uint64 id)
-    {
-        if (m_componentsMap.find(id) == m_componentsMap.end())
-            return nullptr;
-        return m_componentsMap[id]();
-    }
+    ///
+    /// Create component by serialized type id. Returns nullptr for unknown type.
+    ///
+    Component* CreateComponent(uint64 type) const;
+    ///
+    /// Create component by dense type index. Returns nullptr for unknown index.
+    ///
+    Component* CreateComponentByIndex(uint32 typeIndex) const;
+    ///
+    /// Get dense type index of serialized type id. Returns InvalidTypeIndex for unknown type.
+    ///
+    uint32 GetTypeIndex(uint64 type) const;
+    uint32 GetTypesCount() const;
 
 private:
-    std::map<uint64, std::function<Component*()>> m_componentsMap;
+    using CreateFunction = Component*(*)();
+
+    struct TypeInfo
+    {
+        uint64 Type = 0;
+        CreateFunction Create = nullptr;
+    };
+
+    uint32 Register(uint64 type, CreateFunction create);
+
+    std::array<TypeInfo, MaxTypesCount> m_types;
+    uint32 m_typesCount = 0;
 
     template<typename T>
     friend class ComponentRegistrator;
@@ -39,17 +63,63 @@ class ComponentRegistrator
 public:
     ComponentRegistrator()
     {
-        uint64 i = T::GetTypeS();
-        ComponentFactory::Instance().m_componentsMap.insert(std::make_pair(T::GetTypeS(), &Create));
+        Register();
+    }
+
+    ///
+    /// Register the type now, for users which can run before static registrators. Registering several times is allowed.
+    ///
+    static void Register()
+    {
+        T::GetTypeIndexStorageS() = ComponentFactory::Instance().Register(T::GetTypeS(), &Create);
     }
 
 private:
-    static T* Create()
+    static Component* Create()
     {
         return new T;
     }
 };
 
+inline Component* ComponentFactory::CreateComponent(uint64 type) const
+{
+    return CreateComponentByIndex(GetTypeIndex(type));
+}
+
+inline Component* ComponentFactory::CreateComponentByIndex(uint32 typeIndex) const
+{
+    if (typeIndex >= m_typesCount)
+        return nullptr;
+    return m_types[typeIndex].Create();
+}
+
+inline uint32 ComponentFactory::GetTypeIndex(uint64 type) const
+{
+    for (uint32 i = 0; i < m_typesCount; ++i)
+    {
+        if (m_types[i].Type == type)
+            return i;
+    }
+    return InvalidTypeIndex;
+}
+
+inline uint32 ComponentFactory::GetTypesCount() const
+{
+    return m_typesCount;
+}
+
+inline uint32 ComponentFactory::Register(uint64 type, CreateFunction create)
+{
+    // Registrator is instantiated in every module which includes component header, so type can come here several times.
+    uint32 index = GetTypeIndex(type);
+    if (index != InvalidTypeIndex)
+        return index;
+
+    assert(m_typesCount < MaxTypesCount && "Too many component types, increase ComponentFactory::MaxTypesCount.");
+    m_types[m_typesCount] = { type, create };
+    return m_typesCount++;
+}
+
 #define REGISTER_COMPONENT(ComponentName) \
 __declspec(selectany) ComponentRegistrator<ComponentName> m_componentRegistrator_##ComponentName {}
-}
+}
\ No newline at end of file
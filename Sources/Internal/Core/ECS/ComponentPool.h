@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+#include "Core/CoreHelpers.h"
+
+namespace Kioto
+{
+///
+/// Type independent part of component pool. Components of one type live in fixed size chunks aligned to ChunkAlignment,
+/// so chunk header can be restored from the component address without any lookup. Pools are shared by all scenes, every
+/// live scene has its own index and active mask, so systems of a scene visit only the components of its entities.
+///
+class ComponentPoolBase
+{
+public:
+    static constexpr uint32 ChunkAlignment = 64 * 1024;
+    static constexpr uint32 MaxSlotsPerChunk = 512;
+    static constexpr uint32 MaskWordsCount = MaxSlotsPerChunk / 64;
+    static constexpr uint32 CacheLineSize = 64;
+    static constexpr uint32 MaxScenesCount = 4;
+
+    struct ChunkHeader
+    {
+        uint32 Index = 0;
+        uint32 AliveCount = 0;
+        uint32 SlotsOffset = 0;
+        uint32 Stride = 0;
+        uint64 Alive[MaskWordsCount] = {};
+        uint64 Active[MaxScenesCount][MaskWordsCount] = {};
+    };
+
+    ///
+    /// Mark pooled component as active in the scene. ForEach of the scene visits only components active in it. Scene activates
+    /// components of the entities it owns.
+    ///
+    static void SetActive(const void* component, uint32 sceneIndex, bool active);
+    ///
+    /// Get if pooled component is active in the scene.
+    ///
+    static bool GetActive(const void* component, uint32 sceneIndex);
+
+protected:
+    static ChunkHeader* GetChunkHeader(const void* component);
+    static uint32 GetSlotIndex(const ChunkHeader* header, const void* component);
+};
+
+///
+/// Chunked storage with stable addresses for components of type T. Components of the same type are laid out contiguously
+/// inside 64k chunks, freed slots are reused and never moved, so pointers to components stay valid for their whole life.
+///
+template <typename T>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    static constexpr uint32 SlotsOffset = static_cast<uint32>((sizeof(ChunkHeader) + CacheLineSize - 1) / CacheLineSize * CacheLineSize);
+    static constexpr uint32 SlotsPerChunk = static_cast<uint32>(std::min<size_t>(MaxSlotsPerChunk, (ChunkAlignment - SlotsOffset) / sizeof(T)));
+    static constexpr uint32 ChunkDataSize = SlotsOffset + SlotsPerChunk * static_cast<uint32>(sizeof(T));
+
+    static_assert(alignof(T) <= CacheLineSize, "Component alignment is too big for the pool.");
+    static_assert(SlotsPerChunk >= 4, "Component is too big for the pool chunk.");
+
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+    ~ComponentPool();
+
+    ///
+    /// Get memory for one component. Memory is not constructed.
+    ///
+    void* Allocate();
+    ///
+    /// Return memory of destroyed component back to the pool.
+    ///
+    void Deallocate(void* component);
+
+    ///
+    /// Call f(T&) for every component active in the scene. Components are visited chunk by chunk in memory order.
+    ///
+    template <typename F>
+    void ForEach(uint32 sceneIndex, F&& f);
+
+    ///
+    /// Call f(T* slots, const uint64* activeMask) for every chunk which has alive components.
+    /// Slot i is active in the scene if bit (i % 64) of activeMask[i / 64] is set.
+    ///
+    template <typename F>
+    void ForEachChunk(uint32 sceneIndex, F&& f);
+
+    uint32 GetAliveCount() const;
+    uint32 GetChunksCount() const;
+
+private:
+    static T* GetSlots(ChunkHeader* header);
+
+    std::vector<ChunkHeader*> m_chunks;
+    std::vector<uint32> m_chunksWithFreeSlots;
+    uint32 m_aliveCount = 0;
+};
+
+inline ComponentPoolBase::ChunkHeader* ComponentPoolBase::GetChunkHeader(const void* component)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(component);
+    return reinterpret_cast<ChunkHeader*>(address & ~static_cast<uintptr_t>(ChunkAlignment - 1));
+}
+
+inline uint32 ComponentPoolBase::GetSlotIndex(const ChunkHeader* header, const void* component)
+{
+    uintptr_t offset = reinterpret_cast<uintptr_t>(component) - reinterpret_cast<uintptr_t>(header) - header->SlotsOffset;
+    return static_cast<uint32>(offset / header->Stride);
+}
+
+inline void ComponentPoolBase::SetActive(const void* component, uint32 sceneIndex, bool active)
+{
+    assert(sceneIndex < MaxScenesCount);
+    ChunkHeader* header = GetChunkHeader(component);
+    uint32 slot = GetSlotIndex(header, component);
+    assert(header->Alive[slot / 64] & (1ull << (slot % 64)));
+    if (active)
+        header->Active[sceneIndex][slot / 64] |= 1ull << (slot % 64);
+    else
+        header->Active[sceneIndex][slot / 64] &= ~(1ull << (slot % 64));
+}
+
+inline bool ComponentPoolBase::GetActive(const void* component, uint32 sceneIndex)
+{
+    assert(sceneIndex < MaxScenesCount);
+    const ChunkHeader* header = GetChunkHeader(component);
+    uint32 slot = GetSlotIndex(header, component);
+    return (header->Active[sceneIndex][slot / 64] & (1ull << (slot % 64))) != 0;
+}
+
+template <typename T>
+ComponentPool<T>::~ComponentPool()
+{
+    assert(m_aliveCount == 0 && "Components are leaked");
+    for (auto chunk : m_chunks)
+    {
+        chunk->~ChunkHeader();
+        ::operator delete(chunk, std::align_val_t(ChunkAlignment));
+    }
+    m_chunks.clear();
+}
+
+template <typename T>
+void* ComponentPool<T>::Allocate()
+{
+    if (m_chunksWithFreeSlots.empty())
+    {
+        void* memory = ::operator new(ChunkDataSize, std::align_val_t(ChunkAlignment));
+        ChunkHeader* header = new (memory) ChunkHeader();
+        header->Index = static_cast<uint32>(m_chunks.size());
+        header->SlotsOffset = SlotsOffset;
+        header->Stride = static_cast<uint32>(sizeof(T));
+        m_chunks.push_back(header);
+        m_chunksWithFreeSlots.push_back(header->Index);
+    }
+
+    ChunkHeader* header = m_chunks[m_chunksWithFreeSlots.back()];
+    uint32 slot = SlotsPerChunk;
+    for (uint32 word = 0; word * 64 < SlotsPerChunk; ++word)
+    {
+        uint64 freeBits = ~header->Alive[word];
+        if (freeBits != 0)
+        {
+            slot = word * 64 + FirstSetBit(freeBits);
+            break;
+        }
+    }
+    assert(slot < SlotsPerChunk);
+
+    header->Alive[slot / 64] |= 1ull << (slot % 64);
+    if (++header->AliveCount == SlotsPerChunk)
+        m_chunksWithFreeSlots.pop_back();
+    ++m_aliveCount;
+
+    return GetSlots(header) + slot;
+}
+
+template <typename T>
+void ComponentPool<T>::Deallocate(void* component)
+{
+    ChunkHeader* header = GetChunkHeader(component);
+    uint32 slot = GetSlotIndex(header, component);
+    assert(header->Alive[slot / 64] & (1ull << (slot % 64)));
+
+    header->Alive[slot / 64] &= ~(1ull << (slot % 64));
+    for (uint32 scene = 0; scene < MaxScenesCount; ++scene)
+        header->Active[scene][slot / 64] &= ~(1ull << (slot % 64));
+    if (header->AliveCount-- == SlotsPerChunk)
+        m_chunksWithFreeSlots.push_back(header->Index);
+    --m_aliveCount;
+}
+
+template <typename T>
+template <typename F>
+void ComponentPool<T>::ForEach(uint32 sceneIndex, F&& f)
+{
+    ForEachChunk(sceneIndex, [&f](T* slots, const uint64* activeMask)
+    {
+        for (uint32 word = 0; word * 64 < SlotsPerChunk; ++word)
+        {
+            uint64 bits = activeMask[word];
+            while (bits != 0)
+            {
+                f(slots[word * 64 + FirstSetBit(bits)]);
+                bits &= bits - 1;
+            }
+        }
+    });
+}
+
+template <typename T>
+template <typename F>
+void ComponentPool<T>::ForEachChunk(uint32 sceneIndex, F&& f)
+{
+    assert(sceneIndex < MaxScenesCount);
+    for (auto header : m_chunks)
+    {
+        if (header->AliveCount == 0)
+            continue;
+        f(GetSlots(header), static_cast<const uint64*>(header->Active[sceneIndex]));
+    }
+}
+
+template <typename T>
+inline uint32 ComponentPool<T>::GetAliveCount() const
+{
+    return m_aliveCount;
+}
+
+template <typename T>
+inline uint32 ComponentPool<T>::GetChunksCount() const
+{
+    return static_cast<uint32>(m_chunks.size());
+}
+
+template <typename T>
+inline T* ComponentPool<T>::GetSlots(ChunkHeader* header)
+{
+    return reinterpret_cast<T*>(reinterpret_cast<byte*>(header) + SlotsOffset);
+}
+}
\ No newline at end of file
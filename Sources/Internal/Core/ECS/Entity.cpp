@@ -32,31 +32,42 @@ Entity::~Entity()
     for (auto& component : m_components)
         SafeDelete(component);
     m_components.clear();
+    m_componentsMask = 0;
 }
 
 void Entity::RemoveComponent(Component* component)
 {
-    auto it = std::find(m_components.begin(), m_components.end(), component);
-    if (it != m_components.end())
-    {
-        delete &(*it);
-        m_components.erase(it);
-    }
+    uint32 typeIndex = component->GetTypeIndex();
+    if (GetComponentByIndex(typeIndex) != component)
+        return;
+
+    m_components.erase(m_components.begin() + GetComponentPosition(typeIndex));
+    m_componentsMask &= ~(1ull << typeIndex);
+    if (component == m_transform)
+        m_transform = nullptr;
+    delete component;
 }
 
 void Entity::AddComponent(Component* component)
 {
     if (component->GetEntity() != nullptr)
         return; // [a_vorontcov] TODO: Do something scary here.
+    uint32 typeIndex = component->GetTypeIndex();
+    assert(typeIndex < ComponentFactory::MaxTypesCount && "Component type is not registered.");
+    assert((m_componentsMask & (1ull << typeIndex)) == 0 && "Only one component of each type per entity is allowed.");
+    if ((m_componentsMask & (1ull << typeIndex)) != 0)
+        return;
+
     component->SetEntity(this);
-    m_components.push_back(component);
-    if (component->GetType() == TransformComponent::GetTypeS())
+    m_components.insert(m_components.begin() + GetComponentPosition(typeIndex), component);
+    m_componentsMask |= 1ull << typeIndex;
+    if (typeIndex == TransformComponent::GetTypeIndexS())
         m_transform = static_cast<TransformComponent*>(component);
 }
 
-Component* Entity::GetComponent(uint64 componentTypeIndex) const
+Component* Entity::GetComponent(uint64 componentType) const
 {
-    auto it = std::find_if(m_components.begin(), m_components.end(), [componentTypeIndex](Component* c) { return c->GetType() == componentTypeIndex; });
+    auto it = std::find_if(m_components.begin(), m_components.end(), [componentType](Component* c) { return c->GetType() == componentType; });
     if (it != m_components.end())
         return *it;
     return nullptr;
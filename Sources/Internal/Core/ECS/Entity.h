@@ -13,6 +13,24 @@ class Node;
 
 namespace Kioto
 {
+class Scene;
+
+///
+/// Scene entity handle. Index addresses the scene entity slot, generation is bumped every time the slot is freed,
+/// so handles of removed entities can be detected as stale.
+///
+struct EntityId
+{
+    static constexpr uint32 InvalidIndex = 0xFFFFFFFF;
+
+    uint32 Index = InvalidIndex;
+    uint32 Generation = 0;
+
+    bool GetIsValid() const;
+    bool operator==(const EntityId& other) const;
+    bool operator!=(const EntityId& other) const;
+};
+
 class Entity
 {
 public:
@@ -27,47 +45,89 @@ public:
     KIOTO_API void RemoveComponent(Component* component);
     KIOTO_API void AddComponent(Component* component);
 
-    Component* GetComponent(uint64 componentTypeIndex) const;
+    ///
+    /// Get component by serialized type id.
+    ///
+    Component* GetComponent(uint64 componentType) const;
+    ///
+    /// Get component by dense type index. Constant time.
+    ///
+    Component* GetComponentByIndex(uint32 componentTypeIndex) const;
     template <typename T, typename = std::enable_if_t<std::is_convertible_v<T*, Component*>>>
     T* GetComponent() const;
+    ///
+    /// Get mask of component type indices this entity has.
+    ///
+    uint64 GetComponentsMask() const;
     TransformComponent* GetTransform() const;
     const std::vector<Component*>& GetComponents() const;
     const std::string& GetName() const;
     void SetName(std::string name);
+    ///
+    /// Get scene handle of the entity. Handle is invalid while entity is not added to scene.
+    ///
+    EntityId GetId() const;
 
     void Serialize(YAML::Emitter& out) const;
     void Deserialize(const YAML::Node& in);
 
 private:
-    std::vector<Component*> m_components; // [a_vorontcov] Bad, bad thing...
+    uint32 GetComponentPosition(uint32 componentTypeIndex) const;
+
+    std::vector<Component*> m_components; // [a_vorontcov] Bad, bad thing... Sorted by component type index.
+    uint64 m_componentsMask = 0;
     std::string m_name = "Entity";
     TransformComponent* m_transform = nullptr;
+    EntityId m_id;
 
+    friend class Scene;
     friend void swap(Entity& e1, Entity& e2);
 };
 
+inline bool EntityId::GetIsValid() const
+{
+    return Index != InvalidIndex;
+}
+
+inline bool EntityId::operator==(const EntityId& other) const
+{
+    return Index == other.Index && Generation == other.Generation;
+}
+
+inline bool EntityId::operator!=(const EntityId& other) const
+{
+    return !(*this == other);
+}
+
 template <typename T, typename>
 void Entity::RemoveComponent()
 {
-    auto it = std::find_if(m_components.begin(), m_components.end(), 
-        [](Component* c) 
-        {
-            return typename T::GetTypeS() == c->GetType();
-        });
-    if (it != m_components.end())
-    {
-        delete &(*it);
-        m_components.erase(it);
-    }
+    Component* c = GetComponentByIndex(T::GetTypeIndexS());
+    if (c != nullptr)
+        RemoveComponent(c);
 }
 
 template <typename T, typename>
 T* Entity::GetComponent() const
 {
-    Component* c = GetComponent(T::GetTypeS());
-    if (c != nullptr)
-        return static_cast<T*>(c);
-    return nullptr;
+    return static_cast<T*>(GetComponentByIndex(T::GetTypeIndexS()));
+}
+
+inline Component* Entity::GetComponentByIndex(uint32 componentTypeIndex) const
+{
+    if (componentTypeIndex >= ComponentFactory::MaxTypesCount || (m_componentsMask & (1ull << componentTypeIndex)) == 0)
+        return nullptr;
+    return m_components[GetComponentPosition(componentTypeIndex)];
+}
+
+inline uint32 Entity::GetComponentPosition(uint32 componentTypeIndex) const
+{
+    return BitCount(m_componentsMask & ((1ull << componentTypeIndex) - 1));
+}
+
+inline uint64 Entity::GetComponentsMask() const
+{
+    return m_componentsMask;
 }
 
 inline const std::vector<Component*>& Entity::GetComponents() const
@@ -79,6 +139,8 @@ inline void swap(Entity& e1, Entity& e2)
 {
     using std::swap;
     swap(e1.m_components, e2.m_components);
+    swap(e1.m_componentsMask, e2.m_componentsMask);
+    swap(e1.m_transform, e2.m_transform);
 }
 
 inline TransformComponent* Entity::GetTransform() const
@@ -95,4 +157,9 @@ inline void Entity::SetName(std::string name)
 {
     std::swap(m_name, name);
 }
+
+inline EntityId Entity::GetId() const
+{
+    return m_id;
+}
 }
@@ -1,11 +1,28 @@
 #pragma once
 
 #include "Core/CoreTypes.h"
+#include "Core/ECS/ComponentFactory.h"
 
 namespace Kioto
 {
 class Entity;
 
+///
+/// Component types accessed by system update. Masks are built from dense component type indices.
+///
+struct SystemAccess
+{
+    uint64 Read = 0;
+    uint64 Write = 0;
+    bool IsDeclared = false;
+    bool IsMainThreadOnly = false;
+
+    ///
+    /// Get if systems with these accesses can't be updated concurrently. Undeclared access conflicts with everything.
+    ///
+    bool GetConflicts(const SystemAccess& other) const;
+};
+
 class SceneSystem
 {
 public:
@@ -34,16 +51,92 @@ public:
     /// Get if system needs update.
     ///
     bool GetNeedUpdatable() const;
+    ///
+    /// Get component access of the system update. Scene updates systems without conflicting accesses concurrently.
+    ///
+    const SystemAccess& GetAccess() const;
+    ///
+    /// Get index of the owning scene in component pools. Systems visit pooled components active in this scene only.
+    ///
+    uint32 GetSceneIndex() const;
+
+protected:
+    ///
+    /// Declare that system update reads components of type T.
+    ///
+    template <typename T>
+    void DeclareRead();
+    ///
+    /// Declare that system update writes components of type T.
+    ///
+    template <typename T>
+    void DeclareWrite();
+    ///
+    /// Declare that system update must be called from the main thread (imgui, render api calls etc.).
+    ///
+    void DeclareMainThreadOnly();
 
 private:
+    template <typename T>
+    static uint64 GetComponentBit();
+
     bool m_updatable = true;
+    SystemAccess m_access;
+    uint32 m_sceneIndex = 0;
+
+    friend class Scene;
 };
 
+inline bool SystemAccess::GetConflicts(const SystemAccess& other) const
+{
+    if (!IsDeclared || !other.IsDeclared)
+        return true;
+    return (Write & (other.Read | other.Write)) != 0 || (other.Write & Read) != 0;
+}
+
 inline bool SceneSystem::GetNeedUpdatable() const
 {
     return m_updatable;
 }
 
+inline const SystemAccess& SceneSystem::GetAccess() const
+{
+    return m_access;
+}
+
+inline uint32 SceneSystem::GetSceneIndex() const
+{
+    return m_sceneIndex;
+}
+
+template <typename T>
+uint64 SceneSystem::GetComponentBit()
+{
+    if (T::GetTypeIndexS() == ComponentFactory::InvalidTypeIndex)
+        ComponentRegistrator<T>::Register(); // System is created before static registration of the component type has run.
+    assert(T::GetTypeIndexS() < ComponentFactory::MaxTypesCount);
+    return 1ull << T::GetTypeIndexS();
+}
+
+template <typename T>
+void SceneSystem::DeclareRead()
+{
+    m_access.Read |= GetComponentBit<T>();
+    m_access.IsDeclared = true;
+}
+
+template <typename T>
+void SceneSystem::DeclareWrite()
+{
+    m_access.Write |= GetComponentBit<T>();
+    m_access.IsDeclared = true;
+}
+
+inline void SceneSystem::DeclareMainThreadOnly()
+{
+    m_access.IsMainThreadOnly = true;
+}
+
 inline void SceneSystem::Init()
 {
 }
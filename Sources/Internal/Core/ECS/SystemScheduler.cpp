@@ -0,0 +1,68 @@
+#include "stdafx.h"
+
+#include "Core/ECS/SystemScheduler.h"
+
+#include <algorithm>
+
+#include "Core/ECS/SceneSystem.h"
+#include "Core/Jobs/JobSystem.h"
+
+namespace Kioto
+{
+void SystemScheduler::Build(const std::vector<SceneSystem*>& systems)
+{
+    m_systems = systems;
+    m_waves.clear();
+
+    // Every system goes to the wave after the last wave of the preceding systems it conflicts with,
+    // so conflicting systems are updated in registration order and the graph is a DAG by construction.
+    std::vector<uint32> systemWaves(m_systems.size(), 0);
+    for (size_t i = 0; i < m_systems.size(); ++i)
+    {
+        const SystemAccess& access = m_systems[i]->GetAccess();
+        uint32 wave = 0;
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (access.GetConflicts(m_systems[j]->GetAccess()))
+                wave = (std::max)(wave, systemWaves[j] + 1);
+        }
+        systemWaves[i] = wave;
+
+        if (wave >= m_waves.size())
+            m_waves.resize(wave + 1);
+        m_waves[wave].push_back(m_systems[i]);
+    }
+}
+
+void SystemScheduler::Update(float32 dt)
+{
+    if (m_isSerial)
+    {
+        for (auto system : m_systems)
+            system->Update(dt);
+        return;
+    }
+
+    for (const auto& wave : m_waves)
+    {
+        if (wave.size() == 1)
+        {
+            wave.front()->Update(dt);
+            continue;
+        }
+
+        JobSystem::JobCounter counter;
+        for (auto system : wave)
+        {
+            if (!system->GetAccess().IsMainThreadOnly)
+                JobSystem::Run([system, dt]() { system->Update(dt); }, &counter);
+        }
+        for (auto system : wave)
+        {
+            if (system->GetAccess().IsMainThreadOnly)
+                system->Update(dt);
+        }
+        JobSystem::Wait(&counter);
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto
+{
+class SceneSystem;
+
+///
+/// Updates scene systems. Builds dependency graph from declared component accesses (systems with conflicting accesses
+/// keep their registration order) and updates independent systems concurrently.
+///
+class SystemScheduler
+{
+public:
+    ///
+    /// Rebuild dependency graph. Must be called every time systems list is changed.
+    ///
+    void Build(const std::vector<SceneSystem*>& systems);
+
+    ///
+    /// Update all systems. Returns when all of them are done.
+    ///
+    void Update(float32 dt);
+
+    ///
+    /// Update systems one by one in registration order on the calling thread. Deterministic, for debugging.
+    ///
+    void SetIsSerial(bool isSerial);
+    bool GetIsSerial() const;
+
+private:
+    std::vector<SceneSystem*> m_systems;
+    std::vector<std::vector<SceneSystem*>> m_waves; // Systems of one wave don't conflict with each other.
+    bool m_isSerial = false;
+};
+
+inline void SystemScheduler::SetIsSerial(bool isSerial)
+{
+    m_isSerial = isSerial;
+}
+
+inline bool SystemScheduler::GetIsSerial() const
+{
+    return m_isSerial;
+}
+}
\ No newline at end of file
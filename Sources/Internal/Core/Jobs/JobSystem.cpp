@@ -0,0 +1,220 @@
+#include "stdafx.h"
+
+#include "Core/Jobs/JobSystem.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Kioto::JobSystem
+{
+namespace
+{
+constexpr uint32 InitialQueueCapacity = 256;
+
+struct Job
+{
+    JobFunction Function;
+    JobCounter* Counter = nullptr;
+};
+
+///
+/// Owner pushes and pops jobs from the back, thieves take the oldest jobs from the front.
+/// Jobs are kept in a ring buffer which only grows, so steady state frames don't allocate.
+///
+struct WorkerQueue
+{
+    WorkerQueue();
+
+    bool GetIsEmpty() const;
+    void PushBack(Job&& job);
+    void PopBack(Job& job);
+    void PopFront(Job& job);
+
+    std::mutex Mutex;
+    std::vector<Job> Jobs; // Size is power of 2.
+    uint32 Front = 0;
+    uint32 Count = 0;
+};
+
+WorkerQueue::WorkerQueue()
+    : Jobs(InitialQueueCapacity)
+{
+}
+
+bool WorkerQueue::GetIsEmpty() const
+{
+    return Count == 0;
+}
+
+void WorkerQueue::PushBack(Job&& job)
+{
+    if (Count == Jobs.size())
+    {
+        std::vector<Job> grown(Jobs.size() * 2);
+        for (uint32 i = 0; i < Count; ++i)
+            grown[i] = std::move(Jobs[(Front + i) & (Jobs.size() - 1)]);
+        Jobs.swap(grown);
+        Front = 0;
+    }
+    Jobs[(Front + Count) & (Jobs.size() - 1)] = std::move(job);
+    ++Count;
+}
+
+void WorkerQueue::PopBack(Job& job)
+{
+    --Count;
+    job = std::move(Jobs[(Front + Count) & (Jobs.size() - 1)]);
+}
+
+void WorkerQueue::PopFront(Job& job)
+{
+    job = std::move(Jobs[Front]);
+    Front = (Front + 1) & (Jobs.size() - 1);
+    --Count;
+}
+
+std::vector<std::unique_ptr<WorkerQueue>> Queues;
+std::vector<std::thread> Workers;
+std::atomic<uint32> PendingJobsCount = 0;
+std::atomic<bool> IsStopping = false;
+std::mutex SleepMutex;
+std::condition_variable SleepCondition;
+uint32 WorkersCount = 1;
+
+thread_local uint32 WorkerIndex = 0; // Main thread and threads unknown to the job system use queue 0.
+
+bool TryPop(uint32 queueIndex, Job& job)
+{
+    WorkerQueue& queue = *Queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (queue.GetIsEmpty())
+        return false;
+    queue.PopBack(job);
+    return true;
+}
+
+bool TrySteal(uint32 queueIndex, Job& job)
+{
+    WorkerQueue& queue = *Queues[queueIndex];
+    std::unique_lock<std::mutex> lock(queue.Mutex, std::try_to_lock);
+    if (!lock.owns_lock() || queue.GetIsEmpty())
+        return false;
+    queue.PopFront(job);
+    return true;
+}
+
+bool TryGetJob(Job& job)
+{
+    if (TryPop(WorkerIndex, job))
+        return true;
+    for (uint32 i = 1; i < WorkersCount; ++i)
+    {
+        if (TrySteal((WorkerIndex + i) % WorkersCount, job))
+            return true;
+    }
+    return false;
+}
+
+void Execute(Job& job)
+{
+    PendingJobsCount.fetch_sub(1, std::memory_order_relaxed);
+    job.Function();
+    if (job.Counter != nullptr)
+        job.Counter->Decrement();
+}
+
+bool TryExecuteOne()
+{
+    Job job;
+    if (!TryGetJob(job))
+        return false;
+    Execute(job);
+    return true;
+}
+
+void WorkerLoop(uint32 index)
+{
+    WorkerIndex = index;
+    while (!IsStopping.load(std::memory_order_acquire))
+    {
+        if (TryExecuteOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock(SleepMutex);
+        SleepCondition.wait(lock, []()
+        {
+            return PendingJobsCount.load(std::memory_order_relaxed) > 0 || IsStopping.load(std::memory_order_relaxed);
+        });
+    }
+}
+}
+
+void Init(uint32 workersCount)
+{
+    assert(Workers.empty());
+    if (workersCount == 0)
+        workersCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+    WorkersCount = workersCount;
+    IsStopping = false;
+
+    Queues.clear();
+    for (uint32 i = 0; i < WorkersCount; ++i)
+        Queues.push_back(std::make_unique<WorkerQueue>());
+    for (uint32 i = 1; i < WorkersCount; ++i)
+        Workers.emplace_back(WorkerLoop, i);
+}
+
+void Shutdown()
+{
+    assert(PendingJobsCount == 0 && "Not all jobs are done");
+    {
+        std::lock_guard<std::mutex> lock(SleepMutex);
+        IsStopping = true;
+    }
+    SleepCondition.notify_all();
+    for (auto& worker : Workers)
+        worker.join();
+    Workers.clear();
+    Queues.clear();
+    WorkersCount = 1;
+}
+
+uint32 GetWorkersCount()
+{
+    return WorkersCount;
+}
+
+void Run(JobFunction job, JobCounter* counter)
+{
+    if (WorkersCount == 1)
+    {
+        job();
+        return;
+    }
+
+    if (counter != nullptr)
+        counter->Increment();
+    {
+        std::lock_guard<std::mutex> lock(SleepMutex);
+        PendingJobsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        WorkerQueue& queue = *Queues[WorkerIndex];
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.PushBack({ std::move(job), counter });
+    }
+    SleepCondition.notify_one();
+}
+
+void Wait(const JobCounter* counter)
+{
+    while (!counter->GetIsDone())
+    {
+        if (!TryExecuteOne())
+            std::this_thread::yield();
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Core.h"
+#include "Core/CoreTypes.h"
+
+namespace Kioto::JobSystem
+{
+///
+/// Counter of unfinished jobs. Job increments counter on run and decrements it when done.
+///
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool GetIsDone() const;
+    void Increment();
+    void Decrement();
+
+private:
+    std::atomic<uint32> m_value = 0;
+};
+
+///
+/// Move only callable stored in place, so running a job doesn't allocate. Captures of a job must fit into CapacitySize bytes,
+/// capture large state by reference or pointer.
+///
+class JobFunction
+{
+public:
+    static constexpr size_t CapacitySize = 48;
+
+    JobFunction() = default;
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, JobFunction>>>
+    JobFunction(F&& f);
+    JobFunction(JobFunction&& other) noexcept;
+    JobFunction& operator=(JobFunction&& other) noexcept;
+    JobFunction(const JobFunction&) = delete;
+    JobFunction& operator=(const JobFunction&) = delete;
+    ~JobFunction();
+
+    void operator()();
+
+private:
+    using InvokeFunction = void(*)(void* storage);
+    using MoveFunction = void(*)(void* dst, void* src); // Move constructs dst from src and destroys src.
+    using DestroyFunction = void(*)(void* storage);
+
+    void Reset();
+
+    alignas(std::max_align_t) byte m_storage[CapacitySize];
+    InvokeFunction m_invoke = nullptr;
+    MoveFunction m_move = nullptr;
+    DestroyFunction m_destroy = nullptr;
+};
+
+///
+/// Start worker threads. workersCount is total count of threads executing jobs including the calling (main) thread,
+/// 0 means count of hardware threads. With 1 worker there are no worker threads and Run executes job immediately,
+/// which gives deterministic order for debugging.
+///
+KIOTO_API void Init(uint32 workersCount = 0);
+///
+/// Stop and join worker threads. All submitted jobs must be waited before.
+///
+KIOTO_API void Shutdown();
+///
+/// Get count of threads executing jobs including the main thread.
+///
+KIOTO_API uint32 GetWorkersCount();
+///
+/// Push job to the queue of the calling thread. Idle workers steal jobs from the other queues.
+///
+KIOTO_API void Run(JobFunction job, JobCounter* counter = nullptr);
+///
+/// Wait until all jobs of the counter are done. Calling thread executes queued jobs while waiting.
+///
+KIOTO_API void Wait(const JobCounter* counter);
+///
+/// Split [begin, end) into ranges of grainSize elements and call f(rangeBegin, rangeEnd) for them on the workers. Blocking.
+///
+template <typename F>
+void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, F&& f);
+
+template <typename F, typename>
+JobFunction::JobFunction(F&& f)
+{
+    using Callable = std::decay_t<F>;
+    static_assert(sizeof(Callable) <= CapacitySize, "Job captures don't fit into JobFunction storage");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job captures are overaligned");
+    static_assert(std::is_nothrow_move_constructible_v<Callable>, "Job captures must be nothrow movable");
+
+    new (m_storage) Callable(std::forward<F>(f));
+    m_invoke = [](void* storage) { (*static_cast<Callable*>(storage))(); };
+    m_move = [](void* dst, void* src)
+    {
+        new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+        static_cast<Callable*>(src)->~Callable();
+    };
+    m_destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); };
+}
+
+inline JobFunction::JobFunction(JobFunction&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+inline JobFunction& JobFunction::operator=(JobFunction&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    Reset();
+    if (other.m_invoke != nullptr)
+    {
+        other.m_move(m_storage, other.m_storage);
+        m_invoke = other.m_invoke;
+        m_move = other.m_move;
+        m_destroy = other.m_destroy;
+        other.m_invoke = nullptr;
+        other.m_move = nullptr;
+        other.m_destroy = nullptr;
+    }
+    return *this;
+}
+
+inline JobFunction::~JobFunction()
+{
+    Reset();
+}
+
+inline void JobFunction::operator()()
+{
+    m_invoke(m_storage);
+}
+
+inline void JobFunction::Reset()
+{
+    if (m_destroy != nullptr)
+        m_destroy(m_storage);
+    m_invoke = nullptr;
+    m_move = nullptr;
+    m_destroy = nullptr;
+}
+
+inline bool JobCounter::GetIsDone() const
+{
+    return m_value.load(std::memory_order_acquire) == 0;
+}
+
+inline void JobCounter::Increment()
+{
+    m_value.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void JobCounter::Decrement()
+{
+    m_value.fetch_sub(1, std::memory_order_release);
+}
+
+template <typename F>
+void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, F&& f)
+{
+    if (begin >= end)
+        return;
+    grainSize = grainSize > 0 ? grainSize : 1;
+    if (end - begin <= grainSize || GetWorkersCount() == 1)
+    {
+        f(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32 rangeBegin = begin + grainSize; rangeBegin < end; rangeBegin += grainSize)
+    {
+        uint32 rangeEnd = end - rangeBegin > grainSize ? rangeBegin + grainSize : end;
+        Run([&f, rangeBegin, rangeEnd]() { f(rangeBegin, rangeEnd); }, &counter);
+    }
+    f(begin, begin + grainSize);
+    Wait(&counter);
+}
+}
\ No newline at end of file
@@ -5,12 +5,18 @@
 
 #include "stdafx.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <sstream>
 
 #include "AssetsSystem/AssetsSystem.h"
 #include "Core/FPSCounter.h"
 #include "Core/Input/Input.h"
+#include "Core/Jobs/JobSystem.h"
 #include "Core/KiotoEngine.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Core/Memory/HeapAllocationsCounter.h"
 #include "Core/Scene.h"
 #include "Core/Timer/GlobalTimer.h"
 #include "Core/WindowsApplication.h"
@@ -36,6 +42,34 @@ namespace KiotoCore
 {
 ApplicationInfoData ApplicationInfo;
 Kioto::RenderOptions RenderSettings;
+
+void InitSystems();
+void InitRenderer(Renderer::eRenderApi api);
+///
+/// Render stats summed over the headless run. Per frame counters are uint32, sums of long runs don't fit into them.
+///
+struct HeadlessStats
+{
+    uint64 DrawsCount = 0;
+    uint64 InstancesCount = 0;
+    uint64 PipelineStateChanges = 0;
+    uint64 RootSignatureChanges = 0;
+    uint64 TextureSetChanges = 0;
+    uint64 MeshChanges = 0;
+    uint64 ConstantBufferBindings = 0;
+    uint64 SkippedStateChanges = 0;
+    uint64 ResourceTransitions = 0;
+    uint64 ConstantDataUploaded = 0;
+    uint64 ConstantDataSkipped = 0;
+    uint64 ValidationErrors = 0;
+
+    void Add(const Renderer::RenderStats& frameStats);
+};
+
+void PrintHeadlessReport(std::vector<float64>& frameTimes, const HeadlessStats& stats, uint32 steadyFramesCount, uint64 steadyHeapAllocationsCount);
+
+// Frame arenas grow to the peak frame size after overflowing, so frames after several full arena rings allocate nothing.
+constexpr uint32 HeadlessWarmupFramesCount = 16;
 }
 
 void KiotoMain(HINSTANCE hInstance, HINSTANCE prevInstance, PSTR cmdLine, int nCmdShow, std::wstring capture, std::function<void()> initEngineCallback, std::function<void()> shutdownEngineCallback)
@@ -100,6 +134,47 @@ void LoadScene(std::string path)
     }
 }
 
+HeadlessRunResult KiotoHeadlessMain(const std::string& scenePath, uint32 framesCount, std::function<void()> initEngineCallback, std::function<void()> shutdownEngineCallback)
+{
+    InitEngineCallback = initEngineCallback;
+    ShutdownEngineCallback = shutdownEngineCallback;
+
+    KiotoCore::InitSystems();
+    KiotoCore::InitRenderer(Renderer::eRenderApi::Null);
+    if (!scenePath.empty())
+        LoadScene(scenePath);
+
+    std::vector<float64> frameTimes;
+    frameTimes.reserve(framesCount);
+    KiotoCore::HeadlessStats stats;
+    uint64 warmupHeapAllocationsCount = 0;
+    for (uint32 i = 0; i < framesCount; ++i)
+    {
+        if (i == KiotoCore::HeadlessWarmupFramesCount)
+            warmupHeapAllocationsCount = HeapAllocationsCounter::GetCount();
+
+        auto frameStart = std::chrono::high_resolution_clock::now();
+        KiotoCore::Update();
+        std::chrono::duration<float64, std::milli> frameTime = std::chrono::high_resolution_clock::now() - frameStart;
+        frameTimes.push_back(frameTime.count());
+
+        stats.Add(Renderer::GetLastFrameStats());
+    }
+    uint32 steadyFramesCount = framesCount > KiotoCore::HeadlessWarmupFramesCount ? framesCount - KiotoCore::HeadlessWarmupFramesCount : 0;
+    uint64 steadyHeapAllocationsCount = steadyFramesCount > 0 ? HeapAllocationsCounter::GetCount() - warmupHeapAllocationsCount : 0;
+    KiotoCore::PrintHeadlessReport(frameTimes, stats, steadyFramesCount, steadyHeapAllocationsCount);
+
+    KiotoCore::Shutdown();
+
+    HeadlessRunResult result;
+    result.FramesCount = framesCount;
+    result.DrawsCount = stats.DrawsCount;
+    result.ValidationErrors = stats.ValidationErrors;
+    result.SteadyFramesCount = steadyFramesCount;
+    result.SteadyHeapAllocationsCount = steadyHeapAllocationsCount;
+    return result;
+}
+
 Scene* GetScene()
 {
     return m_scene;
@@ -109,24 +184,76 @@ namespace KiotoCore
 {
 void Init()
 {
+    InitSystems();
+    WindowsApplication::Init(ApplicationInfo.HInstance, ApplicationInfo.NCmdShow, ApplicationInfo.WindowCapture);
+    InitRenderer(Renderer::eRenderApi::DirectX12);
+
+    WindowsApplication::Run();
+}
+
+void InitSystems()
+{
+    JobSystem::Init();
+    FrameAllocator::Init();
     GlobalTimer::Init();
     AssetsSystem::Init();
     MeshLoader::Init();
     Renderer::GeometryGenerator::Init();
-    WindowsApplication::Init(ApplicationInfo.HInstance, ApplicationInfo.NCmdShow, ApplicationInfo.WindowCapture);
+}
+
+void InitRenderer(Renderer::eRenderApi api)
+{
     Renderer::EngineBuffers::Init();
-    Renderer::Init(Renderer::eRenderApi::DirectX12, RenderSettings.Resolution.x, RenderSettings.Resolution.y);
+    Renderer::Init(api, RenderSettings.Resolution.x, RenderSettings.Resolution.y);
 
     Renderer::GeometryGenerator::RegisterGeometry();
 
     if (InitEngineCallback != nullptr)
         InitEngineCallback();
+}
 
-    WindowsApplication::Run();
+void HeadlessStats::Add(const Renderer::RenderStats& frameStats)
+{
+    DrawsCount += frameStats.DrawsCount;
+    InstancesCount += frameStats.InstancesCount;
+    PipelineStateChanges += frameStats.PipelineStateChanges;
+    RootSignatureChanges += frameStats.RootSignatureChanges;
+    TextureSetChanges += frameStats.TextureSetChanges;
+    MeshChanges += frameStats.MeshChanges;
+    ConstantBufferBindings += frameStats.ConstantBufferBindings;
+    SkippedStateChanges += frameStats.SkippedStateChanges;
+    ResourceTransitions += frameStats.ResourceTransitions;
+    ConstantDataUploaded += frameStats.ConstantDataUploaded;
+    ConstantDataSkipped += frameStats.ConstantDataSkipped;
+    ValidationErrors += frameStats.ValidationErrors;
+}
+
+void PrintHeadlessReport(std::vector<float64>& frameTimes, const HeadlessStats& stats, uint32 steadyFramesCount, uint64 steadyHeapAllocationsCount)
+{
+    if (frameTimes.empty())
+        return;
+
+    float64 totalTime = 0.0;
+    for (float64 time : frameTimes)
+        totalTime += time;
+    float64 framesCount = static_cast<float64>(frameTimes.size());
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    std::printf("Frames: %zu, total %.3f ms\n", frameTimes.size(), totalTime);
+    std::printf("Frame ms: avg %.3f, min %.3f, median %.3f, p95 %.3f, max %.3f\n", totalTime / framesCount, frameTimes.front(),
+        frameTimes[frameTimes.size() / 2], frameTimes[frameTimes.size() * 95 / 100], frameTimes.back());
+    std::printf("Per frame: draws %.1f, instances %.1f, pso changes %.1f, root signature changes %.1f, texture set changes %.1f, mesh changes %.1f, cb bindings %.1f, skipped state changes %.1f, transitions %.1f, constant bytes %.1f, skipped constant bytes %.1f\n",
+        stats.DrawsCount / framesCount, stats.InstancesCount / framesCount, stats.PipelineStateChanges / framesCount, stats.RootSignatureChanges / framesCount, stats.TextureSetChanges / framesCount,
+        stats.MeshChanges / framesCount, stats.ConstantBufferBindings / framesCount, stats.SkippedStateChanges / framesCount, stats.ResourceTransitions / framesCount,
+        stats.ConstantDataUploaded / framesCount, stats.ConstantDataSkipped / framesCount);
+    std::printf("Validation errors: %llu\n", stats.ValidationErrors);
+    if (steadyFramesCount > 0)
+        std::printf("Heap allocations in %u steady state frames: %llu\n", steadyFramesCount, steadyHeapAllocationsCount);
 }
 
 void Update()
 {
+    FrameAllocator::BeginFrame();
     Input::Update();
     GlobalTimer::Tick();
     FPSCounter::Tick(GlobalTimer::GetDeltaTime());
@@ -147,6 +274,8 @@ void Shutdown()
     Renderer::GeometryGenerator::Shutdown();
     MeshLoader::Shutdown();
     AssetsSystem::Shutdown();
+    FrameAllocator::Shutdown();
+    JobSystem::Shutdown();
 }
 
 void ChangeFullscreenMode(bool fullScreen)
@@ -31,6 +31,24 @@ struct RenderOptions;
 ///
 KIOTO_API void KiotoMain(HINSTANCE hInstance, HINSTANCE prevInstance, PSTR cmdLine, int nCmdShow, std::wstring capture, std::function<void()> initEngineCallback = nullptr, std::function<void()> shutdownEngineCallback = nullptr);
 
+///
+/// Totals of a headless run.
+///
+struct HeadlessRunResult
+{
+    uint32 FramesCount = 0;
+    uint64 DrawsCount = 0;
+    uint64 ValidationErrors = 0;
+    uint32 SteadyFramesCount = 0; // Frames after warmup.
+    uint64 SteadyHeapAllocationsCount = 0; // Engine heap allocations made in steady frames, expected to be 0.
+};
+
+///
+/// Run engine without window and GPU using null render backend. Scene saved at scenePath (if not empty) is loaded after initEngineCallback,
+/// then framesCount frames are run as fast as possible. Frame timings and render stats are printed to stdout.
+///
+KIOTO_API HeadlessRunResult KiotoHeadlessMain(const std::string& scenePath, uint32 framesCount, std::function<void()> initEngineCallback = nullptr, std::function<void()> shutdownEngineCallback = nullptr);
+
 ///
 /// Set scene to engine.
 ///
@@ -56,10 +74,10 @@ struct ApplicationInfoData
 };
 
 void Init();
-void Update();
+KIOTO_API void Update();
 void Shutdown();
 void ChangeFullscreenMode(bool fullScreen);
 void Resize(uint16 width, uint16 height, bool minimized);
-Kioto::RenderOptions& GetRenderSettings();
+KIOTO_API Kioto::RenderOptions& GetRenderSettings();
 }
 }
\ No newline at end of file
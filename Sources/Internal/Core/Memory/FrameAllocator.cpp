@@ -0,0 +1,182 @@
+#include "stdafx.h"
+
+#include "Core/Memory/FrameAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace Kioto::FrameAllocator
+{
+namespace
+{
+static constexpr size_t SubArenaSize = 64 * 1024;
+static constexpr size_t MaxSubArenaAllocationSize = SubArenaSize / 4;
+static constexpr size_t ArenaAlignment = 64;
+
+///
+/// Header at the start of a heap block allocated on arena overflow. Blocks form an intrusive list, so keeping them doesn't allocate.
+///
+struct OverflowBlock
+{
+    OverflowBlock* Next = nullptr;
+};
+
+struct Arena
+{
+    byte* Memory = nullptr;
+    size_t Size = 0;
+    std::atomic<size_t> Offset = 0; // Grows past Size when arena overflows, so after the frame it holds the peak usage.
+    std::mutex OverflowMutex;
+    OverflowBlock* OverflowBlocks = nullptr;
+};
+
+///
+/// Part of the current arena owned by one thread, refilled from the arena with one atomic operation.
+///
+struct ThreadArena
+{
+    uint64 FrameIndex = (std::numeric_limits<uint64>::max)();
+    byte* Current = nullptr;
+    byte* End = nullptr;
+};
+
+std::vector<std::unique_ptr<Arena>> Arenas;
+Arena* CurrentArena = nullptr;
+uint64 CurrentFrameIndex = 0; // Never reset, so thread arenas left from previous Init are always outdated.
+std::atomic<uint64> HeapAllocationsCount = 0;
+
+thread_local ThreadArena LocalArena;
+
+byte* AlignUp(byte* p, size_t alignment)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<byte*>((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+}
+
+byte* AllocateHeapBlock(size_t size)
+{
+    ++HeapAllocationsCount;
+    return static_cast<byte*>(::operator new(size, std::align_val_t(ArenaAlignment)));
+}
+
+void FreeHeapBlock(byte* block)
+{
+    ::operator delete(block, std::align_val_t(ArenaAlignment));
+}
+
+byte* AllocateFromArena(Arena& arena, size_t size, size_t alignment)
+{
+    // Reserve worst case padding, so result can be aligned inside of the reserved range without CAS loop.
+    size_t reserved = size + alignment - 1;
+    size_t offset = arena.Offset.fetch_add(reserved, std::memory_order_relaxed);
+    if (offset + reserved <= arena.Size)
+        return AlignUp(arena.Memory + offset, alignment);
+
+    std::lock_guard<std::mutex> lock(arena.OverflowMutex);
+    byte* block = AllocateHeapBlock(ArenaAlignment + reserved);
+    OverflowBlock* header = new (block) OverflowBlock{ arena.OverflowBlocks };
+    arena.OverflowBlocks = header;
+    return AlignUp(block + ArenaAlignment, alignment);
+}
+
+void FreeOverflowBlocks(Arena& arena)
+{
+    while (arena.OverflowBlocks != nullptr)
+    {
+        OverflowBlock* next = arena.OverflowBlocks->Next;
+        FreeHeapBlock(reinterpret_cast<byte*>(arena.OverflowBlocks));
+        arena.OverflowBlocks = next;
+    }
+}
+
+void ResetArena(Arena& arena)
+{
+    size_t peak = arena.Offset.load(std::memory_order_relaxed);
+    if (peak > arena.Size)
+    {
+        FreeOverflowBlocks(arena);
+
+        FreeHeapBlock(arena.Memory);
+        arena.Size = peak + peak / 2;
+        arena.Memory = AllocateHeapBlock(arena.Size);
+    }
+    arena.Offset.store(0, std::memory_order_relaxed);
+}
+}
+
+void Init(size_t frameSize, uint32 framesCount)
+{
+    assert(Arenas.empty());
+    assert(framesCount > 0);
+    for (uint32 i = 0; i < framesCount; ++i)
+    {
+        auto arena = std::make_unique<Arena>();
+        arena->Size = (std::max)(frameSize, SubArenaSize);
+        arena->Memory = AllocateHeapBlock(arena->Size);
+        Arenas.push_back(std::move(arena));
+    }
+    CurrentArena = Arenas[++CurrentFrameIndex % Arenas.size()].get();
+}
+
+void Shutdown()
+{
+    for (auto& arena : Arenas)
+    {
+        FreeOverflowBlocks(*arena);
+        FreeHeapBlock(arena->Memory);
+    }
+    Arenas.clear();
+    CurrentArena = nullptr;
+    ++CurrentFrameIndex;
+}
+
+void BeginFrame()
+{
+    assert(CurrentArena != nullptr && "FrameAllocator is not initialized");
+    CurrentArena = Arenas[++CurrentFrameIndex % Arenas.size()].get();
+    ResetArena(*CurrentArena);
+}
+
+void* Allocate(size_t size, size_t alignment)
+{
+    assert(CurrentArena != nullptr && "FrameAllocator is not initialized");
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    if (size > MaxSubArenaAllocationSize)
+        return AllocateFromArena(*CurrentArena, size, alignment);
+
+    ThreadArena& local = LocalArena;
+    if (local.FrameIndex == CurrentFrameIndex)
+    {
+        byte* res = AlignUp(local.Current, alignment);
+        if (res + size <= local.End)
+        {
+            local.Current = res + size;
+            return res;
+        }
+    }
+
+    byte* subArena = AllocateFromArena(*CurrentArena, SubArenaSize, ArenaAlignment);
+    local.FrameIndex = CurrentFrameIndex;
+    local.Current = AlignUp(subArena, alignment) + size;
+    local.End = subArena + SubArenaSize;
+    return local.Current - size;
+}
+
+uint64 GetFrameIndex()
+{
+    return CurrentFrameIndex;
+}
+
+uint64 GetHeapAllocationsCount()
+{
+    return HeapAllocationsCount.load(std::memory_order_relaxed);
+}
+
+size_t GetFrameUsedSize()
+{
+    return CurrentArena != nullptr ? CurrentArena->Offset.load(std::memory_order_relaxed) : 0;
+}
+}
\ No newline at end of file
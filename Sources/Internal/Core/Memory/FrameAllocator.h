@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Core.h"
+#include "Core/CoreTypes.h"
+
+///
+/// Linear allocator for transient data which lives no longer than a frame. Every frame has its own arena, arenas are reused in a ring
+/// of FramesCount frames, so memory allocated in frame N stays valid until frame N + FramesCount begins.
+/// Allocation is a pointer bump in thread local sub-arena, freeing is a no-op: whole arena is reset at once in BeginFrame.
+/// If arena overflows, the rest of the frame falls back to heap blocks and the arena grows to the peak on its next reset,
+/// so steady state frames don't touch the general purpose heap.
+///
+namespace Kioto::FrameAllocator
+{
+static constexpr uint32 DefaultFramesCount = 3;
+static constexpr size_t DefaultFrameSize = 4 * 1024 * 1024;
+
+///
+/// Allocate arenas. Must be called before any frame allocation.
+///
+KIOTO_API void Init(size_t frameSize = DefaultFrameSize, uint32 framesCount = DefaultFramesCount);
+///
+/// Release all arenas. Frame memory must not be used after.
+///
+KIOTO_API void Shutdown();
+///
+/// Switch to the next arena and reset it. Must be called from the main thread when no jobs allocate frame memory.
+///
+KIOTO_API void BeginFrame();
+///
+/// Get memory valid until the same arena is reset. Thread safe.
+///
+KIOTO_API void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+///
+/// Get index of the current frame. Increments in every BeginFrame.
+///
+KIOTO_API uint64 GetFrameIndex();
+///
+/// Get count of heap allocations made by the allocator itself since Init. Doesn't change during steady state frames.
+///
+KIOTO_API uint64 GetHeapAllocationsCount();
+///
+/// Get bytes allocated in the current frame.
+///
+KIOTO_API size_t GetFrameUsedSize();
+
+///
+/// Construct object in frame memory. Destructor is never called, so T should not own anything outside of frame memory.
+///
+template <typename T, typename... Args>
+T* New(Args&&... args);
+
+///
+/// Allocate array of default constructed T in frame memory.
+///
+template <typename T>
+T* NewArray(size_t count);
+
+///
+/// Copy zero terminated string to frame memory.
+///
+const char* CopyString(const std::string& str);
+
+template <typename T, typename... Args>
+inline T* New(Args&&... args)
+{
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+inline T* NewArray(size_t count)
+{
+    T* res = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    if constexpr (!std::is_trivially_default_constructible_v<T>)
+    {
+        for (size_t i = 0; i < count; ++i)
+            new (res + i) T();
+    }
+    return res;
+}
+
+inline const char* CopyString(const std::string& str)
+{
+    char* res = static_cast<char*>(Allocate(str.size() + 1, 1));
+    memcpy(res, str.c_str(), str.size() + 1);
+    return res;
+}
+}
+
+namespace Kioto
+{
+///
+/// STL allocator over the frame allocator. Stateless, deallocate is a no-op.
+/// Container using it must be created and destroyed inside the frames window of the arena it allocates from.
+///
+template <typename T>
+class FrameStlAllocator
+{
+public:
+    using value_type = T;
+
+    FrameStlAllocator() = default;
+    template <typename U>
+    FrameStlAllocator(const FrameStlAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(FrameAllocator::Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept
+    {
+    }
+
+    template <typename U>
+    bool operator==(const FrameStlAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const FrameStlAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
\ No newline at end of file
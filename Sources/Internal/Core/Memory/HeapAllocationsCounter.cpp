@@ -0,0 +1,169 @@
+#include "stdafx.h"
+
+#include "Core/Memory/HeapAllocationsCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Kioto::HeapAllocationsCounter
+{
+namespace
+{
+std::atomic<uint64> Count = 0;
+
+void* AllocateCounted(size_t size)
+{
+    Count.fetch_add(1, std::memory_order_relaxed);
+    void* res = std::malloc(size > 0 ? size : 1);
+    if (res == nullptr)
+        throw std::bad_alloc();
+    return res;
+}
+
+void* AllocateCountedAligned(size_t size, std::align_val_t alignment)
+{
+    Count.fetch_add(1, std::memory_order_relaxed);
+    size = size > 0 ? size : 1;
+#if _WIN32 || _WIN64
+    void* res = _aligned_malloc(size, static_cast<size_t>(alignment));
+#else
+    size_t align = static_cast<size_t>(alignment);
+    void* res = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    if (res == nullptr)
+        throw std::bad_alloc();
+    return res;
+}
+
+void FreeCountedAligned(void* p)
+{
+#if _WIN32 || _WIN64
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+}
+
+uint64 GetCount()
+{
+    return Count.load(std::memory_order_relaxed);
+}
+}
+
+using namespace Kioto::HeapAllocationsCounter;
+
+void* operator new(size_t size)
+{
+    return AllocateCounted(size);
+}
+
+void* operator new[](size_t size)
+{
+    return AllocateCounted(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return AllocateCounted(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return AllocateCountedAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return AllocateCountedAligned(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return AllocateCountedAligned(size, alignment);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    FreeCountedAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    FreeCountedAligned(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    FreeCountedAligned(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+    FreeCountedAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    FreeCountedAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    FreeCountedAligned(p);
+}
\ No newline at end of file
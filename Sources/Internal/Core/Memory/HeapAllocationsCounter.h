@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/CoreTypes.h"
+
+///
+/// Counter of general purpose heap allocations. Engine replaces global operator new and delete with versions which count every call
+/// of operator new, so the count covers all allocations made by engine code, including STL containers and std::string.
+/// Allocations made by other modules with their own operator new (e.g. the executable) are not counted.
+///
+namespace Kioto::HeapAllocationsCounter
+{
+///
+/// Get count of operator new calls in the engine since process start. Thread safe.
+///
+KIOTO_API uint64 GetCount();
+}
\ No newline at end of file
@@ -16,12 +16,24 @@
 
 namespace Kioto
 {
+namespace
+{
+uint32 UsedSceneIndices = 0; // Bit per index of live scenes.
+}
+
 Scene::Scene(std::string name)
     : m_name(name)
 {
+    uint32 freeIndices = ~UsedSceneIndices & ((1u << ComponentPoolBase::MaxScenesCount) - 1);
+    if (freeIndices == 0)
+        throw "Too many live scenes, component pools keep active masks of ComponentPoolBase::MaxScenesCount scenes.";
+    m_index = FirstSetBit(freeIndices);
+    UsedSceneIndices |= 1u << m_index;
+
     // [a_vorontcov] 64 systems are enough for everyone.
     m_systems.reserve(64);
     m_entities.reserve(512);
+    m_entitySlots.reserve(512);
 }
 
 Scene::~Scene()
@@ -36,14 +48,17 @@ Scene::~Scene()
     for (auto entity : m_entities)
         SafeDelete(entity);
     m_entities.clear();
+    m_entitySlots.clear();
+    m_freeEntitySlots.clear();
+    UsedSceneIndices &= ~(1u << m_index);
 }
 
 void Scene::Init()
 {
     EventSystem::GlobalEventSystem.Clear();
 
-    TransformSystem* transformSystem = new TransformSystem();
-    AddSystemInternal(transformSystem);
+    m_transformSystem = new TransformSystem();
+    AddSystemInternal(m_transformSystem);
     m_cameraSystem = new CameraSystem();
     AddSystemInternal(m_cameraSystem);
     m_renderSystem = new RenderSystem();
@@ -57,8 +72,12 @@ void Scene::Init()
 
 void Scene::Update(float32 dt)
 {
-    for (auto system : m_systems)
-        system->Update(GlobalTimer::GetDeltaTime());
+    if (m_isScheduleDirty)
+    {
+        m_scheduler.Build(m_systems);
+        m_isScheduleDirty = false;
+    }
+    m_scheduler.Update(GlobalTimer::GetDeltaTime());
     m_renderSystem->Draw();
 }
 
@@ -70,6 +89,7 @@ void Scene::Shutdown()
         SafeDelete(system);
     }
     m_systems.clear();
+    m_isScheduleDirty = true;
     OutputDebugStringA("Shutdown scene");
 }
 
@@ -85,27 +105,81 @@ void Scene::RemoveSystem(SceneSystem* system)
     if (it != m_systems.end())
     {
         (*it)->Shutdown();
-        delete &(*it);
+        delete *it;
         m_systems.erase(it);
+        m_isScheduleDirty = true;
     }
 }
 
-void Scene::AddEntity(Entity* entity)
+EntityId Scene::AddEntity(Entity* entity)
 {
+    assert(!entity->m_id.GetIsValid());
+
+    uint32 index = 0;
+    if (m_freeEntitySlots.empty())
+    {
+        index = static_cast<uint32>(m_entitySlots.size());
+        m_entitySlots.emplace_back();
+    }
+    else
+    {
+        index = m_freeEntitySlots.back();
+        m_freeEntitySlots.pop_back();
+    }
+
+    EntitySlot& slot = m_entitySlots[index];
+    slot.Instance = entity;
+    slot.DenseIndex = static_cast<uint32>(m_entities.size());
     m_entities.push_back(entity);
+    entity->m_id = { index, slot.Generation };
+
+    SetComponentsActive(entity, true);
     for (auto system : m_systems)
         system->OnEntityAdd(entity);
+    return entity->m_id;
 }
 
 void Scene::RemoveEntity(Entity* entity)
 {
-    auto it = std::find(m_entities.begin(), m_entities.end(), entity);
-    if (it != m_entities.end())
+    if (GetEntity(entity->m_id) != entity)
     {
-        m_entities.erase(it);
-        for (auto system : m_systems)
-            system->OnEntityAdd(entity);
+        assert(false && "Entity is not owned by the scene");
+        return;
     }
+    RemoveEntity(entity->m_id);
+}
+
+Entity* Scene::RemoveEntity(EntityId id)
+{
+    Entity* entity = GetEntity(id);
+    if (entity == nullptr)
+        return nullptr;
+
+    for (auto system : m_systems)
+        system->OnEntityRemove(entity);
+    SetComponentsActive(entity, false);
+
+    EntitySlot& slot = m_entitySlots[id.Index];
+    Entity* last = m_entities.back();
+    m_entities[slot.DenseIndex] = last;
+    m_entitySlots[last->m_id.Index].DenseIndex = slot.DenseIndex;
+    m_entities.pop_back();
+
+    slot.Instance = nullptr;
+    ++slot.Generation;
+    m_freeEntitySlots.push_back(id.Index);
+    entity->m_id = {};
+    return entity;
+}
+
+Entity* Scene::GetEntity(EntityId id) const
+{
+    if (id.Index >= m_entitySlots.size())
+        return nullptr;
+    const EntitySlot& slot = m_entitySlots[id.Index];
+    if (slot.Generation != id.Generation)
+        return nullptr;
+    return slot.Instance;
 }
 
 Entity* Scene::FindEntity(const std::string& name) const
@@ -120,7 +194,23 @@ Entity* Scene::FindEntity(const std::string& name) const
 
 void Scene::AddSystemInternal(SceneSystem* system)
 {
+    system->m_sceneIndex = m_index;
     m_systems.push_back(system);
+    m_isScheduleDirty = true;
+}
+
+void Scene::SetComponentsActive(Entity* entity, bool active) const
+{
+    for (auto component : entity->GetComponents())
+    {
+        if (component->GetPool() != nullptr)
+            ComponentPoolBase::SetActive(component, m_index, active);
+    }
+}
+
+void Scene::SetIsSerialUpdate(bool isSerial)
+{
+    m_scheduler.SetIsSerial(isSerial);
 }
 
 void Scene::Serialize(YAML::Emitter& out) const
@@ -7,6 +7,7 @@
 
 #include "Core/Core.h"
 #include "Core/CoreTypes.h"
+#include "Core/ECS/SystemScheduler.h"
 
 #include <vector>
 
@@ -22,9 +23,12 @@ class SceneSystem;
 class Entity;
 class CameraSystem;
 class RenderSystem;
+class TransformSystem;
 class EventSystem;
 class LightSystem;
 
+struct EntityId;
+
 class Scene
 {
 public:
@@ -92,22 +96,62 @@ public:
     ///
     const std::vector<SceneSystem*>& GetSystems() const;
 
-    KIOTO_API void AddEntity(Entity* entity);
+    ///
+    /// Update systems one by one in registration order on the main thread instead of updating independent systems concurrently.
+    ///
+    KIOTO_API void SetIsSerialUpdate(bool isSerial);
+
+    ///
+    /// Add entity to scene. Scene takes ownership of the entity. Returns entity handle.
+    ///
+    KIOTO_API EntityId AddEntity(Entity* entity);
+    ///
+    /// Remove entity from scene. Ownership is returned to the caller. Entities of other scenes are ignored.
+    ///
     KIOTO_API void RemoveEntity(Entity* entity);
+    ///
+    /// Remove entity by handle. Stale handles are ignored. Returns removed entity, ownership is returned to the caller.
+    ///
+    KIOTO_API Entity* RemoveEntity(EntityId id);
+    ///
+    /// Get entity by handle. Returns nullptr if handle is stale.
+    ///
+    KIOTO_API Entity* GetEntity(EntityId id) const;
     KIOTO_API Entity* FindEntity(const std::string& name) const;
 
     KIOTO_API const CameraSystem* GetCameraSystem() const;
+    const TransformSystem* GetTransformSystem() const;
+    RenderSystem* GetRenderSystem() const;
+
+    ///
+    /// Get index of the scene in component pools, unique among live scenes.
+    ///
+    uint32 GetIndex() const;
 
     void Serialize(YAML::Emitter& out) const;
     void Deserialize(const YAML::Node& in);
 
 private:
+    struct EntitySlot
+    {
+        Entity* Instance = nullptr;
+        uint32 Generation = 0;
+        uint32 DenseIndex = 0;
+    };
+
     void AddSystemInternal(SceneSystem* system);
+    void SetComponentsActive(Entity* entity, bool active) const;
 
     std::vector<SceneSystem*> m_systems; // [a_vorontcov] TODO: linked list in custom arena? Also, maybe updatable system or smth like that, to not call useless update.
-    std::vector<Entity*> m_entities; // [a_vorontcov] Same as above.
+    std::vector<Entity*> m_entities; // Dense list of scene entities, removal is swap and pop.
+    std::vector<EntitySlot> m_entitySlots;
+    std::vector<uint32> m_freeEntitySlots;
+    TransformSystem* m_transformSystem = nullptr;
     CameraSystem* m_cameraSystem = nullptr;
     RenderSystem* m_renderSystem = nullptr;
+    SystemScheduler m_scheduler;
+    bool m_isScheduleDirty = true;
+    uint32 m_index = 0;
 
     std::string m_name = "";
 };
@@ -118,7 +162,11 @@ bool Scene::AddSystemBefore(SceneSystem* system)
     std::vector<SceneSystem*>::const_iterator* it = nullptr;
     bool success = FindSystem<T>(it);
     if (success)
+    {
+        system->m_sceneIndex = m_index;
         m_systems.insert(it, system);
+        m_isScheduleDirty = true;
+    }
     return success;
 }
 
@@ -128,20 +176,20 @@ bool Scene::AddSystemAfter(SceneSystem* system)
     std::vector<SceneSystem*>::const_iterator* it = nullptr;
     bool success = FindSystem<T>(it);
     if (success)
+    {
+        system->m_sceneIndex = m_index;
         m_systems.insert(it + 1, system);
+        m_isScheduleDirty = true;
+    }
     return success;
 }
 
 template <typename T, typename>
 void Scene::RemoveSystem()
 {
-    std::vector<SceneSystem*>::const_iterator* it = nullptr;
-    bool success = FindSystem<T>(it);
-    if (success)
-    {
-        delete &(*it);
-        m_systems.erase(it);
-    }
+    auto it = std::find_if(m_systems.begin(), m_systems.end(), [](SceneSystem* system) { return dynamic_cast<T*>(system) != nullptr; });
+    if (it != m_systems.end())
+        RemoveSystem(*it);
 }
 
 template <typename T, typename U, typename>
@@ -169,4 +217,19 @@ inline const CameraSystem* Scene::GetCameraSystem() const
 {
     return m_cameraSystem;
 }
+
+inline const TransformSystem* Scene::GetTransformSystem() const
+{
+    return m_transformSystem;
+}
+
+inline RenderSystem* Scene::GetRenderSystem() const
+{
+    return m_renderSystem;
+}
+
+inline uint32 Scene::GetIndex() const
+{
+    return m_index;
+}
 }
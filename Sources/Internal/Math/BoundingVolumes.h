@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Core/CoreTypes.h"
+#include "Math/Matrix4.h"
+#include "Math/Vector3.h"
+#include "Math/Vector4.h"
+
+namespace Kioto
+{
+///
+/// Axis aligned bounding box.
+///
+struct BoundingBox
+{
+    Vector3 Min;
+    Vector3 Max;
+
+    Vector3 GetCenter() const;
+    Vector3 GetExtents() const;
+    ///
+    /// Get area of box surface, cost metric of bounding volume hierarchies.
+    ///
+    float32 GetSurfaceArea() const;
+
+    bool Contains(const BoundingBox& other) const;
+    bool Intersects(const BoundingBox& other) const;
+    bool Intersects(const Vector3& sphereCenter, float32 sphereRadius) const;
+    ///
+    /// Slab test of the ray origin + t * direction, 0 <= t <= maxDistance. invDirection is 1 / direction per component.
+    /// Returns distance to the box entry in distance, 0 if origin is inside.
+    ///
+    bool IntersectsRay(const Vector3& origin, const Vector3& invDirection, float32 maxDistance, float32& distance) const;
+
+    ///
+    /// Box enclosing this box transformed by affine matrix m.
+    ///
+    BoundingBox Transformed(const Matrix4& m) const;
+
+    ///
+    /// Box enclosing count points. Stride is in bytes, so positions may be read in place from interleaved vertex buffer.
+    ///
+    static BoundingBox FromPoints(const Vector3* points, uint32 stride, uint32 count);
+    static BoundingBox Union(const BoundingBox& a, const BoundingBox& b);
+};
+
+///
+/// Bounding sphere, cheaper than box to transform and test, so it is used for culling.
+///
+struct BoundingSphere
+{
+    Vector3 Center;
+    float32 Radius = 0.0f;
+
+    ///
+    /// Sphere enclosing this sphere transformed by affine matrix m. Radius is scaled by the largest axis scale.
+    ///
+    BoundingSphere Transformed(const Matrix4& m) const;
+
+    ///
+    /// Sphere with the given center enclosing count points. Stride is in bytes.
+    ///
+    static BoundingSphere FromPoints(const Vector3* points, uint32 stride, uint32 count, const Vector3& center);
+};
+
+inline Vector3 BoundingBox::GetCenter() const
+{
+    return { (Min.x + Max.x) * 0.5f, (Min.y + Max.y) * 0.5f, (Min.z + Max.z) * 0.5f };
+}
+
+inline Vector3 BoundingBox::GetExtents() const
+{
+    return { (Max.x - Min.x) * 0.5f, (Max.y - Min.y) * 0.5f, (Max.z - Min.z) * 0.5f };
+}
+
+inline float32 BoundingBox::GetSurfaceArea() const
+{
+    float32 x = Max.x - Min.x;
+    float32 y = Max.y - Min.y;
+    float32 z = Max.z - Min.z;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+inline bool BoundingBox::Contains(const BoundingBox& other) const
+{
+    return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z
+        && other.Max.x <= Max.x && other.Max.y <= Max.y && other.Max.z <= Max.z;
+}
+
+inline bool BoundingBox::Intersects(const BoundingBox& other) const
+{
+    return Min.x <= other.Max.x && Min.y <= other.Max.y && Min.z <= other.Max.z
+        && other.Min.x <= Max.x && other.Min.y <= Max.y && other.Min.z <= Max.z;
+}
+
+inline bool BoundingBox::Intersects(const Vector3& sphereCenter, float32 sphereRadius) const
+{
+    Vector3 closest(std::clamp(sphereCenter.x, Min.x, Max.x), std::clamp(sphereCenter.y, Min.y, Max.y), std::clamp(sphereCenter.z, Min.z, Max.z));
+    return (closest - sphereCenter).SqrLength() <= sphereRadius * sphereRadius;
+}
+
+inline bool BoundingBox::IntersectsRay(const Vector3& origin, const Vector3& invDirection, float32 maxDistance, float32& distance) const
+{
+    float32 tMin = 0.0f;
+    float32 tMax = maxDistance;
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        float32 t0 = (Min.data[axis] - origin.data[axis]) * invDirection.data[axis];
+        float32 t1 = (Max.data[axis] - origin.data[axis]) * invDirection.data[axis];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = (std::max)(tMin, t0);
+        tMax = (std::min)(tMax, t1);
+        if (tMin > tMax)
+            return false;
+    }
+    distance = tMin;
+    return true;
+}
+
+inline BoundingBox BoundingBox::Union(const BoundingBox& a, const BoundingBox& b)
+{
+    BoundingBox res;
+    res.Min = { (std::min)(a.Min.x, b.Min.x), (std::min)(a.Min.y, b.Min.y), (std::min)(a.Min.z, b.Min.z) };
+    res.Max = { (std::max)(a.Max.x, b.Max.x), (std::max)(a.Max.y, b.Max.y), (std::max)(a.Max.z, b.Max.z) };
+    return res;
+}
+
+inline BoundingBox BoundingBox::Transformed(const Matrix4& m) const
+{
+    // Extents of the new box are extents projected to world axes: |m| * extents.
+    Vector3 center = (Vector4(GetCenter(), 1.0f) * m).GetVec3();
+    Vector3 extents = GetExtents();
+    Vector3 newExtents(
+        std::abs(m._00) * extents.x + std::abs(m._10) * extents.y + std::abs(m._20) * extents.z,
+        std::abs(m._01) * extents.x + std::abs(m._11) * extents.y + std::abs(m._21) * extents.z,
+        std::abs(m._02) * extents.x + std::abs(m._12) * extents.y + std::abs(m._22) * extents.z);
+
+    BoundingBox res;
+    res.Min = { center.x - newExtents.x, center.y - newExtents.y, center.z - newExtents.z };
+    res.Max = { center.x + newExtents.x, center.y + newExtents.y, center.z + newExtents.z };
+    return res;
+}
+
+inline BoundingBox BoundingBox::FromPoints(const Vector3* points, uint32 stride, uint32 count)
+{
+    BoundingBox res;
+    if (count == 0)
+        return res;
+
+    res.Min = *points;
+    res.Max = *points;
+    const byte* p = reinterpret_cast<const byte*>(points);
+    for (uint32 i = 1; i < count; ++i)
+    {
+        p += stride;
+        const Vector3& point = *reinterpret_cast<const Vector3*>(p);
+        res.Min = { (std::min)(res.Min.x, point.x), (std::min)(res.Min.y, point.y), (std::min)(res.Min.z, point.z) };
+        res.Max = { (std::max)(res.Max.x, point.x), (std::max)(res.Max.y, point.y), (std::max)(res.Max.z, point.z) };
+    }
+    return res;
+}
+
+inline BoundingSphere BoundingSphere::Transformed(const Matrix4& m) const
+{
+    float32 sqrScale = (std::max)({ Vector3(m._00, m._01, m._02).SqrLength(), Vector3(m._10, m._11, m._12).SqrLength(), Vector3(m._20, m._21, m._22).SqrLength() });
+
+    BoundingSphere res;
+    res.Center = (Vector4(Center, 1.0f) * m).GetVec3();
+    res.Radius = Radius * std::sqrt(sqrScale);
+    return res;
+}
+
+inline BoundingSphere BoundingSphere::FromPoints(const Vector3* points, uint32 stride, uint32 count, const Vector3& center)
+{
+    float32 sqrRadius = 0.0f;
+    const byte* p = reinterpret_cast<const byte*>(points);
+    for (uint32 i = 0; i < count; ++i, p += stride)
+    {
+        const Vector3& point = *reinterpret_cast<const Vector3*>(p);
+        sqrRadius = (std::max)(sqrRadius, (point - center).SqrLength());
+    }
+
+    BoundingSphere res;
+    res.Center = center;
+    res.Radius = std::sqrt(sqrRadius);
+    return res;
+}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cmath>
+
+#include "Core/CoreTypes.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Matrix4.h"
+#include "Math/Vector4.h"
+
+namespace Kioto
+{
+///
+/// Six planes bounding camera view volume. Plane is (normal, d) with normalized normal pointing inside, point p is inside the plane
+/// if dot(normal, p) + d >= 0.
+///
+struct Frustum
+{
+    enum ePlane
+    {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlanesCount
+    };
+
+    Vector4 Planes[PlanesCount];
+
+    ///
+    /// Extract world space planes from (view * projection) matrix. Row vector convention and [0, 1] clip depth as in Matrix4::BuildProjectionFov.
+    ///
+    static Frustum FromViewProjection(const Matrix4& vp);
+
+    bool Intersects(const BoundingSphere& sphere) const;
+    bool Intersects(const BoundingBox& box) const;
+    ///
+    /// Get if box is completely inside, so that everything in it is inside as well.
+    ///
+    bool Contains(const BoundingBox& box) const;
+};
+
+inline Frustum Frustum::FromViewProjection(const Matrix4& vp)
+{
+    // clip = (p, 1) * vp, so clip component i is dot with column i. Inside is -w <= x <= w, -w <= y <= w, 0 <= z <= w.
+    Vector4 col0(vp._00, vp._10, vp._20, vp._30);
+    Vector4 col1(vp._01, vp._11, vp._21, vp._31);
+    Vector4 col2(vp._02, vp._12, vp._22, vp._32);
+    Vector4 col3(vp._03, vp._13, vp._23, vp._33);
+
+    auto makePlane = [](const Vector4& a, const Vector4& b, float32 sign)
+    {
+        Vector4 plane(a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z, a.w + sign * b.w);
+        float32 invLength = 1.0f / std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        return Vector4(plane.x * invLength, plane.y * invLength, plane.z * invLength, plane.w * invLength);
+    };
+
+    Frustum res;
+    res.Planes[Left] = makePlane(col3, col0, 1.0f);
+    res.Planes[Right] = makePlane(col3, col0, -1.0f);
+    res.Planes[Bottom] = makePlane(col3, col1, 1.0f);
+    res.Planes[Top] = makePlane(col3, col1, -1.0f);
+    res.Planes[Near] = makePlane(col2, col2, 0.0f);
+    res.Planes[Far] = makePlane(col3, col2, -1.0f);
+    return res;
+}
+
+inline bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+    for (const Vector4& plane : Planes)
+    {
+        if (plane.x * sphere.Center.x + plane.y * sphere.Center.y + plane.z * sphere.Center.z + plane.w < -sphere.Radius)
+            return false;
+    }
+    return true;
+}
+
+inline bool Frustum::Intersects(const BoundingBox& box) const
+{
+    // Box is outside if its corner farthest along the plane normal is outside.
+    for (const Vector4& plane : Planes)
+    {
+        float32 x = plane.x >= 0.0f ? box.Max.x : box.Min.x;
+        float32 y = plane.y >= 0.0f ? box.Max.y : box.Min.y;
+        float32 z = plane.z >= 0.0f ? box.Max.z : box.Min.z;
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+inline bool Frustum::Contains(const BoundingBox& box) const
+{
+    // Box is inside if its corner nearest along every plane normal is inside.
+    for (const Vector4& plane : Planes)
+    {
+        float32 x = plane.x >= 0.0f ? box.Min.x : box.Max.x;
+        float32 y = plane.y >= 0.0f ? box.Min.y : box.Max.y;
+        float32 z = plane.z >= 0.0f ? box.Min.z : box.Max.z;
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+}
\ No newline at end of file
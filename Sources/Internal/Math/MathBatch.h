@@ -0,0 +1,331 @@
+#pragma once
+
+#include "Core/CoreTypes.h"
+#include "Math/MathSimd.h"
+#include "Math/Matrix4.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+#include "Math/Vector4.h"
+
+///
+/// Kernels which process arrays of vectors and matrices in one call. Matrix rows are loaded once per batch instead of once per element.
+/// Vector strides are in bytes, so positions and normals can be transformed in place inside interleaved vertex buffers.
+/// Unless stated otherwise in and out may be the same array but must not partially overlap.
+///
+namespace Kioto::Math::Batch
+{
+///
+/// out[i] = (in[i], 1) * m. Resulting w is dropped, so use it only for affine matrices.
+///
+void TransformPoints(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count);
+void TransformPoints(const Matrix4& m, const Vector3* in, Vector3* out, uint32 count);
+
+///
+/// out[i] = (in[i], 0) * m. Translation is ignored.
+///
+void TransformDirections(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count);
+
+///
+/// Same as TransformDirections but results are normalized. For matrices with non uniform scale pass inverse transposed matrix.
+///
+void TransformNormals(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count);
+
+///
+/// out[i] = in[i] * m for full 4 component vectors.
+///
+void TransformVectors(const Matrix4& m, const Vector4* in, uint32 inStride, Vector4* out, uint32 outStride, uint32 count);
+
+///
+/// out[i] = a[i] * b[i]. out may be a, but must not be b.
+///
+void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* out, uint32 count);
+
+///
+/// out[i] = a[i] * b. Typical use is to move array of local matrices with common parent to world space.
+///
+void MultiplyMatrices(const Matrix4* a, const Matrix4& b, Matrix4* out, uint32 count);
+
+///
+/// Build scale * rotation * translation matrices, same as BuildScale(s) * q.ToMatrix() with translation set to position.
+///
+void ComposeMatrices(const Vector3* positions, const Quaternion* rotations, const Vector3* scales, Matrix4* out, uint32 count);
+
+///
+/// General inverse of every matrix. Returns false if any of matrices is singular, its output is left untouched.
+///
+bool InverseMatrices(const Matrix4* in, Matrix4* out, uint32 count);
+
+///
+/// Inverse of matrices composed from rotation and translation only.
+///
+void InverseOrthonormMatrices(const Matrix4* in, Matrix4* out, uint32 count);
+
+///
+/// Split strided Vector3 array to separate x, y and z arrays.
+///
+void AosToSoa(const Vector3* in, uint32 inStride, uint32 count, float32* x, float32* y, float32* z);
+
+///
+/// Gather separate x, y and z arrays back to strided Vector3 array.
+///
+void SoaToAos(const float32* x, const float32* y, const float32* z, uint32 count, Vector3* out, uint32 outStride);
+
+///
+/// Transform points stored as separate x, y and z arrays in place. Processes four points per instruction,
+/// so it is the fastest way to transform big point clouds which are already (or may be kept) in SoA form.
+///
+void TransformPointsSoa(const Matrix4& m, float32* x, float32* y, float32* z, uint32 count);
+
+namespace Internal
+{
+template <typename T>
+inline const T* Advance(const T* p, uint32 stride)
+{
+    return reinterpret_cast<const T*>(reinterpret_cast<const byte*>(p) + stride);
+}
+
+template <typename T>
+inline T* Advance(T* p, uint32 stride)
+{
+    return reinterpret_cast<T*>(reinterpret_cast<byte*>(p) + stride);
+}
+
+#if KIOTO_MATH_SSE
+inline __m128 LoadVector3(const Vector3& v)
+{
+    return _mm_setr_ps(v.x, v.y, v.z, 0.0f);
+}
+
+inline void StoreVector3(Vector3& v, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(v.data), value);
+    _mm_store_ss(v.data + 2, _mm_movehl_ps(value, value));
+}
+
+template <bool isPoint, bool isNormalized>
+inline void TransformVector3(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count)
+{
+    using namespace Math::Simd;
+    __m128 r0 = _mm_loadu_ps(m.data);
+    __m128 r1 = _mm_loadu_ps(m.data + 4);
+    __m128 r2 = _mm_loadu_ps(m.data + 8);
+    __m128 r3 = isPoint ? _mm_loadu_ps(m.data + 12) : _mm_setzero_ps();
+    for (uint32 i = 0; i < count; ++i, in = Advance(in, inStride), out = Advance(out, outStride))
+    {
+        __m128 v = LoadVector3(*in);
+        __m128 res = MulAdd(Splat<0>(v), r0, r3);
+        res = MulAdd(Splat<1>(v), r1, res);
+        res = MulAdd(Splat<2>(v), r2, res);
+        if constexpr (isNormalized)
+        {
+            __m128 sq = _mm_mul_ps(res, res);
+            __m128 lenSq = _mm_add_ps(_mm_add_ps(Splat<0>(sq), Splat<1>(sq)), Splat<2>(sq));
+            __m128 isNonZero = _mm_cmpgt_ps(lenSq, _mm_setzero_ps());
+            res = _mm_and_ps(_mm_div_ps(res, _mm_sqrt_ps(lenSq)), isNonZero);
+        }
+        StoreVector3(*out, res);
+    }
+}
+#else
+template <bool isPoint, bool isNormalized>
+inline void TransformVector3(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count)
+{
+    const float32 w = isPoint ? 1.0f : 0.0f;
+    for (uint32 i = 0; i < count; ++i, in = Advance(in, inStride), out = Advance(out, outStride))
+    {
+        Vector4 res = Vector4(*in, w) * m;
+        *out = { res.x, res.y, res.z };
+        if constexpr (isNormalized)
+        {
+            if (out->SqrLength() > 0.0f)
+                out->Normalize();
+        }
+    }
+}
+#endif
+}
+
+inline void TransformPoints(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count)
+{
+    Internal::TransformVector3<true, false>(m, in, inStride, out, outStride, count);
+}
+
+inline void TransformPoints(const Matrix4& m, const Vector3* in, Vector3* out, uint32 count)
+{
+    Internal::TransformVector3<true, false>(m, in, sizeof(Vector3), out, sizeof(Vector3), count);
+}
+
+inline void TransformDirections(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count)
+{
+    Internal::TransformVector3<false, false>(m, in, inStride, out, outStride, count);
+}
+
+inline void TransformNormals(const Matrix4& m, const Vector3* in, uint32 inStride, Vector3* out, uint32 outStride, uint32 count)
+{
+    Internal::TransformVector3<false, true>(m, in, inStride, out, outStride, count);
+}
+
+inline void TransformVectors(const Matrix4& m, const Vector4* in, uint32 inStride, Vector4* out, uint32 outStride, uint32 count)
+{
+#if KIOTO_MATH_SSE
+    using namespace Math::Simd;
+    __m128 r0 = _mm_loadu_ps(m.data);
+    __m128 r1 = _mm_loadu_ps(m.data + 4);
+    __m128 r2 = _mm_loadu_ps(m.data + 8);
+    __m128 r3 = _mm_loadu_ps(m.data + 12);
+    for (uint32 i = 0; i < count; ++i, in = Internal::Advance(in, inStride), out = Internal::Advance(out, outStride))
+        _mm_storeu_ps(out->data, TransformRow(_mm_loadu_ps(in->data), r0, r1, r2, r3));
+#else
+    for (uint32 i = 0; i < count; ++i, in = Internal::Advance(in, inStride), out = Internal::Advance(out, outStride))
+        *out = *in * m;
+#endif
+}
+
+inline void MultiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* out, uint32 count)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        assert(out + i != b + i);
+        if (out + i != a + i)
+            out[i] = a[i];
+        out[i] *= b[i];
+    }
+}
+
+inline void MultiplyMatrices(const Matrix4* a, const Matrix4& b, Matrix4* out, uint32 count)
+{
+#if KIOTO_MATH_SSE
+    using namespace Math::Simd;
+    __m128 r0 = _mm_loadu_ps(b.data);
+    __m128 r1 = _mm_loadu_ps(b.data + 4);
+    __m128 r2 = _mm_loadu_ps(b.data + 8);
+    __m128 r3 = _mm_loadu_ps(b.data + 12);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        for (int32 row = 0; row < 4; ++row)
+            _mm_storeu_ps(out[i].data + row * 4, TransformRow(_mm_loadu_ps(a[i].data + row * 4), r0, r1, r2, r3));
+    }
+#else
+    for (uint32 i = 0; i < count; ++i)
+        out[i] = a[i] * b;
+#endif
+}
+
+inline void ComposeMatrices(const Vector3* positions, const Quaternion* rotations, const Vector3* scales, Matrix4* out, uint32 count)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        // Scale matrix is diagonal, so multiplication by it is just scaling of rotation rows.
+        Matrix4 res = rotations[i].ToMatrix();
+#if KIOTO_MATH_SSE
+        _mm_storeu_ps(res.data, _mm_mul_ps(_mm_loadu_ps(res.data), _mm_set1_ps(scales[i].x)));
+        _mm_storeu_ps(res.data + 4, _mm_mul_ps(_mm_loadu_ps(res.data + 4), _mm_set1_ps(scales[i].y)));
+        _mm_storeu_ps(res.data + 8, _mm_mul_ps(_mm_loadu_ps(res.data + 8), _mm_set1_ps(scales[i].z)));
+#else
+        for (int32 col = 0; col < 3; ++col)
+        {
+            res.m[0][col] *= scales[i].x;
+            res.m[1][col] *= scales[i].y;
+            res.m[2][col] *= scales[i].z;
+        }
+#endif
+        res.SetTranslation(positions[i]);
+        out[i] = res;
+    }
+}
+
+inline bool InverseMatrices(const Matrix4* in, Matrix4* out, uint32 count)
+{
+    bool isAllInversed = true;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Matrix4 res;
+        if (in[i].Inversed(res))
+            out[i] = res;
+        else
+            isAllInversed = false;
+    }
+    return isAllInversed;
+}
+
+inline void InverseOrthonormMatrices(const Matrix4* in, Matrix4* out, uint32 count)
+{
+#if KIOTO_MATH_SSE
+    using namespace Math::Simd;
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        __m128 r0 = _mm_and_ps(_mm_loadu_ps(in[i].data), xyzMask);
+        __m128 r1 = _mm_and_ps(_mm_loadu_ps(in[i].data + 4), xyzMask);
+        __m128 r2 = _mm_and_ps(_mm_loadu_ps(in[i].data + 8), xyzMask);
+        __m128 t = _mm_loadu_ps(in[i].data + 12);
+        __m128 r3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        __m128 pos = _mm_mul_ps(Splat<0>(t), r0);
+        pos = MulAdd(Splat<1>(t), r1, pos);
+        pos = MulAdd(Splat<2>(t), r2, pos);
+        pos = _mm_sub_ps(lastRow, pos);
+
+        _mm_storeu_ps(out[i].data, r0);
+        _mm_storeu_ps(out[i].data + 4, r1);
+        _mm_storeu_ps(out[i].data + 8, r2);
+        _mm_storeu_ps(out[i].data + 12, pos);
+    }
+#else
+    for (uint32 i = 0; i < count; ++i)
+        out[i] = in[i].InversedOrthonorm();
+#endif
+}
+
+inline void AosToSoa(const Vector3* in, uint32 inStride, uint32 count, float32* x, float32* y, float32* z)
+{
+    for (uint32 i = 0; i < count; ++i, in = Internal::Advance(in, inStride))
+    {
+        x[i] = in->x;
+        y[i] = in->y;
+        z[i] = in->z;
+    }
+}
+
+inline void SoaToAos(const float32* x, const float32* y, const float32* z, uint32 count, Vector3* out, uint32 outStride)
+{
+    for (uint32 i = 0; i < count; ++i, out = Internal::Advance(out, outStride))
+    {
+        out->x = x[i];
+        out->y = y[i];
+        out->z = z[i];
+    }
+}
+
+inline void TransformPointsSoa(const Matrix4& m, float32* x, float32* y, float32* z, uint32 count)
+{
+    uint32 i = 0;
+#if KIOTO_MATH_SSE
+    using namespace Math::Simd;
+    __m128 m00 = _mm_set1_ps(m._00), m01 = _mm_set1_ps(m._01), m02 = _mm_set1_ps(m._02);
+    __m128 m10 = _mm_set1_ps(m._10), m11 = _mm_set1_ps(m._11), m12 = _mm_set1_ps(m._12);
+    __m128 m20 = _mm_set1_ps(m._20), m21 = _mm_set1_ps(m._21), m22 = _mm_set1_ps(m._22);
+    __m128 m30 = _mm_set1_ps(m._30), m31 = _mm_set1_ps(m._31), m32 = _mm_set1_ps(m._32);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+        _mm_storeu_ps(x + i, MulAdd(vz, m20, MulAdd(vy, m10, MulAdd(vx, m00, m30))));
+        _mm_storeu_ps(y + i, MulAdd(vz, m21, MulAdd(vy, m11, MulAdd(vx, m01, m31))));
+        _mm_storeu_ps(z + i, MulAdd(vz, m22, MulAdd(vy, m12, MulAdd(vx, m02, m32))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float32 px = x[i];
+        float32 py = y[i];
+        float32 pz = z[i];
+        x[i] = px * m._00 + py * m._10 + pz * m._20 + m._30;
+        y[i] = px * m._01 + py * m._11 + pz * m._21 + m._31;
+        z[i] = px * m._02 + py * m._12 + pz * m._22 + m._32;
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+///
+/// Compile time selection of SIMD backend for float math specializations.
+/// SSE2 is always present on x86-64, FMA is used when building with AVX2. Define KIOTO_MATH_NO_SIMD to use scalar templates.
+///
+#if (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)) && !defined(KIOTO_MATH_NO_SIMD)
+#define KIOTO_MATH_SSE 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define KIOTO_MATH_FMA 1
+#include <immintrin.h>
+#else
+#define KIOTO_MATH_FMA 0
+#endif
+#else
+#define KIOTO_MATH_SSE 0
+#define KIOTO_MATH_FMA 0
+#endif
+
+#if KIOTO_MATH_SSE
+namespace Kioto::Math::Simd
+{
+#define KIOTO_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+///
+/// Get (a[x], a[y], b[z], b[w]).
+///
+template <int x, int y, int z, int w>
+inline __m128 Shuffle(__m128 a, __m128 b)
+{
+    return _mm_shuffle_ps(a, b, KIOTO_SHUFFLE_MASK(x, y, z, w));
+}
+
+///
+/// Get (v[x], v[y], v[z], v[w]).
+///
+template <int x, int y, int z, int w>
+inline __m128 Swizzle(__m128 v)
+{
+    return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), KIOTO_SHUFFLE_MASK(x, y, z, w)));
+}
+
+///
+/// Broadcast v[i] to all lanes.
+///
+template <int i>
+inline __m128 Splat(__m128 v)
+{
+    return Swizzle<i, i, i, i>(v);
+}
+
+///
+/// a * b + c.
+///
+inline __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+{
+#if KIOTO_MATH_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+///
+/// Row vector by matrix rows: v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3.
+///
+inline __m128 TransformRow(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+{
+    __m128 res = _mm_mul_ps(Splat<0>(v), r0);
+    res = MulAdd(Splat<1>(v), r1, res);
+    res = MulAdd(Splat<2>(v), r2, res);
+    return MulAdd(Splat<3>(v), r3, res);
+}
+
+#undef KIOTO_SHUFFLE_MASK
+}
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include "Core/CoreTypes.h"
 #include "Math/MathHelpers.h"
+#include "Math/MathSimd.h"
 #include "Math/Vector4.h"
 
 #include <iostream>
@@ -71,6 +72,10 @@ public:
     ///
     /// Inverse of orthonormalized matrix.
     Matrix4_<T> InversedOrthonorm() const;
+    ///
+    /// Inverse of matrix composed from rotation, uniform scale and translation. Much cheaper than general Inversed.
+    ///
+    Matrix4_<T> InversedUniformScale(T scale) const;
     
     T& operator()(int32 row, int32 col);
     const T& operator()(int32 row, int32 col) const;
@@ -289,6 +294,21 @@ Matrix4_<T> Matrix4_<T>::InversedOrthonorm() const
     return res;
 }
 
+template <typename T>
+Matrix4_<T> Matrix4_<T>::InversedUniformScale(T scale) const
+{
+    // Upper 3x3 is s * R, its inverse is (s * R)^T / s^2. Translation of InversedOrthonorm is scaled in the same way.
+    Matrix4_<T> res = InversedOrthonorm();
+    T invScaleSq = static_cast<T>(1) / (scale * scale);
+    for (int32 row = 0; row < 4; ++row)
+    {
+        res.m[row][0] *= invScaleSq;
+        res.m[row][1] *= invScaleSq;
+        res.m[row][2] *= invScaleSq;
+    }
+    return res;
+}
+
 template <typename T>
 T& Matrix4_<T>::operator()(int32 row, int32 col)
 {
@@ -536,6 +556,133 @@ const Matrix4_<T> Matrix4_<T>::Identity(
     static_cast<T>(0.0f), static_cast<T>(0.0f), static_cast<T>(0.0f), static_cast<T>(1.0f)
 );
 
+#if KIOTO_MATH_SSE
+// Float specializations. Rows are loaded unaligned, layout and row-vector convention are the same as in scalar code.
+namespace Math::Simd
+{
+///
+/// 2x2 row major matrices packed into __m128 as (m00, m01, m10, m11). Returns a * b.
+///
+inline __m128 Mat2Mul(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+
+///
+/// Returns adj(a) * b.
+///
+inline __m128 Mat2AdjMul(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+}
+
+///
+/// Returns a * adj(b).
+///
+inline __m128 Mat2MulAdj(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+}
+}
+
+template <>
+inline Matrix4_<float32>& Matrix4_<float32>::operator *=(const Matrix4_<float32>& m)
+{
+    using namespace Math::Simd;
+    __m128 r0 = _mm_loadu_ps(m.data);
+    __m128 r1 = _mm_loadu_ps(m.data + 4);
+    __m128 r2 = _mm_loadu_ps(m.data + 8);
+    __m128 r3 = _mm_loadu_ps(m.data + 12);
+    for (int32 i = 0; i < 4; ++i)
+        _mm_storeu_ps(data + i * 4, TransformRow(_mm_loadu_ps(data + i * 4), r0, r1, r2, r3));
+    return *this;
+}
+
+template <>
+inline Vector4_<float32> operator* (const Vector4_<float32>& v, const Matrix4_<float32>& m)
+{
+    using namespace Math::Simd;
+    Vector4_<float32> res;
+    _mm_storeu_ps(res.data, TransformRow(_mm_loadu_ps(v.data), _mm_loadu_ps(m.data), _mm_loadu_ps(m.data + 4), _mm_loadu_ps(m.data + 8), _mm_loadu_ps(m.data + 12)));
+    return res;
+}
+
+template <>
+inline Matrix4_<float32> Matrix4_<float32>::Tranposed() const
+{
+    __m128 r0 = _mm_loadu_ps(data);
+    __m128 r1 = _mm_loadu_ps(data + 4);
+    __m128 r2 = _mm_loadu_ps(data + 8);
+    __m128 r3 = _mm_loadu_ps(data + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    Matrix4_<float32> res;
+    _mm_storeu_ps(res.data, r0);
+    _mm_storeu_ps(res.data + 4, r1);
+    _mm_storeu_ps(res.data + 8, r2);
+    _mm_storeu_ps(res.data + 12, r3);
+    return res;
+}
+
+template <>
+inline void Matrix4_<float32>::Transpose()
+{
+    *this = Tranposed();
+}
+
+template <>
+inline bool Matrix4_<float32>::Inversed(Matrix4_<float32>& res) const
+{
+    // Block matrix inverse, M = | A B |, every block is 2x2 matrix.
+    //                           | C D |
+    using namespace Math::Simd;
+    __m128 r0 = _mm_loadu_ps(data);
+    __m128 r1 = _mm_loadu_ps(data + 4);
+    __m128 r2 = _mm_loadu_ps(data + 8);
+    __m128 r3 = _mm_loadu_ps(data + 12);
+
+    __m128 a = _mm_movelh_ps(r0, r1);
+    __m128 b = _mm_movehl_ps(r1, r0);
+    __m128 c = _mm_movelh_ps(r2, r3);
+    __m128 d = _mm_movehl_ps(r3, r2);
+
+    // (|A|, |B|, |C|, |D|)
+    __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+        _mm_mul_ps(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+    __m128 detA = Splat<0>(detSub);
+    __m128 detB = Splat<1>(detSub);
+    __m128 detC = Splat<2>(detSub);
+    __m128 detD = Splat<3>(detSub);
+
+    __m128 dc = Mat2AdjMul(d, c);
+    __m128 ab = Mat2AdjMul(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+    // |M| = |A| * |D| + |B| * |C| - tr(adj(A) * B * adj(D) * C)
+    __m128 tr = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+    tr = _mm_add_ps(tr, Swizzle<2, 3, 0, 1>(tr));
+    tr = _mm_add_ps(tr, Swizzle<1, 0, 3, 2>(tr));
+    __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+    if (Math::IsZero(_mm_cvtss_f32(detM)))
+        return false;
+
+    __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    x = _mm_mul_ps(x, rDetM);
+    y = _mm_mul_ps(y, rDetM);
+    z = _mm_mul_ps(z, rDetM);
+    w = _mm_mul_ps(w, rDetM);
+
+    _mm_storeu_ps(res.data, Shuffle<3, 1, 3, 1>(x, y));
+    _mm_storeu_ps(res.data + 4, Shuffle<2, 0, 2, 0>(x, y));
+    _mm_storeu_ps(res.data + 8, Shuffle<3, 1, 3, 1>(z, w));
+    _mm_storeu_ps(res.data + 12, Shuffle<2, 0, 2, 0>(z, w));
+    return true;
+}
+#endif
+
 using Matrix4 = Matrix4_<float32>;
 
 inline std::ostream& operator<<(std::ostream& os, const Matrix4_<float32>& M)
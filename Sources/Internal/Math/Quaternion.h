@@ -192,12 +192,23 @@ inline Vector3 Quaternion::RotateVector(const Vector3& v) const
 
 inline Matrix4 Quaternion::ToMatrix() const
 {
-    // [a_vorontcov] TODO: optimize squares.
+    float32 x2 = x + x;
+    float32 y2 = y + y;
+    float32 z2 = z + z;
+    float32 xx = x * x2;
+    float32 yy = y * y2;
+    float32 zz = z * z2;
+    float32 xy = x * y2;
+    float32 xz = x * z2;
+    float32 yz = y * z2;
+    float32 wx = w * x2;
+    float32 wy = w * y2;
+    float32 wz = w * z2;
     Matrix4 m
     {
-        1.0f - 2.0f * y * y - 2.0f * z * z, 2.0f * x * y - 2.0f * w * z, 2.0f * x * z + 2.0f * w * y, 0.0f,
-        2.0f * x * y + 2.0f * w * z, 1.0f - 2.0f * x * x - 2.0f * z * z, 2.0f * y * z - 2.0f * w * x, 0.0f,
-        2.0f * x * z - 2.0f * w * y, 2.0f * y * z + 2.0f * w * x, 1.0f - 2.0f * x * x - 2.0f * y * y, 0.0f,
+        1.0f - yy - zz, xy - wz, xz + wy, 0.0f,
+        xy + wz, 1.0f - xx - zz, yz - wx, 0.0f,
+        xz - wy, yz + wx, 1.0f - xx - yy, 0.0f,
         0.0f, 0.0f, 0.0f, 1.0f
     };
     return m;
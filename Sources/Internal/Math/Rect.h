@@ -10,9 +10,9 @@ struct Rect_
 {
     Rect_() = default;
     Rect_(const Vector4_<T>& other);
-    Rect_(const Rect_& other);
+    Rect_(const Rect_& other) = default;
     Rect_(T left, T top, T right, T bottom);
-    Rect_& operator= (const Rect_& other);
+    Rect_& operator= (const Rect_& other) = default;
 
     T Left = 0;
     T Top = 0;
@@ -26,29 +26,12 @@ Rect_<T>::Rect_(const Vector4_<T>& other)
 {
 }
 
-template <typename T>
-Rect_<T>::Rect_(const Rect_<T>& other)
-    : Left(other.Left), Top(other.Top), Right(other.Right), Bottom(other.Bottom)
-{
-}
-
 template <typename T>
 Rect_<T>::Rect_(T left, T top, T right, T bottom)
     : Left(left), Top(top), Right(right), Bottom(bottom)
 {
 }
 
-template <typename T>
-Rect_<T>& Rect_<T>::operator= (const Rect_& other)
-{
-    Left = other.Left;
-    Top = other.Top;
-    Right = other.Right;
-    Bottom = other.Bottom;
-
-    return *this;
-}
-
 using Rect = Rect_<float32>;
 using RectI = Rect_<int32>;
 }
@@ -0,0 +1,64 @@
+#include "stdafx.h"
+
+#include "Render/Buffers/UploadRingAllocator.h"
+
+namespace Kioto::Renderer
+{
+uint32 UploadRingAllocator::Allocate(uint32 size)
+{
+    uint32 alignedSize = (size + Alignment - 1) & ~(Alignment - 1);
+    assert(alignedSize > 0);
+    if (alignedSize > m_capacity - m_usedSize)
+        return InvalidOffset;
+
+    if (m_usedSize == 0)
+    {
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    // Free space is [head, capacity) and [0, tail) if head is after tail, [head, tail) otherwise. Head equals tail only if the ring is empty.
+    uint32 offset = m_head;
+    uint32 skipped = 0;
+    if (m_head >= m_tail)
+    {
+        if (m_capacity - m_head < alignedSize)
+        {
+            if (m_tail < alignedSize)
+                return InvalidOffset;
+            skipped = m_capacity - m_head;
+            offset = 0;
+        }
+    }
+    else if (m_tail - m_head < alignedSize)
+    {
+        return InvalidOffset;
+    }
+
+    m_head = offset + alignedSize;
+    if (m_head == m_capacity)
+        m_head = 0;
+    m_usedSize += skipped + alignedSize;
+    m_frameUsedSize += skipped + alignedSize;
+    return offset;
+}
+
+void UploadRingAllocator::FinishFrame(uint64 fenceValue)
+{
+    assert(m_frames.empty() || m_frames.back().FenceValue < fenceValue);
+    if (m_frameUsedSize == 0)
+        return;
+    m_frames.push_back({ fenceValue, m_head, m_frameUsedSize });
+    m_frameUsedSize = 0;
+}
+
+void UploadRingAllocator::Reclaim(uint64 completedFenceValue)
+{
+    while (!m_frames.empty() && m_frames.front().FenceValue <= completedFenceValue)
+    {
+        m_tail = m_frames.front().End;
+        m_usedSize -= m_frames.front().Size;
+        m_frames.pop_front();
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <deque>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Renderer
+{
+///
+/// Suballocator of upload memory shared by the frames in flight. Memory is a ring, allocation bumps the head offset. Frames are freed
+/// from the tail as a whole: FinishFrame tags allocations of the frame with the fence value GPU signals after the frame,
+/// Reclaim frees frames whose fence value is completed. Allocator hands out offsets only, backends map them to their resources.
+///
+class UploadRingAllocator
+{
+public:
+    static constexpr uint32 Alignment = 256; // Constant buffer views start at multiples of 256 bytes.
+    static constexpr uint32 InvalidOffset = 0xFFFFFFFF;
+
+    UploadRingAllocator() = default;
+    explicit UploadRingAllocator(uint32 capacity);
+
+    ///
+    /// Get offset of size bytes, InvalidOffset if there is no space until older frames are reclaimed. Not thread safe.
+    ///
+    uint32 Allocate(uint32 size);
+    ///
+    /// Close allocations made since the previous call, they are freed by Reclaim once fenceValue is completed.
+    ///
+    void FinishFrame(uint64 fenceValue);
+    ///
+    /// Free memory of the finished frames whose fence value is not greater than completedFenceValue.
+    ///
+    void Reclaim(uint64 completedFenceValue);
+
+    ///
+    /// Get fence value of the oldest frame holding memory, 0 if there is none. Wait for it and reclaim if Allocate fails.
+    ///
+    uint64 GetOldestFenceValue() const;
+    uint32 GetCapacity() const;
+    ///
+    /// Get bytes held by all frames, including alignment and the end of the ring skipped on wrap.
+    ///
+    uint32 GetUsedSize() const;
+    ///
+    /// Get bytes allocated since the last FinishFrame.
+    ///
+    uint32 GetFrameUsedSize() const;
+
+private:
+    struct FrameMark
+    {
+        uint64 FenceValue = 0;
+        uint32 End = 0; // Head after the last allocation of the frame, tail moves here when the frame is freed.
+        uint32 Size = 0;
+    };
+
+    uint32 m_capacity = 0;
+    uint32 m_head = 0;
+    uint32 m_tail = 0;
+    uint32 m_usedSize = 0;
+    uint32 m_frameUsedSize = 0;
+    std::deque<FrameMark> m_frames;
+};
+
+inline UploadRingAllocator::UploadRingAllocator(uint32 capacity)
+    : m_capacity(capacity)
+{
+    assert(capacity % Alignment == 0);
+}
+
+inline uint64 UploadRingAllocator::GetOldestFenceValue() const
+{
+    return m_frames.empty() ? 0 : m_frames.front().FenceValue;
+}
+
+inline uint32 UploadRingAllocator::GetCapacity() const
+{
+    return m_capacity;
+}
+
+inline uint32 UploadRingAllocator::GetUsedSize() const
+{
+    return m_usedSize;
+}
+
+inline uint32 UploadRingAllocator::GetFrameUsedSize() const
+{
+    return m_frameUsedSize;
+}
+}
\ No newline at end of file
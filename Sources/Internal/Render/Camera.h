@@ -2,6 +2,7 @@
 
 #include "Core/Core.h"
 #include "Core/CoreTypes.h"
+#include "Math/Frustum.h"
 #include "Math/Matrix4.h"
 #include "Render/ConstantBuffer.h"
 #include "Render/Buffers/EngineBuffers.h"
@@ -110,6 +111,11 @@ public:
     ///
     Matrix4 GetVP() const;
 
+    ///
+    /// Get world space frustum, updated with (view * projection) matrix.
+    ///
+    const Frustum& GetFrustum() const;
+
     bool GetIsProjectionDirty() const
     {
         return m_isProjDirty;
@@ -129,6 +135,7 @@ private:
     Matrix4 m_view = Matrix4::Identity;
     Matrix4 m_projection = Matrix4::Identity;
     Matrix4 m_VP = Matrix4::Identity;
+    Frustum m_frustum;
     bool m_isProjDirty = true;
     float32 m_fovY = Math::DegToRad(60.0f);
     float32 m_foxX = -1.0f;
@@ -232,6 +239,11 @@ inline Matrix4 Camera::GetVP() const
     return m_VP;
 }
 
+inline const Frustum& Camera::GetFrustum() const
+{
+    return m_frustum;
+}
+
 inline void Camera::UpdateProjectionMatrix()
 {
     m_projection = Matrix4::BuildProjectionFov(GetFovY(), GetAspect(), GetNearPlane(), GetFarPlane());
@@ -249,6 +261,7 @@ inline void Camera::UpdateProjectionMatrix()
 inline void Camera::UpdateViewProjectionMatrix()
 {
     m_VP = m_view * m_projection;
+    m_frustum = Frustum::FromViewProjection(m_VP);
 }
 
 inline void Camera::SetView(const Matrix4& view)
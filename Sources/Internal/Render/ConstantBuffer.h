@@ -5,6 +5,7 @@
 
 #include "Core/CoreTypes.h"
 #include "Core/CoreHelpers.h"
+#include "Core/DataStructures/StringTable.h"
 
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
@@ -25,8 +26,11 @@ public:
     ConstantBuffer() {}
     ConstantBuffer(std::string name, uint16 index, uint16 space, uint16 elemSize, uint16 elemCount = 1, bool allocate = false);
     ConstantBuffer(std::string name, uint16 index, uint16 space);
+    ///
+    /// Write value to the buffer, returns false and doesn't schedule the update if the buffer already holds the same value.
+    ///
     template <typename T>
-    void Set(const T& val, uint16 elemOffset = 0, bool updateHWinstance = true);
+    bool Set(const T& val, uint16 elemOffset = 0, bool updateHWinstance = true);
     template <typename T>
     T* Get(uint16 elemOffset = 0);
     void Reallocate();
@@ -43,6 +47,7 @@ public:
     uint32 GetElemSize() const;
     uint32 GetElemCount() const;
     const std::string& GetName() const;
+    StringId GetNameId() const;
     template <typename T>
     void SetElemCount(uint32 count, bool reallocate = false);
     bool IsAllocated() const;
@@ -51,7 +56,14 @@ public:
 
     ConstantBufferHandle GetHandle() const;
     void SetHandle(ConstantBufferHandle handle);
+    ///
+    /// Mark data as changed and queue it for upload. Call after writing through GetBufferData.
+    ///
     void ScheduleToUpdate();
+    ///
+    /// Version of the data, incremented on every change. Backends skip copying buffers which version was already uploaded.
+    ///
+    uint32 GetVersion() const;
 
     uint16 GetIndex() const;
     uint16 GetSpace() const;
@@ -69,7 +81,9 @@ private:
     uint32 m_dataSize = 0;
     uint32 m_elemCount = 0;
     uint32 m_elemSize = 0;
+    uint32 m_version = 1; // Backends start with uploaded version 0, so data is uploaded at least once.
     std::string m_name;
+    StringId m_nameId = InvalidStringId; // Interned name, buffers are looked up by it every frame.
 
     ConstantBufferHandle m_handle;
 
@@ -84,7 +98,9 @@ private:
         std::swap(l.m_handle, r.m_handle);
         std::swap(l.m_elemCount, r.m_elemCount);
         std::swap(l.m_elemSize, r.m_elemSize);
+        std::swap(l.m_version, r.m_version);
         std::swap(l.m_name, r.m_name);
+        std::swap(l.m_nameId, r.m_nameId);
     }
 };
 
@@ -103,6 +119,11 @@ inline const std::string& ConstantBuffer::GetName() const
     return m_name;
 }
 
+inline StringId ConstantBuffer::GetNameId() const
+{
+    return m_nameId;
+}
+
 template <typename T>
 inline void ConstantBuffer::SetElemCount(uint32 count, bool reallocate)
 {
@@ -117,6 +138,7 @@ inline void ConstantBuffer::SetElemCount(uint32 count, bool reallocate)
 
 inline ConstantBuffer::ConstantBuffer(std::string name, uint16 index, uint16 space, uint16 elemSize, uint16 elemCount, bool allocate)
     : m_name(std::move(name))
+    , m_nameId(StringTable::Intern(m_name))
     , m_index(index)
     , m_space(space)
     , m_key(m_index | m_space << 16)
@@ -125,14 +147,12 @@ inline ConstantBuffer::ConstantBuffer(std::string name, uint16 index, uint16 spa
     , m_elemSize(elemSize)
 {
     if (allocate)
-    {
-        m_memData = new byte[m_dataSize];
-        m_isAllocated = true;
-    }
+        Reallocate();
 }
 
 inline ConstantBuffer::ConstantBuffer(std::string name, uint16 index, uint16 space)
     : m_name(std::move(name))
+    , m_nameId(StringTable::Intern(m_name))
     , m_index(index)
     , m_space(space)
     , m_key(m_index | m_space << 16)
@@ -140,13 +160,18 @@ inline ConstantBuffer::ConstantBuffer(std::string name, uint16 index, uint16 spa
 }
 
 template <typename T>
-inline void ConstantBuffer::Set(const T& val, uint16 elemOffset, bool updateHWinstance)
+inline bool ConstantBuffer::Set(const T& val, uint16 elemOffset, bool updateHWinstance)
 {
-    T* mem = reinterpret_cast<T*>(m_memData);
-    *(mem + elemOffset) = val;
+    T* mem = reinterpret_cast<T*>(m_memData) + elemOffset;
+    if (memcmp(mem, &val, sizeof(T)) == 0)
+        return false;
+    *mem = val;
 
     if (updateHWinstance)
         ScheduleToUpdate();
+    else
+        ++m_version;
+    return true;
 }
 
 template <typename T>
@@ -206,7 +231,9 @@ inline void ConstantBuffer::Reallocate()
 {
     SafeDeleteArray(m_memData);
     m_memData = new byte[m_dataSize];
+    memset(m_memData, 0, m_dataSize); // Set compares with the previous value.
     m_isAllocated = true;
+    ++m_version;
 }
 
 inline ConstantBuffer::~ConstantBuffer()
@@ -216,6 +243,7 @@ inline ConstantBuffer::~ConstantBuffer()
 
 inline ConstantBuffer::ConstantBuffer(const ConstantBuffer& other)
     : m_name(other.m_name)
+    , m_nameId(other.m_nameId)
     , m_index(other.m_index)
     , m_space(other.m_space)
     , m_key(other.m_key)
@@ -223,6 +251,7 @@ inline ConstantBuffer::ConstantBuffer(const ConstantBuffer& other)
     , m_dataSize(other.m_dataSize)
     , m_elemSize(other.m_elemSize)
     , m_elemCount(other.m_elemCount)
+    , m_version(other.m_version)
 {
     if (other.IsAllocated())
         memcpy(m_memData, other.m_memData, other.m_dataSize);
@@ -248,14 +277,21 @@ inline void ConstantBuffer::MakeShallowCopy(ConstantBuffer& target, bool queueFo
     target.m_elemSize = m_elemSize;
     target.m_dataSize = m_dataSize;
     target.m_name = m_name;
+    target.m_nameId = m_nameId;
     target.m_isAllocated = false;
 }
 
 inline void ConstantBuffer::ScheduleToUpdate()
 {
+    ++m_version;
     Renderer::QueueConstantBufferForUpdate(*this);
 }
 
+inline uint32 ConstantBuffer::GetVersion() const
+{
+    return m_version;
+}
+
 inline bool ConstantBuffer::IsPerObjectBuffer() const
 {
     return m_space != Renderer::EngineBuffers::EngineBuffersSpace;
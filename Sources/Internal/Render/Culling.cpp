@@ -0,0 +1,84 @@
+#include "stdafx.h"
+
+#include "Render/Culling.h"
+
+#include "Core/Jobs/JobSystem.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/MathSimd.h"
+#include "Render/Geometry/Mesh.h"
+#include "Render/RenderObject.h"
+
+namespace Kioto::Renderer::Culling
+{
+void CullSpheres(const Frustum& frustum, const float32* x, const float32* y, const float32* z, const float32* radius, uint32 count, uint8* visible)
+{
+    uint32 i = 0;
+#if KIOTO_MATH_SSE
+    using namespace Math::Simd;
+    __m128 planes[Frustum::PlanesCount][4];
+    for (uint32 p = 0; p < Frustum::PlanesCount; ++p)
+    {
+        planes[p][0] = _mm_set1_ps(frustum.Planes[p].x);
+        planes[p][1] = _mm_set1_ps(frustum.Planes[p].y);
+        planes[p][2] = _mm_set1_ps(frustum.Planes[p].z);
+        planes[p][3] = _mm_set1_ps(frustum.Planes[p].w);
+    }
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (uint32 p = 0; p < Frustum::PlanesCount; ++p)
+        {
+            __m128 distance = MulAdd(cz, planes[p][2], MulAdd(cy, planes[p][1], MulAdd(cx, planes[p][0], planes[p][3])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+        int32 mask = _mm_movemask_ps(inside);
+        visible[i] = mask & 1;
+        visible[i + 1] = (mask >> 1) & 1;
+        visible[i + 2] = (mask >> 2) & 1;
+        visible[i + 3] = (mask >> 3) & 1;
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        BoundingSphere sphere;
+        sphere.Center = { x[i], y[i], z[i] };
+        sphere.Radius = radius[i];
+        visible[i] = frustum.Intersects(sphere) ? 1 : 0;
+    }
+}
+
+void CullRenderObjects(const Frustum& frustum, const FrameVector<RenderObject*>& objects, FrameVector<RenderObject*>& visible)
+{
+    uint32 count = static_cast<uint32>(objects.size());
+    uint8* isVisible = FrameAllocator::NewArray<uint8>(count);
+    JobSystem::ParallelFor(0, count, GrainSize, [&frustum, &objects, isVisible](uint32 begin, uint32 end)
+    {
+        // World spheres of the range are gathered to separate arrays, so that they are tested four at once.
+        float32 x[GrainSize];
+        float32 y[GrainSize];
+        float32 z[GrainSize];
+        float32 radius[GrainSize];
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const RenderObject* ro = objects[i];
+            BoundingSphere sphere = ro->GetMesh()->GetBoundingSphere().Transformed(*ro->GetToWorld());
+            x[i - begin] = sphere.Center.x;
+            y[i - begin] = sphere.Center.y;
+            z[i - begin] = sphere.Center.z;
+            radius[i - begin] = sphere.Radius;
+        }
+        CullSpheres(frustum, x, y, z, radius, end - begin, isVisible + begin);
+    });
+
+    visible.reserve(visible.size() + count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (isVisible[i] != 0)
+            visible.push_back(objects[i]);
+    }
+}
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Core/CoreTypes.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Math/Frustum.h"
+
+namespace Kioto::Renderer
+{
+class RenderObject;
+
+///
+/// Culling stage between scene and render graph. Objects are tested by world bounding spheres of their meshes.
+///
+namespace Culling
+{
+static constexpr uint32 GrainSize = 1024; // Objects culled by one job.
+
+///
+/// Test spheres stored as separate arrays against frustum, four spheres per instruction. visible[i] is set to 1 if sphere i
+/// intersects the frustum and to 0 otherwise.
+///
+KIOTO_API void CullSpheres(const Frustum& frustum, const float32* x, const float32* y, const float32* z, const float32* radius, uint32 count, uint8* visible);
+
+///
+/// Append objects intersecting the frustum to visible, keeping their order. Objects are culled on the workers, call it once
+/// per camera to get its visible list. Objects must have mesh and world transform set.
+///
+void CullRenderObjects(const Frustum& frustum, const FrameVector<RenderObject*>& objects, FrameVector<RenderObject*>& visible);
+}
+}
\ No newline at end of file
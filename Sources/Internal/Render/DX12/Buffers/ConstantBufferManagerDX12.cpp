@@ -1,27 +1,63 @@
 #include "stdafx.h"
 
 #include "Render/DX12/Buffers/ConstantBufferManagerDX12.h"
+
+#include <algorithm>
+
+#include "Render/DX12/DXHelpers.h"
 #include "Render/DX12/StateDX.h"
 #include "Render/RenderObject.h"
+#include "Render/RenderOptions.h"
 
 namespace Kioto::Renderer
 {
+namespace
+{
+uint32 AlignResidentSize(uint32 size)
+{
+    return (size + UploadRingAllocator::Alignment - 1) & ~(UploadRingAllocator::Alignment - 1);
+}
+}
+
 ConstantBufferManagerDX12::ConstantBufferManagerDX12()
 {
-    m_updateQueues.reserve(128);
-    m_buffersToResetUpdatedFramesCount.reserve(128);
+    m_dynamicBuffers.Reserve(1024);
     m_registrationQueue.reserve(128);
 }
 
 ConstantBufferManagerDX12::~ConstantBufferManagerDX12()
 {
     for (auto& buf : m_constantBuffers)
-        SafeDelete(buf.second);
-    m_constantBuffers.clear();
+        SafeDelete(buf);
+    m_constantBuffers.Clear();
+    for (auto& retired : m_retiredBuffers)
+        SafeDelete(retired.Upload);
+    m_retiredBuffers.clear();
 
-    for (auto& buf : m_internalBuffers)
-        SafeDelete(buf.second);
-    m_internalBuffers.clear();
+    if (m_residentResource != nullptr)
+        m_residentResource->Unmap(0, nullptr);
+    m_residentData = nullptr;
+}
+
+void ConstantBufferManagerDX12::Init(const StateDX& state)
+{
+    m_uploadRing.Init(state, RenderOptions::ConstantUploadRingSize);
+
+    CD3DX12_HEAP_PROPERTIES hProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    CD3DX12_RESOURCE_DESC rDesc = CD3DX12_RESOURCE_DESC::Buffer(RenderOptions::ResidentConstantsSize);
+    ThrowIfFailed(state.Device->CreateCommittedResource(
+        &hProps,
+        D3D12_HEAP_FLAG_NONE,
+        &rDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&m_residentResource)
+    ));
+    NAME_D3D12_OBJECT(m_residentResource);
+
+    CD3DX12_RANGE readRange(0, 0);
+    ThrowIfFailed(m_residentResource->Map(0, &readRange, reinterpret_cast<void**>(&m_residentData)));
+    m_residentGpuAddress = m_residentResource->GetGPUVirtualAddress();
 }
 
 void ConstantBufferManagerDX12::RegisterRenderObject(RenderObject& renderObject)
@@ -38,13 +74,28 @@ void ConstantBufferManagerDX12::RegisterRenderObject(RenderObject& renderObject)
     }
 }
 
+void ConstantBufferManagerDX12::UnregisterRenderObject(RenderObject& renderObject)
+{
+    std::unordered_map<std::string, RenderObjectBufferLayout>& bufferLayouts = renderObject.GetBuffersLayouts();
+    for (auto& layoutElem : bufferLayouts)
+    {
+        RenderObjectBufferLayout& bufferLayout = layoutElem.second;
+        for (size_t i = 0; i < bufferLayout.size(); ++i)
+        {
+            if (bufferLayout[i].IsPerObjectBuffer())
+                UnregisterConstantBuffer(&bufferLayout[i]);
+        }
+    }
+}
+
 void ConstantBufferManagerDX12::ProcessRegistrationQueue(const StateDX& state)
 {
     for (auto& tmpBuf : m_registrationQueue)
     {
         UploadBufferDX12* buf = new UploadBufferDX12(state, tmpBuf.Data, tmpBuf.ElementSize, tmpBuf.ElementsCount, true);
-        SafeDelete(m_constantBuffers[tmpBuf.CBHandle]);
-        m_constantBuffers[tmpBuf.CBHandle] = buf;
+        UploadBufferDX12*& dst = m_constantBuffers[tmpBuf.CBHandle];
+        SafeDelete(dst);
+        dst = buf;
     }
     m_registrationQueue.clear();
 }
@@ -53,71 +104,214 @@ void ConstantBufferManagerDX12::RegisterConstantBuffer(ConstantBuffer* buffer)
 {
     if (buffer->GetHandle() != InvalidHandle)
         return;
-    auto it = m_constantBuffers.find(buffer->GetHandle()); // [a_vorontcov] We have this buffer registred.
-    if (it != m_constantBuffers.cend())
-        return;
-    for (auto& tmpBuf : m_registrationQueue)
-    {
-        if (tmpBuf.CBHandle == buffer->GetHandle())
-            return;
-    }
 
     ConstantBufferHandle bufHandle = GetNewHandle();
     buffer->SetHandle(bufHandle);
+    if (buffer->GetElemCount() == 1)
+    {
+        DynamicBuffer& dynamicBuffer = m_dynamicBuffers[bufHandle];
+        dynamicBuffer.Buffer = buffer;
+        dynamicBuffer.ResidentOffset = AllocateResident(buffer->GetDataSize());
+        return;
+    }
     m_registrationQueue.emplace_back(bufHandle, buffer->GetElemSize(), buffer->GetElemCount(), buffer->GetBufferData());
     QueueConstantBufferForUpdate(*buffer);
 }
 
-void ConstantBufferManagerDX12::QueueConstantBufferForUpdate(ConstantBuffer& buffer)
+void ConstantBufferManagerDX12::UnregisterConstantBuffer(ConstantBuffer* buffer)
 {
-    if (buffer.GetHandle() == InvalidHandle)
+    ConstantBufferHandle handle = buffer->GetHandle();
+    if (handle == InvalidHandle)
         return;
 
-    auto itr = std::find(m_buffersToResetUpdatedFramesCount.cbegin(), m_buffersToResetUpdatedFramesCount.cend(), &buffer);
-    if (itr == m_buffersToResetUpdatedFramesCount.cend())
-        m_buffersToResetUpdatedFramesCount.push_back(&buffer); // [a_vorontcov] TODO: Very questionable.
+    // Command lists of the current frame may have bound the buffer already, so its memory is retired until the frame completes.
+    RetiredBuffer retired;
+    retired.Fence = m_frameFence;
+    DynamicBuffer* dynamicBuffer = m_dynamicBuffers.Find(handle);
+    if (dynamicBuffer != nullptr)
+    {
+        if (dynamicBuffer->ResidentOffset != UploadRingAllocator::InvalidOffset)
+            retired.Resident = { dynamicBuffer->ResidentOffset, AlignResidentSize(buffer->GetDataSize()) };
+        m_dynamicBuffers.Remove(handle);
+    }
+    UploadBufferDX12* uploadBuf = FindBuffer(handle);
+    if (uploadBuf != nullptr)
+    {
+        retired.Upload = uploadBuf;
+        m_constantBuffers.Remove(handle);
+    }
+    if (retired.Upload != nullptr || retired.Resident.Offset != UploadRingAllocator::InvalidOffset)
+        m_retiredBuffers.push_back(retired);
+
+    m_updateQueue.erase(handle.GetHandle());
+    auto it = std::remove_if(m_registrationQueue.begin(), m_registrationQueue.end(), [handle](const TempCBData& tmpBuf) { return tmpBuf.CBHandle == handle; });
+    m_registrationQueue.erase(it, m_registrationQueue.end());
+    buffer->SetHandle(InvalidHandle);
+}
 
-    auto it = std::find_if(m_updateQueues.cbegin(), m_updateQueues.cend(), [&buffer](const ConstantBuffer* b) { return b->GetHandle() == buffer.GetHandle(); });
-    if (it != m_updateQueues.cend())
-        return;
+void ConstantBufferManagerDX12::QueueConstantBufferForUpdate(ConstantBuffer& buffer)
+{
+    if (buffer.GetHandle() == InvalidHandle || buffer.GetElemCount() == 1)
+        return; // Dynamic buffers are read when bound.
 
-    m_updateQueues.push_back(&buffer);
+    m_updateQueue[buffer.GetHandle().GetHandle()] = { &buffer, true };
 }
 
-void ConstantBufferManagerDX12::ProcessBufferUpdates(UINT frameIndex)
+void ConstantBufferManagerDX12::ProcessBufferUpdates(UINT frameIndex, uint64 completedFenceValue, uint64 frameFenceValue)
 {
-    std::vector<ConstantBuffer*> intermediateQueue; // [a_vorontcov] TODO: Too ugly. Rethink.
-    intermediateQueue.reserve(m_updateQueues.size());
-    for (auto& cb : m_updateQueues)
+    m_uploadRing.Reclaim(completedFenceValue);
+    ReleaseRetiredBuffers(completedFenceValue);
+    m_completedFence = completedFenceValue;
+    m_frameFence = frameFenceValue;
+    m_frameUploadsCount = 0;
+    m_frameUploadedSize = 0;
+    m_frameSkippedCount = 0;
+    m_frameSkippedSize = 0;
+
+    for (auto it = m_updateQueue.begin(); it != m_updateQueue.end();)
     {
-        UploadBufferDX12* uploadBuf = FindBuffer(cb->GetHandle());
+        PendingUpdate& update = it->second;
+        UploadBufferDX12* uploadBuf = FindBuffer(update.Buffer->GetHandle());
 
-        assert(cb->IsAllocated());
+        assert(update.Buffer->IsAllocated());
         if (uploadBuf == nullptr)
         {
             assert(false);
+            it = m_updateQueue.erase(it);
             continue;
         }
 
-        auto it = std::find(m_buffersToResetUpdatedFramesCount.cbegin(), m_buffersToResetUpdatedFramesCount.cend(), cb);
-        if (it != m_buffersToResetUpdatedFramesCount.cend())
+        if (update.IsChanged)
             uploadBuf->ResetUpdatedFramesCount();
+        update.IsChanged = false;
 
-        uploadBuf->UploadData(frameIndex, cb->GetBufferData());
+        uploadBuf->UploadData(frameIndex, update.Buffer->GetBufferData());
         uploadBuf->IncrementUpdatedFramesCount();
-        if (!uploadBuf->IsUpdated())
-            intermediateQueue.push_back(cb);
+        ++m_frameUploadsCount;
+        m_frameUploadedSize += update.Buffer->GetDataSize();
+        if (uploadBuf->IsUpdated())
+            it = m_updateQueue.erase(it);
+        else
+            ++it;
     }
-    m_buffersToResetUpdatedFramesCount.clear();
-    m_updateQueues.clear();
-    m_updateQueues = std::move(intermediateQueue);
+}
+
+void ConstantBufferManagerDX12::FinishFrame(uint64 fenceValue)
+{
+    m_uploadRing.FinishFrame(fenceValue);
 }
 
 UploadBufferDX12* ConstantBufferManagerDX12::FindBuffer(ConstantBufferHandle handle) const
 {
-    auto it = m_constantBuffers.find(handle);
-    if (it == m_constantBuffers.end())
-        return nullptr;
-    return it->second;
+    UploadBufferDX12* const* buffer = m_constantBuffers.Find(handle);
+    return buffer != nullptr ? *buffer : nullptr;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS ConstantBufferManagerDX12::GetFrameDataGpuAddress(const StateDX& state, ConstantBufferHandle handle)
+{
+    DynamicBuffer* found = m_dynamicBuffers.Find(handle);
+    if (found == nullptr)
+    {
+        assert(false);
+        return 0;
+    }
+
+    DynamicBuffer& dynamicBuffer = *found;
+    if (dynamicBuffer.BoundFence == m_frameFence)
+        return dynamicBuffer.Address;
+    dynamicBuffer.BoundFence = m_frameFence;
+
+    ConstantBuffer* buffer = dynamicBuffer.Buffer;
+    assert(buffer->IsAllocated());
+    bool hasResidentCopy = dynamicBuffer.ResidentOffset != UploadRingAllocator::InvalidOffset;
+    if (hasResidentCopy && dynamicBuffer.ResidentVersion == buffer->GetVersion())
+    {
+        ++m_frameSkippedCount;
+        m_frameSkippedSize += buffer->GetDataSize();
+    }
+    else if (hasResidentCopy && dynamicBuffer.ResidentFence <= m_completedFence)
+    {
+        memcpy(m_residentData + dynamicBuffer.ResidentOffset, buffer->GetBufferData(), buffer->GetDataSize());
+        dynamicBuffer.ResidentVersion = buffer->GetVersion();
+        ++m_frameUploadsCount;
+        m_frameUploadedSize += buffer->GetDataSize();
+    }
+    else
+    {
+        // Resident copy is read by frames in flight, so changed data goes to the ring until they are completed.
+        dynamicBuffer.Address = m_uploadRing.Upload(state, buffer->GetBufferData(), buffer->GetDataSize());
+        ++m_frameUploadsCount;
+        m_frameUploadedSize += buffer->GetDataSize();
+        return dynamicBuffer.Address;
+    }
+
+    dynamicBuffer.ResidentFence = m_frameFence;
+    dynamicBuffer.Address = m_residentGpuAddress + dynamicBuffer.ResidentOffset;
+    return dynamicBuffer.Address;
+}
+
+uint32 ConstantBufferManagerDX12::AllocateResident(uint32 size)
+{
+    uint32 alignedSize = AlignResidentSize(size);
+    for (auto it = m_residentFreeRanges.begin(); it != m_residentFreeRanges.end(); ++it)
+    {
+        if (it->Size < alignedSize)
+            continue;
+
+        uint32 offset = it->Offset;
+        it->Offset += alignedSize;
+        it->Size -= alignedSize;
+        if (it->Size == 0)
+            m_residentFreeRanges.erase(it);
+        return offset;
+    }
+
+    if (alignedSize > RenderOptions::ResidentConstantsSize - m_residentUsedSize)
+        return UploadRingAllocator::InvalidOffset;
+
+    uint32 offset = m_residentUsedSize;
+    m_residentUsedSize += alignedSize;
+    return offset;
+}
+
+void ConstantBufferManagerDX12::FreeResident(const ResidentRange& range)
+{
+    auto next = std::lower_bound(m_residentFreeRanges.begin(), m_residentFreeRanges.end(), range.Offset,
+        [](const ResidentRange& r, uint32 offset) { return r.Offset < offset; });
+    if (next != m_residentFreeRanges.begin())
+    {
+        auto prev = next - 1;
+        if (prev->Offset + prev->Size == range.Offset)
+        {
+            prev->Size += range.Size;
+            if (next != m_residentFreeRanges.end() && prev->Offset + prev->Size == next->Offset)
+            {
+                prev->Size += next->Size;
+                m_residentFreeRanges.erase(next);
+            }
+            return;
+        }
+    }
+    if (next != m_residentFreeRanges.end() && range.Offset + range.Size == next->Offset)
+    {
+        next->Offset = range.Offset;
+        next->Size += range.Size;
+        return;
+    }
+    m_residentFreeRanges.insert(next, range);
+}
+
+void ConstantBufferManagerDX12::ReleaseRetiredBuffers(uint64 completedFenceValue)
+{
+    auto it = std::remove_if(m_retiredBuffers.begin(), m_retiredBuffers.end(), [this, completedFenceValue](RetiredBuffer& retired)
+    {
+        if (retired.Fence > completedFenceValue)
+            return false;
+        SafeDelete(retired.Upload);
+        if (retired.Resident.Offset != UploadRingAllocator::InvalidOffset)
+            FreeResident(retired.Resident);
+        return true;
+    });
+    m_retiredBuffers.erase(it, m_retiredBuffers.end());
 }
 }
\ No newline at end of file
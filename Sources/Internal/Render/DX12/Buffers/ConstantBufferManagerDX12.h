@@ -1,11 +1,14 @@
 #pragma once
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <windows.h>
+#include <wrl.h>
 
+#include "Render/HandleTable.h"
 #include "Render/RendererPublic.h"
 #include "Render/DX12/Buffers/UploadBufferDX12.h"
+#include "Render/DX12/Buffers/UploadRingBufferDX12.h"
 
 namespace Kioto::Renderer
 {
@@ -13,18 +16,49 @@ class ConstantBuffer;
 class RenderObject;
 struct StateDX;
 
+///
+/// Buffers of one element are dynamic: they are read when bound first in a frame, so queueing their updates is free. Each has
+/// a resident copy in a persistent upload resource, which is bound as long as buffer version doesn't change. Changed data is
+/// written to the resident copy if GPU doesn't read it anymore, otherwise to the shared upload ring.
+/// Buffers of several elements are bound by descriptor tables and keep their own upload resources with a copy per frame in flight.
+///
 class ConstantBufferManagerDX12
 {
 public:
     ConstantBufferManagerDX12();
     ~ConstantBufferManagerDX12();
+    void Init(const StateDX& state);
     void RegisterRenderObject(RenderObject& renderObject);
+    void UnregisterRenderObject(RenderObject& renderObject);
     void ProcessRegistrationQueue(const StateDX& state);
     void RegisterConstantBuffer(ConstantBuffer* buffer); // [a_vorontcov] -1 for internal buffers.
+    ///
+    /// Forget the buffer. Its own upload resource and resident range are released once GPU completes the current frame.
+    ///
+    void UnregisterConstantBuffer(ConstantBuffer* buffer);
     void QueueConstantBufferForUpdate(ConstantBuffer& buffer);
-    void ProcessBufferUpdates(UINT frameIndex);
+    ///
+    /// Start the frame: free ring memory of the frames completed by GPU and upload changed buffers with own resources.
+    ///
+    void ProcessBufferUpdates(UINT frameIndex, uint64 completedFenceValue, uint64 frameFenceValue);
+    ///
+    /// Close ring allocations of the frame, they are reused after GPU signals fenceValue.
+    ///
+    void FinishFrame(uint64 fenceValue);
 
+    ///
+    /// Get buffer with its own upload resource, nullptr for dynamic buffers.
+    ///
     UploadBufferDX12* FindBuffer(ConstantBufferHandle handle) const;
+    ///
+    /// Get GPU address of dynamic buffer data for the current frame. Data is copied on the first call in a frame if it has changed.
+    ///
+    D3D12_GPU_VIRTUAL_ADDRESS GetFrameDataGpuAddress(const StateDX& state, ConstantBufferHandle handle);
+
+    uint32 GetFrameUploadsCount() const;
+    uint64 GetFrameUploadedSize() const;
+    uint32 GetFrameSkippedCount() const;
+    uint64 GetFrameSkippedSize() const;
 
 private:
     struct TempCBData
@@ -43,10 +77,83 @@ private:
         }
     };
 
-    std::map<ConstantBufferHandle, UploadBufferDX12*> m_constantBuffers;
-    std::map<ConstantBufferHandle, UploadBufferDX12*> m_internalBuffers;
-    std::vector<ConstantBuffer*> m_updateQueues;
-    std::vector<ConstantBuffer*> m_buffersToResetUpdatedFramesCount;
+    struct DynamicBuffer
+    {
+        ConstantBuffer* Buffer = nullptr;
+        uint64 BoundFence = 0; // Fence value of the frame which has bound the buffer last.
+        D3D12_GPU_VIRTUAL_ADDRESS Address = 0;
+        uint32 ResidentOffset = UploadRingAllocator::InvalidOffset; // Buffers registered after resident resource is full use the ring only.
+        uint32 ResidentVersion = 0;
+        uint64 ResidentFence = 0; // Fence value of the frame which has read the resident copy last.
+    };
+
+    struct ResidentRange
+    {
+        uint32 Offset = 0;
+        uint32 Size = 0;
+    };
+
+    ///
+    /// Memory of unregistered buffer which frames in flight may still read.
+    ///
+    struct RetiredBuffer
+    {
+        UploadBufferDX12* Upload = nullptr;
+        ResidentRange Resident{ UploadRingAllocator::InvalidOffset, 0 };
+        uint64 Fence = 0;
+    };
+
+    ///
+    /// Resident ranges are taken first fit from the free list, then from the never used end of the resource.
+    ///
+    uint32 AllocateResident(uint32 size);
+    void FreeResident(const ResidentRange& range);
+    void ReleaseRetiredBuffers(uint64 completedFenceValue);
+
+    struct PendingUpdate
+    {
+        ConstantBuffer* Buffer = nullptr;
+        bool IsChanged = false; // Data changed since the last upload, so all frame copies are outdated.
+    };
+
+    HandleTable<ConstantBufferHandle, UploadBufferDX12*> m_constantBuffers;
+    HandleTable<ConstantBufferHandle, DynamicBuffer> m_dynamicBuffers;
+    std::unordered_map<uint32, PendingUpdate> m_updateQueue; // By handle, so that repeated updates of a buffer are merged.
     std::vector<TempCBData> m_registrationQueue;
+
+    UploadRingBufferDX12 m_uploadRing;
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_residentResource;
+    byte* m_residentData = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS m_residentGpuAddress = 0;
+    uint32 m_residentUsedSize = 0;
+    std::vector<ResidentRange> m_residentFreeRanges; // Sorted by offset, adjacent ranges are merged.
+    std::vector<RetiredBuffer> m_retiredBuffers;
+
+    uint64 m_frameFence = 1;
+    uint64 m_completedFence = 0;
+    uint32 m_frameUploadsCount = 0;
+    uint64 m_frameUploadedSize = 0;
+    uint32 m_frameSkippedCount = 0;
+    uint64 m_frameSkippedSize = 0;
 };
+
+inline uint32 ConstantBufferManagerDX12::GetFrameUploadsCount() const
+{
+    return m_frameUploadsCount;
+}
+
+inline uint64 ConstantBufferManagerDX12::GetFrameUploadedSize() const
+{
+    return m_frameUploadedSize;
+}
+
+inline uint32 ConstantBufferManagerDX12::GetFrameSkippedCount() const
+{
+    return m_frameSkippedCount;
+}
+
+inline uint64 ConstantBufferManagerDX12::GetFrameSkippedSize() const
+{
+    return m_frameSkippedSize;
+}
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "stdafx.h"
+
+#include "Render/DX12/Buffers/UploadRingBufferDX12.h"
+
+#include "Render/DX12/DXHelpers.h"
+#include "Render/DX12/StateDX.h"
+#include "Sources/External/Dx12Helpers/d3dx12.h"
+
+namespace Kioto::Renderer
+{
+UploadRingBufferDX12::~UploadRingBufferDX12()
+{
+    if (m_resource != nullptr)
+        m_resource->Unmap(0, nullptr);
+    m_data = nullptr;
+}
+
+void UploadRingBufferDX12::Init(const StateDX& state, uint32 capacity)
+{
+    m_allocator = UploadRingAllocator(capacity);
+
+    CD3DX12_HEAP_PROPERTIES hProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    CD3DX12_RESOURCE_DESC rDesc = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+    ThrowIfFailed(state.Device->CreateCommittedResource(
+        &hProps,
+        D3D12_HEAP_FLAG_NONE,
+        &rDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&m_resource)
+    ));
+    NAME_D3D12_OBJECT(m_resource);
+
+    CD3DX12_RANGE readRange(0, 0);
+    ThrowIfFailed(m_resource->Map(0, &readRange, reinterpret_cast<void**>(&m_data)));
+    m_gpuAddress = m_resource->GetGPUVirtualAddress();
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS UploadRingBufferDX12::Upload(const StateDX& state, const byte* data, uint32 size)
+{
+    uint32 offset = m_allocator.Allocate(size);
+    while (offset == UploadRingAllocator::InvalidOffset)
+    {
+        // Frames in flight hold the whole ring, the oldest one is waited for. Current frame alone must fit into the ring.
+        uint64 fenceValue = m_allocator.GetOldestFenceValue();
+        assert(fenceValue != 0 && "Constant data of the frame doesn't fit into the upload ring");
+        if (fenceValue == 0)
+            return 0;
+
+        if (state.Fence->GetCompletedValue() < fenceValue)
+        {
+            HANDLE fenceEventHandle = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+            if (fenceEventHandle == nullptr)
+            {
+                ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+            }
+            ThrowIfFailed(state.Fence->SetEventOnCompletion(fenceValue, fenceEventHandle));
+
+            WaitForSingleObjectEx(fenceEventHandle, INFINITE, false);
+            CloseHandle(fenceEventHandle);
+        }
+        m_allocator.Reclaim(fenceValue);
+        offset = m_allocator.Allocate(size);
+    }
+
+    memcpy(m_data + offset, data, size);
+    return m_gpuAddress + offset;
+}
+}
\ No newline at end of file
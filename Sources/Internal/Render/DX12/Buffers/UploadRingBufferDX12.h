@@ -0,0 +1,57 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "Core/CoreTypes.h"
+#include "Render/Buffers/UploadRingAllocator.h"
+
+namespace Kioto::Renderer
+{
+struct StateDX;
+
+///
+/// One upload resource shared by the data of all frames in flight, suballocated by UploadRingAllocator.
+///
+class UploadRingBufferDX12 final
+{
+public:
+    UploadRingBufferDX12() = default;
+    UploadRingBufferDX12(const UploadRingBufferDX12&) = delete;
+    UploadRingBufferDX12& operator=(const UploadRingBufferDX12&) = delete;
+    ~UploadRingBufferDX12();
+
+    void Init(const StateDX& state, uint32 capacity);
+
+    ///
+    /// Copy data to the ring and get its GPU address, valid until the current frame is completed. If the ring is full,
+    /// waits for the oldest frames in flight.
+    ///
+    D3D12_GPU_VIRTUAL_ADDRESS Upload(const StateDX& state, const byte* data, uint32 size);
+    void FinishFrame(uint64 fenceValue);
+    void Reclaim(uint64 completedFenceValue);
+
+    const UploadRingAllocator& GetAllocator() const;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_resource;
+    byte* m_data = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS m_gpuAddress = 0;
+    UploadRingAllocator m_allocator;
+};
+
+inline void UploadRingBufferDX12::FinishFrame(uint64 fenceValue)
+{
+    m_allocator.FinishFrame(fenceValue);
+}
+
+inline void UploadRingBufferDX12::Reclaim(uint64 completedFenceValue)
+{
+    m_allocator.Reclaim(completedFenceValue);
+}
+
+inline const UploadRingAllocator& UploadRingBufferDX12::GetAllocator() const
+{
+    return m_allocator;
+}
+}
\ No newline at end of file
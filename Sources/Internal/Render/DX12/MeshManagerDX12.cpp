@@ -15,14 +15,13 @@ MeshManagerDX12::MeshManagerDX12()
 MeshManagerDX12::~MeshManagerDX12()
 {
     for (auto& mesh : m_meshes)
-        SafeDelete(mesh.second);
-    m_meshes.clear();
+        SafeDelete(mesh);
+    m_meshes.Clear();
 }
 
 void MeshManagerDX12::RegisterMesh(Mesh* mesh)
 {
-    auto it = m_meshes.find(mesh->GetHandle());
-    if (it != m_meshes.end())
+    if (m_meshes.Contains(mesh->GetHandle()))
     {
         assert(false);
         return;
@@ -44,9 +43,7 @@ void MeshManagerDX12::ProcessRegistrationQueue(const StateDX& state)
 
 MeshDX12* MeshManagerDX12::Find(MeshHandle handle)
 {
-    auto it = m_meshes.find(handle);
-    if (it == m_meshes.end())
-        return nullptr;
-    return it->second;
+    MeshDX12** mesh = m_meshes.Find(handle);
+    return mesh != nullptr ? *mesh : nullptr;
 }
 }
\ No newline at end of file
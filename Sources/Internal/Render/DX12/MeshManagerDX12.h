@@ -1,8 +1,8 @@
 #pragma once
 
 #include <vector>
-#include <map>
 
+#include "Render/HandleTable.h"
 #include "Render/RendererPublic.h"
 
 namespace Kioto::Renderer
@@ -45,6 +45,6 @@ private:
     };
 
     std::vector<TempMeshData> m_meshQueue;
-    std::map<MeshHandle, MeshDX12*> m_meshes;
+    HandleTable<MeshHandle, MeshDX12*> m_meshes;
 };
 }
\ No newline at end of file
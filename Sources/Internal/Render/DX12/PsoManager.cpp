@@ -10,6 +10,7 @@
 #include "Render/DX12/Texture/TextureDX12.h"
 #include "Render/DX12/VertexLayoutManagerDX12.h"
 #include "Render/Material.h"
+#include "Render/PipelineCache.h"
 #include "Render/PipelineState.h"
 #include "Render/RenderPass/RenderPass.h"
 #include "Render/Shader.h"
@@ -104,31 +105,137 @@ D3D12_GRAPHICS_PIPELINE_STATE_DESC ParsePipelineState(Material* mat, const Rende
 
     return desc;
 }
+
+uint64 GetPipelineStateKey(const PipelineState& state, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+    uint64 shaderHash = PipelineCache::HashData(desc.VS.pShaderBytecode, desc.VS.BytecodeLength);
+    shaderHash = PipelineCache::HashData(desc.PS.pShaderBytecode, desc.PS.BytecodeLength, shaderHash);
+    uint32 rtvFormats[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+    for (uint32 i = 0; i < desc.NumRenderTargets; ++i)
+        rtvFormats[i] = static_cast<uint32>(desc.RTVFormats[i]);
+    return PipelineCache::ComputeKey(state, shaderHash, state.Shader->GetShaderData().vertexLayout, rtvFormats, desc.NumRenderTargets, static_cast<uint32>(desc.DSVFormat));
+}
+
+std::vector<byte> CopyBytecode(const D3D12_SHADER_BYTECODE& bytecode)
+{
+    const byte* data = static_cast<const byte*>(bytecode.pShaderBytecode);
+    return std::vector<byte>(data, data + bytecode.BytecodeLength);
+}
+}
+
+void PsoManager::Init(const std::string& cachePath, uint64 deviceTag, uint32 compileThreadsCount)
+{
+    m_cachePath = cachePath;
+    m_cache.SetDeviceTag(deviceTag);
+    m_cache.Load(m_cachePath);
+    if (compileThreadsCount > 0)
+        m_compileQueue.Start(compileThreadsCount);
+}
+
+void PsoManager::Shutdown()
+{
+    m_compileQueue.Stop();
+    if (m_cache.GetIsDirty() && !m_cachePath.empty())
+        m_cache.Save(m_cachePath);
 }
 
 void PsoManager::BuildPipelineState(const StateDX& state, Material* mat, const RenderPass* pass, const RootSignatureManager& sigManager, TextureManagerDX12* textureManager, ShaderManagerDX12* shaderManager, VertexLayoutManagerDX12* vertexLayoutManager, DXGI_FORMAT backBufferFromat, DXGI_FORMAT defaultDepthStencilFormat)
 {
-    uint64 key = GetKey(mat->GetHandle(), pass->GetHandle());
-    if (m_psos.find(key) != m_psos.end())
+    MaterialPsos& passPsos = m_psos[pass->GetHandle()];
+    if (passPsos.Contains(mat->GetHandle()))
         return;
 
     D3D12_GRAPHICS_PIPELINE_STATE_DESC stateDesc = ParsePipelineState(mat, pass, sigManager, textureManager, shaderManager, vertexLayoutManager, backBufferFromat, defaultDepthStencilFormat);
-    ID3D12PipelineState** pipeState = m_psos[key].GetAddressOf();
-    ThrowIfFailed(state.Device->CreateGraphicsPipelineState(&stateDesc, IID_PPV_ARGS(pipeState)));
+    uint64 key = GetPipelineStateKey(mat->GetPipelineState(pass->GetName()), stateDesc);
+    auto compiled = m_psosByKey.find(key);
+    if (compiled != m_psosByKey.end())
+    {
+        passPsos[mat->GetHandle()] = compiled->second;
+        return;
+    }
+
+    passPsos[mat->GetHandle()] = nullptr;
+    std::vector<PsoUser>& users = m_pendingUsers[key];
+    users.push_back({ pass->GetHandle(), mat->GetHandle() });
+    if (users.size() > 1)
+        return; // Another material has already requested the same state.
+
+    std::vector<byte> cachedBlob;
+    if (m_cache.Find(key, cachedBlob))
+    {
+        // Creation from the cached blob skips shader compilation in driver, so it is cheap enough for the render thread.
+        stateDesc.CachedPSO = { cachedBlob.data(), cachedBlob.size() };
+        PsoPtr pso;
+        if (SUCCEEDED(state.Device->CreateGraphicsPipelineState(&stateDesc, IID_PPV_ARGS(&pso))))
+        {
+            PublishPipelineState(key, pso);
+            return;
+        }
+        m_cache.Remove(key); // Blob of another driver version.
+        stateDesc.CachedPSO = {};
+    }
+
+    // Job owns everything the description points to, shaders and root signature may be released before it runs.
+    Microsoft::WRL::ComPtr<ID3D12Device> device = state.Device;
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature = stateDesc.pRootSignature;
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout(stateDesc.InputLayout.pInputElementDescs, stateDesc.InputLayout.pInputElementDescs + stateDesc.InputLayout.NumElements);
+    std::vector<byte> vs = CopyBytecode(stateDesc.VS);
+    std::vector<byte> ps = CopyBytecode(stateDesc.PS);
+    PipelineCache* cache = &m_cache;
+    m_compileQueue.Enqueue(key, [device, rootSignature, inputLayout, vs, ps, stateDesc, cache, key]() mutable
+    {
+        stateDesc.pRootSignature = rootSignature.Get();
+        stateDesc.InputLayout = { inputLayout.data(), static_cast<UINT>(inputLayout.size()) };
+        stateDesc.VS = { vs.data(), vs.size() };
+        stateDesc.PS = { ps.data(), ps.size() };
+
+        CompiledPso compiled;
+        compiled.Result = device->CreateGraphicsPipelineState(&stateDesc, IID_PPV_ARGS(&compiled.Pso));
+        Microsoft::WRL::ComPtr<ID3DBlob> blob;
+        if (SUCCEEDED(compiled.Result) && SUCCEEDED(compiled.Pso->GetCachedBlob(&blob)))
+        {
+            const byte* blobData = static_cast<const byte*>(blob->GetBufferPointer());
+            cache->Store(key, std::vector<byte>(blobData, blobData + blob->GetBufferSize()));
+        }
+        return compiled;
+    });
+
+    if (!m_compileQueue.GetIsStarted())
+        ProcessCompiledPipelineStates();
 }
 
-ID3D12PipelineState* PsoManager::GetPipelineState(MaterialHandle matHandle, RenderPassHandle renderPassHandle)
+void PsoManager::ProcessCompiledPipelineStates()
 {
-    uint64 key = GetKey(matHandle, renderPassHandle);
-    auto it = m_psos.find(key);
-    if (it == m_psos.end())
-        return nullptr;
-    return it->second.Get();
+    m_compileQueue.CollectCompleted([this](uint64 key, CompiledPso& compiled)
+    {
+        ThrowIfFailed(compiled.Result);
+        PublishPipelineState(key, compiled.Pso);
+    });
+}
+
+void PsoManager::PublishPipelineState(uint64 key, const PsoPtr& pso)
+{
+    m_psosByKey[key] = pso;
+    auto users = m_pendingUsers.find(key);
+    if (users == m_pendingUsers.end())
+        return;
+
+    for (const PsoUser& user : users->second)
+    {
+        MaterialPsos* passPsos = m_psos.Find(user.Pass);
+        PsoPtr* dst = passPsos != nullptr ? passPsos->Find(user.Material) : nullptr;
+        if (dst != nullptr)
+            *dst = pso;
+    }
+    m_pendingUsers.erase(users);
 }
 
-uint64 PsoManager::GetKey(MaterialHandle matHandle, RenderPassHandle renderPassHandle)
+ID3D12PipelineState* PsoManager::GetPipelineState(MaterialHandle matHandle, RenderPassHandle renderPassHandle)
 {
-    uint64 tmp = renderPassHandle.GetHandle();
-    return matHandle.GetHandle() | tmp << 32;
+    const MaterialPsos* passPsos = m_psos.Find(renderPassHandle);
+    if (passPsos == nullptr)
+        return nullptr;
+    const Microsoft::WRL::ComPtr<ID3D12PipelineState>* pso = passPsos->Find(matHandle);
+    return pso != nullptr ? pso->Get() : nullptr;
 }
 }
\ No newline at end of file
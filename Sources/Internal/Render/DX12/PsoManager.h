@@ -1,9 +1,14 @@
 #pragma once
 
 #include <d3d12.h>
-#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <wrl/client.h>
 
+#include "Render/HandleTable.h"
+#include "Render/PipelineCache.h"
+#include "Render/PipelineCompileQueue.h"
 #include "Render/RendererPublic.h"
 #include "Core/CoreTypes.h"
 
@@ -17,17 +22,60 @@ class RootSignatureManager;
 class VertexLayoutManagerDX12;
 struct StateDX;
 
+///
+/// Pipeline states by pass and material. States missing in the pipeline cache are compiled on the compile queue threads,
+/// GetPipelineState returns nullptr until the compiled state is published by ProcessCompiledPipelineStates.
+/// Materials with the same state, shaders and target formats share the state object.
+///
 class PsoManager
 {
 public:
     PsoManager() = default;
 
+    ///
+    /// Load pipeline cache written for the device tag and start compile threads. With no threads states are compiled in BuildPipelineState.
+    ///
+    void Init(const std::string& cachePath, uint64 deviceTag, uint32 compileThreadsCount);
+    ///
+    /// Wait for the running compilations and save the cache if new states were compiled.
+    ///
+    void Shutdown();
     void BuildPipelineState(const StateDX& state, Material* mat, const RenderPass* pass, const RootSignatureManager& sigManager, TextureManagerDX12* textureManager, ShaderManagerDX12* shaderManager, VertexLayoutManagerDX12* vertexLayoutManager, DXGI_FORMAT backBufferFromat, DXGI_FORMAT defaultDepthStencilFormat);
+    ///
+    /// Make states compiled since the last call available to GetPipelineState.
+    ///
+    void ProcessCompiledPipelineStates();
     ID3D12PipelineState* GetPipelineState(MaterialHandle matHandle, RenderPassHandle renderPassHandle);
+    uint32 GetPendingCount() const;
 
 private:
-    static uint64 GetKey(MaterialHandle matHandle, RenderPassHandle renderPassHandle);
+    using PsoPtr = Microsoft::WRL::ComPtr<ID3D12PipelineState>;
+    using MaterialPsos = HandleTable<MaterialHandle, PsoPtr>;
 
-    std::map<uint64, Microsoft::WRL::ComPtr<ID3D12PipelineState>> m_psos;
+    struct CompiledPso
+    {
+        PsoPtr Pso;
+        HRESULT Result = E_FAIL;
+    };
+
+    struct PsoUser
+    {
+        RenderPassHandle Pass;
+        MaterialHandle Material;
+    };
+
+    void PublishPipelineState(uint64 key, const PsoPtr& pso);
+
+    HandleTable<RenderPassHandle, MaterialPsos> m_psos; // Passes are few, so a table of materials per pass. Pending states are null.
+    std::unordered_map<uint64, PsoPtr> m_psosByKey;
+    std::unordered_map<uint64, std::vector<PsoUser>> m_pendingUsers; // Pass and material pairs waiting for the key compilation.
+    PipelineCache m_cache;
+    PipelineCompileQueue<CompiledPso> m_compileQueue;
+    std::string m_cachePath;
 };
+
+inline uint32 PsoManager::GetPendingCount() const
+{
+    return m_compileQueue.GetPendingCount();
+}
 }
\ No newline at end of file
@@ -11,12 +11,15 @@
 #include "Sources/External/IMGUI/imgui_impl_dx12.h"
 #include "Sources/External/IMGUI/imgui_impl_win32.h"
 
+#include "AssetsSystem/AssetsSystem.h"
+#include "Core/CoreHelpers.h"
 #include "Core/WindowsApplication.h"
 #include "Render/Buffers/EngineBuffers.h"
 #include "Render/DX12/Geometry/MeshDX12.h"
 #include "Render/DX12/KiotoDx12Mapping.h"
 #include "Render/Shader.h"
 #include "Render/Material.h"
+#include "Render/RenderOptions.h"
 #include "Render/RenderPass/RenderPass.h"
 
 namespace Kioto::Renderer
@@ -43,6 +46,21 @@ D3D12_VIEWPORT DXViewportFromKioto(const RectI& source)
     viewport.MaxDepth = 1.0f;
     return viewport;
 }
+
+uint64 GetPipelineCacheTag(IDXGIAdapter1* adapter)
+{
+    // Cached pipeline blobs are valid only for the same device and driver.
+    DXGI_ADAPTER_DESC1 desc;
+    ThrowIfFailed(adapter->GetDesc1(&desc));
+    uint64 tag = HashCombine(desc.VendorId, desc.DeviceId);
+    tag = HashCombine(tag, desc.SubSysId);
+    tag = HashCombine(tag, desc.Revision);
+
+    LARGE_INTEGER driverVersion = {};
+    if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+        tag = HashCombine(tag, static_cast<uint64>(driverVersion.QuadPart));
+    return tag;
+}
 }
 
 RendererDX12::RendererDX12()
@@ -51,7 +69,7 @@ RendererDX12::RendererDX12()
 
 void RendererDX12::Init(uint16 width, uint16 height)
 {
-    m_frameCommands.reserve(4096);
+    m_frameCommandLists.reserve(RenderOptions::MaxRenderPassesCount);
 
     UINT dxgiFactoryFlags = 0;
 #ifdef _DEBUG
@@ -109,6 +127,9 @@ void RendererDX12::Init(uint16 width, uint16 height)
     m_state.DsvDescriptorSize = m_state.Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
     m_state.SamplerDescriptorSize = m_state.Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
 
+    m_constantBufferManager.Init(m_state);
+    m_piplineStateManager.Init(AssetsSystem::GetAssetFullPath("PipelineCacheDX12.bin"), GetPipelineCacheTag(hardwareAdapter.Get()), RenderOptions::PipelineCompileThreadsCount);
+
     LoadPipeline();
     Resize(width, height);
 
@@ -145,10 +166,92 @@ void RendererDX12::ResourceTransition(StateDX& dxState, TextureHandle resourceHa
     tex->SetCurrentState(dxDstState);
 }
 
+void RendererDX12::SubmitRenderPacket(const SubmitRenderPacketCommand& packet)
+{
+    // Packets of a pass are sorted by state, so consecutive packets mostly share it and only the difference is set.
+    ID3D12PipelineState* pipelineState = m_piplineStateManager.GetPipelineState(packet.Material.GetHandle(), packet.Pass);
+    if (pipelineState == nullptr)
+    {
+        ++m_frameDrawsSkipped; // Pipeline state is still compiling.
+        return;
+    }
+    if (pipelineState != m_boundState.PipelineState)
+    {
+        m_state.CommandList->SetPipelineState(pipelineState);
+        m_boundState.PipelineState = pipelineState;
+    }
+
+    ID3D12RootSignature* rootSig = m_rootSignatureManager.GetRootSignature(packet.Shader);
+    if (rootSig != m_boundState.RootSignature)
+    {
+        m_state.CommandList->SetGraphicsRootSignature(rootSig);
+        m_boundState.RootSignature = rootSig;
+        m_boundState.RootParameters.clear(); // Changing root signature resets all bindings.
+    }
+
+    UINT currFrameInd = m_swapChain.GetCurrentFrameIndex();
+    UINT buffersCount = static_cast<UINT>(packet.ConstantBuffersCount);
+    for (uint32 i = 0; i < buffersCount; ++i)
+    {
+        UploadBufferDX12* buffer = m_constantBufferManager.FindBuffer(packet.GetConstantBufferHandles()[i]);
+        if (buffer == nullptr)
+        {
+            D3D12_GPU_VIRTUAL_ADDRESS address = m_constantBufferManager.GetFrameDataGpuAddress(m_state, packet.GetConstantBufferHandles()[i]);
+            if (m_boundState.SetRootParameter(i, address))
+                m_state.CommandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(i), address);
+        }
+        else
+        {
+            SetDescriptorHeap(buffer->GetDescriptorHeap());
+            D3D12_GPU_DESCRIPTOR_HANDLE table = buffer->GetGpuDescriptorHandleForFrame(currFrameInd);
+            if (m_boundState.SetRootParameter(i, table.ptr))
+                m_state.CommandList->SetGraphicsRootDescriptorTable(i, table);
+        }
+    }
+    UINT constantsCount = static_cast<UINT>(packet.UniformConstantsCount);
+    for (uint32 i = 0; i < constantsCount; ++i)
+    {
+        if (m_boundState.SetRootParameter(buffersCount + i, packet.GetUniformConstants()[i]))
+            m_state.CommandList->SetGraphicsRoot32BitConstant(buffersCount + i, packet.GetUniformConstants()[i], 0);
+    }
+
+    ID3D12DescriptorHeap* currTexDescriptorHeap = m_textureManager.GetTextureHeap(packet.TextureSet);
+    if (currTexDescriptorHeap != nullptr) // [a_vorontcov] TODO: No difference if one messed up with texset or if there is no textures for the draw. Not good at all. Rethink.
+    {
+        SetDescriptorHeap(currTexDescriptorHeap);
+        D3D12_GPU_DESCRIPTOR_HANDLE table = currTexDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+        if (m_boundState.SetRootParameter(buffersCount + constantsCount, table.ptr))
+            m_state.CommandList->SetGraphicsRootDescriptorTable(buffersCount + constantsCount, table);
+    }
+
+    MeshDX12* currGeometry = m_meshManager.Find(packet.Mesh);
+    if (currGeometry != m_boundState.Mesh)
+    {
+        m_state.CommandList->IASetVertexBuffers(0, 1, &currGeometry->GetVertexBufferView());
+        m_state.CommandList->IASetIndexBuffer(&currGeometry->GetIndexBufferView());
+        if (m_boundState.Mesh == nullptr)
+            m_state.CommandList->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_boundState.Mesh = currGeometry;
+    }
+
+    m_state.CommandList->DrawIndexedInstanced(currGeometry->GetIndexCount(), packet.InstanceCount, 0, 0, 0);
+}
+
+void RendererDX12::SetDescriptorHeap(ID3D12DescriptorHeap* heap)
+{
+    if (heap == m_boundState.DescriptorHeap)
+        return;
+    ID3D12DescriptorHeap* heaps[] = { heap };
+    m_state.CommandList->SetDescriptorHeaps(_countof(heaps), heaps);
+    m_boundState.DescriptorHeap = heap;
+    m_boundState.RootParameters.clear(); // Tables set before point to the previous heap.
+}
+
 void RendererDX12::Shutdown()
 {
     if (m_state.Device != nullptr)
         WaitForGPU();
+    m_piplineStateManager.Shutdown();
 
     if (!m_isTearingSupported)
         ThrowIfFailed(m_swapChain.SetFullscreenState(false, nullptr));
@@ -290,6 +393,8 @@ void RendererDX12::Update(float32 dt)
 
 void RendererDX12::StartFrame()
 {
+    m_piplineStateManager.ProcessCompiledPipelineStates();
+
     ImGui::ImplDX12NewFrame();
     ImGui::ImplWinNewFrame();
     ImGui::NewFrame();
@@ -306,117 +411,79 @@ void RendererDX12::Present()
     m_meshManager.ProcessRegistrationQueue(m_state);
 
     m_constantBufferManager.ProcessRegistrationQueue(m_state);
-    m_constantBufferManager.ProcessBufferUpdates(m_swapChain.GetCurrentFrameIndex());
+    m_constantBufferManager.ProcessBufferUpdates(m_swapChain.GetCurrentFrameIndex(), m_state.Fence->GetCompletedValue(), m_state.CurrentFence + 1);
+
+    m_boundState.Reset();
+    m_frameDrawsSkipped = 0;
 
     auto toRt = CD3DX12_RESOURCE_BARRIER::Transition(m_swapChain.GetCurrentBackBuffer()->Resource.Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
     m_state.CommandList->ResourceBarrier(1, &toRt);
 
-    for (auto& cmd : m_frameCommands)
+    for (const CommandList* commandList : m_frameCommandLists)
     {
-        assert(cmd.CommandType != eRenderCommandType::eInvalidCommand);
-        if (cmd.CommandType == eRenderCommandType::eSetRenderTargets)
+        for (const RenderCommandHeader& cmd : *commandList)
         {
-            const SetRenderTargetsCommand& srtCommand = std::get<SetRenderTargetsCommand>(cmd.Command);
-            D3D12_CPU_DESCRIPTOR_HANDLE rtHandle;
-            D3D12_CPU_DESCRIPTOR_HANDLE dsHandle;
-            if (srtCommand.GetRenderTarget(0) == DefaultBackBufferHandle)
-                rtHandle = m_swapChain.GetCurrentBackBufferCPUHandle(m_state);
-            else
-                rtHandle = m_textureManager.GetRtvHandle(srtCommand.GetRenderTarget(0));
-
-            if (srtCommand.GetDepthStencil() == DefaultDepthStencilHandle)
-                dsHandle = m_swapChain.GetDepthStencilCPUHandle();
-            else
+            assert(cmd.CommandType != eRenderCommandType::eInvalidCommand);
+            if (cmd.CommandType == eRenderCommandType::eSetRenderTargets)
             {
-                assert(false);
-                // [a_vorontcov] TODO: ToBeImplemented dsHandle = m_textureManager.GetDsvHandle(srtCommand.GetDepthStencil());
-            }
-
-            m_state.CommandList->RSSetScissorRects(1, &DXRectFromKioto(srtCommand.Scissor));
-            m_state.CommandList->RSSetViewports(1, &DXViewportFromKioto(srtCommand.Viewport));
-
-            if (srtCommand.ClearColor)
-                m_state.CommandList->ClearRenderTargetView(rtHandle, srtCommand.ClearColorValue.data, 0, nullptr);
-            if (srtCommand.ClearDepth)
-                m_state.CommandList->ClearDepthStencilView(dsHandle, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
+                const SetRenderTargetsCommand& srtCommand = cmd.GetCommand<SetRenderTargetsCommand>();
+                D3D12_CPU_DESCRIPTOR_HANDLE rtHandle;
+                D3D12_CPU_DESCRIPTOR_HANDLE dsHandle;
+                if (srtCommand.GetRenderTarget(0) == DefaultBackBufferHandle)
+                    rtHandle = m_swapChain.GetCurrentBackBufferCPUHandle(m_state);
+                else
+                    rtHandle = m_textureManager.GetRtvHandle(srtCommand.GetRenderTarget(0));
 
-            m_state.CommandList->OMSetRenderTargets(1, &rtHandle, false, &dsHandle);
-        }
-        else if (cmd.CommandType == eRenderCommandType::eEndRenderPass)
-        {
-        }
-        else if (cmd.CommandType == eRenderCommandType::eResourceTransitonCommand)
-        {
-            const ResourceTransitonCommand& transitionCommand = std::get<ResourceTransitonCommand>(cmd.Command);
-            ResourceTransition(m_state, transitionCommand.ResourceHandle, transitionCommand.DestState);
-        }
-        else if (cmd.CommandType == eRenderCommandType::eSubmitRenderPacket)
-        {
-            const RenderPacket& packet = std::get<SubmitRenderPacketCommand>(cmd.Command).Packet;
+                if (srtCommand.GetDepthStencil() == DefaultDepthStencilHandle)
+                    dsHandle = m_swapChain.GetDepthStencilCPUHandle();
+                else
+                {
+                    assert(false);
+                    // [a_vorontcov] TODO: ToBeImplemented dsHandle = m_textureManager.GetDsvHandle(srtCommand.GetDepthStencil());
+                }
 
-            ID3D12PipelineState* pipelineState = m_piplineStateManager.GetPipelineState(packet.Material.GetHandle(), packet.Pass);
-            m_state.CommandList->SetPipelineState(pipelineState);
+                m_state.CommandList->RSSetScissorRects(1, &DXRectFromKioto(srtCommand.Scissor));
+                m_state.CommandList->RSSetViewports(1, &DXViewportFromKioto(srtCommand.Viewport));
 
-            ID3D12RootSignature* rootSig = m_rootSignatureManager.GetRootSignature(packet.Shader);
-            m_state.CommandList->SetGraphicsRootSignature(rootSig);
+                if (srtCommand.ClearColor)
+                    m_state.CommandList->ClearRenderTargetView(rtHandle, srtCommand.ClearColorValue.data, 0, nullptr);
+                if (srtCommand.ClearDepth)
+                    m_state.CommandList->ClearDepthStencilView(dsHandle, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
-            UINT currFrameInd = m_swapChain.GetCurrentFrameIndex();
-            UINT buffersCount = static_cast<UINT>(packet.ConstantBufferHandles.size());
-            for (uint32 i = 0; i < buffersCount; ++i)
+                m_state.CommandList->OMSetRenderTargets(1, &rtHandle, false, &dsHandle);
+            }
+            else if (cmd.CommandType == eRenderCommandType::eEndRenderPass)
             {
-                UploadBufferDX12* buffer = m_constantBufferManager.FindBuffer(packet.ConstantBufferHandles[i]);
-                if (!buffer->HasDescriptorHeap())
-                {
-                    m_state.CommandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(i), buffer->GetFrameDataGpuAddress(currFrameInd));
-                }
-                else
-                {
-                    ID3D12DescriptorHeap* heaps[] = { buffer->GetDescriptorHeap() };
-                    m_state.CommandList->SetDescriptorHeaps(_countof(heaps), heaps);
-
-                    m_state.CommandList->SetGraphicsRootDescriptorTable(i, buffer->GetGpuDescriptorHandleForFrame(currFrameInd));
-                }
             }
-            UINT constantsCount = static_cast<UINT>(packet.UniformConstants.size());
-            for (uint32 i = 0; i < constantsCount; ++i)
-                m_state.CommandList->SetGraphicsRoot32BitConstant(buffersCount + i, packet.UniformConstants[i], 0);
-
-            ID3D12DescriptorHeap* currTexDescriptorHeap = m_textureManager.GetTextureHeap(packet.TextureSet);
-            if (currTexDescriptorHeap != nullptr) // [a_vorontcov] TODO: No difference if one messed up with texset or if there is no textures for the draw. Not good at all. Rethink.
+            else if (cmd.CommandType == eRenderCommandType::eResourceTransitonCommand)
             {
-                ID3D12DescriptorHeap* descHeap[] = { currTexDescriptorHeap };
-                m_state.CommandList->SetDescriptorHeaps(_countof(descHeap), descHeap);
-
-                m_state.CommandList->SetGraphicsRootDescriptorTable(buffersCount + constantsCount, currTexDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+                const ResourceTransitonCommand& transitionCommand = cmd.GetCommand<ResourceTransitonCommand>();
+                ResourceTransition(m_state, transitionCommand.ResourceHandle, transitionCommand.DestState);
+            }
+            else if (cmd.CommandType == eRenderCommandType::eSubmitRenderPacket)
+            {
+                SubmitRenderPacket(cmd.GetCommand<SubmitRenderPacketCommand>());
+            }
+            else if (cmd.CommandType == eRenderCommandType::eBeginGpuEvent)
+            {
+                const BeginGpuEventCommand& evCommand = cmd.GetCommand<BeginGpuEventCommand>();
+                m_profiler.BeginGpuEvent(m_state.CommandList.Get(), StringTable::GetString(evCommand.Name));
+            }
+            else if (cmd.CommandType == eRenderCommandType::eEndGpuEvent)
+            {
+                m_profiler.EndGpuEvent(m_state.CommandList.Get());
+            }
+            else if (cmd.CommandType == eRenderCommandType::eSetGpuMarker)
+            {
+                const SetGpuMarkerCommand& smCommand = cmd.GetCommand<SetGpuMarkerCommand>();
+                m_profiler.SetMarker(m_state.CommandList.Get(), StringTable::GetString(smCommand.Name));
+            }
+            else
+            {
+                assert(false);
             }
 
-            MeshDX12* currGeometry = m_meshManager.Find(packet.Mesh);
-
-            m_state.CommandList->IASetVertexBuffers(0, 1, &currGeometry->GetVertexBufferView());
-            m_state.CommandList->IASetIndexBuffer(&currGeometry->GetIndexBufferView());
-            m_state.CommandList->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-            m_state.CommandList->DrawIndexedInstanced(currGeometry->GetIndexCount(), 1, 0, 0, 0);
-        }
-        else if (cmd.CommandType == eRenderCommandType::eBeginGpuEvent)
-        {
-            const BeginGpuEventCommand& evCommand = std::get<BeginGpuEventCommand>(cmd.Command);
-            m_profiler.BeginGpuEvent(m_state.CommandList.Get(), evCommand.Name.c_str());
         }
-        else if (cmd.CommandType == eRenderCommandType::eEndGpuEvent)
-        {
-            m_profiler.EndGpuEvent(m_state.CommandList.Get());
-        }
-        else if (cmd.CommandType == eRenderCommandType::eSetGpuMarker)
-        {
-            const SetGpuMarkerCommand& smCommand = std::get<SetGpuMarkerCommand>(cmd.Command);
-            m_profiler.SetMarker(m_state.CommandList.Get(), smCommand.Name.c_str());
-        }
-        else
-        {
-            assert(false);
-        }
-
     }
 
     RenderImGui();
@@ -431,8 +498,16 @@ void RendererDX12::Present()
 
     m_state.FenceValues[m_swapChain.GetCurrentFrameIndex()] = ++m_state.CurrentFence;
     m_state.CommandQueue->Signal(m_state.Fence.Get(), m_state.CurrentFence);
+    m_constantBufferManager.FinishFrame(m_state.CurrentFence);
+
+    m_lastFrameStats.ConstantBuffersUploaded = m_constantBufferManager.GetFrameUploadsCount();
+    m_lastFrameStats.ConstantDataUploaded = m_constantBufferManager.GetFrameUploadedSize();
+    m_lastFrameStats.ConstantBuffersSkipped = m_constantBufferManager.GetFrameSkippedCount();
+    m_lastFrameStats.ConstantDataSkipped = m_constantBufferManager.GetFrameSkippedSize();
+    m_lastFrameStats.DrawsSkipped = m_frameDrawsSkipped;
+    m_lastFrameStats.PipelineStatesCompiling = m_piplineStateManager.GetPendingCount();
 
-    m_frameCommands.clear();
+    m_frameCommandLists.clear();
 
     // [a_vorontcov] Check if we can move to next frame.
     m_swapChain.ProceedToNextFrame();
@@ -529,6 +604,11 @@ void RendererDX12::RegisterTexture(Texture* texture)
     m_textureManager.RegisterTexture(texture);
 }
 
+void RendererDX12::UnregisterTexture(Texture* texture)
+{
+    m_textureManager.UnregisterTexture(texture->GetHandle());
+}
+
 void RendererDX12::RegisterShader(Shader* shader)
 {
     m_shaderManager.RegisterShader(shader);
@@ -568,9 +648,9 @@ void RendererDX12::RegisterMesh(Mesh* mesh)
     m_meshManager.RegisterMesh(mesh);
 }
 
-void RendererDX12::SubmitRenderCommands(const std::vector<RenderCommand>& commandList) // [a_vorontcov] Not const and splice would be better. https://stackoverflow.com/questions/1449703/how-to-append-a-listt-object-to-another
+void RendererDX12::SubmitRenderCommands(const CommandList* commandList)
 {
-    m_frameCommands.insert(m_frameCommands.end(), commandList.begin(), commandList.end());
+    m_frameCommandLists.push_back(commandList);
 }
 
 void RendererDX12::QueueConstantBufferForUpdate(ConstantBuffer& buffer)
@@ -583,6 +663,11 @@ void RendererDX12::RegisterConstantBuffer(ConstantBuffer& buffer)
     m_constantBufferManager.RegisterConstantBuffer(&buffer);
 }
 
+void RendererDX12::UnregisterConstantBuffer(ConstantBuffer& buffer)
+{
+    m_constantBufferManager.UnregisterConstantBuffer(&buffer);
+}
+
 void RendererDX12::SetTimeBuffer(ConstantBufferHandle handle)
 {
 }
@@ -592,4 +677,9 @@ void RendererDX12::RegisterRenderObject(RenderObject& renderObject)
     m_constantBufferManager.RegisterRenderObject(renderObject);
 }
 
+void RendererDX12::UnregisterRenderObject(RenderObject& renderObject)
+{
+    m_constantBufferManager.UnregisterRenderObject(renderObject);
+}
+
 }
\ No newline at end of file
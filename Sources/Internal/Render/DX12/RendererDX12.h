@@ -16,6 +16,7 @@
 #include "Render/DX12/VertexLayoutManagerDX12.h"
 #include "Render/DX12/Texture/TextureManagerDX12.h"
 #include "Render/RenderCommand.h"
+#include "Render/RenderStats.h"
 #include "Render/RendererPublic.h"
 
 namespace Kioto
@@ -53,6 +54,7 @@ public:
     void StartFrame();
 
     void RegisterTexture(Texture* texture);
+    void UnregisterTexture(Texture* texture);
     void RegisterShader(Shader* shader);
     void RegisterMaterial(Material* material);
     void BuildMaterialForPass(Material& mat, const RenderPass* pass);
@@ -60,21 +62,45 @@ public:
 
     void RegisterRenderPass(RenderPass* renderPass);
     void RegisterRenderObject(RenderObject& renderObject);
+    void UnregisterRenderObject(RenderObject& renderObject);
 
     void RegisterTextureSet(TextureSet& set);
     void QueueTextureSetForUpdate(const TextureSet& set);
 
     void RegisterConstantBuffer(ConstantBuffer& buffer);
+    void UnregisterConstantBuffer(ConstantBuffer& buffer);
     void QueueConstantBufferForUpdate(ConstantBuffer& buffer);
 
-    void SubmitRenderCommands(const std::vector<RenderCommand>& commandList);
+    void SubmitRenderCommands(const CommandList* commandList);
 
     TextureHandle GetCurrentBackBufferHandle() const;
     TextureHandle GetDepthStencilHandle() const;
 
     void SetTimeBuffer(ConstantBufferHandle handle);
 
+    ///
+    /// Get counters of the last presented frame. Only constant buffer uploads are counted by this backend.
+    ///
+    const RenderStats& GetLastFrameStats() const;
+
 private:
+    ///
+    /// State set to the command list by the previous draws of the frame. Draws set only what differs from it.
+    ///
+    struct BoundState
+    {
+        static constexpr uint64 InvalidRootParameter = -1;
+
+        ID3D12PipelineState* PipelineState = nullptr;
+        ID3D12RootSignature* RootSignature = nullptr;
+        ID3D12DescriptorHeap* DescriptorHeap = nullptr;
+        MeshDX12* Mesh = nullptr;
+        std::vector<uint64> RootParameters; // Gpu address, descriptor table start or 32 bit constant of every root parameter.
+
+        void Reset();
+        bool SetRootParameter(uint32 index, uint64 value); // Return true if the parameter must be set to the command list.
+    };
+
     void InitImGui();
     void RenderImGui();
     void ShutdownImGui();
@@ -85,9 +111,12 @@ private:
     void LogOutputDisplayModes(IDXGIOutput* output, DXGI_FORMAT format);
     void LoadPipeline();
     void ResourceTransition(StateDX& dxState, TextureHandle resourceHandle, eResourceState destState);
+    void SubmitRenderPacket(const SubmitRenderPacketCommand& packet);
+    void SetDescriptorHeap(ID3D12DescriptorHeap* heap);
 
-    std::vector<RenderCommand> m_frameCommands;
+    std::vector<const CommandList*> m_frameCommandLists; // Lists live in frame memory, they are read in place in Present.
     GpuProfiler<PixProfiler> m_profiler;
+    BoundState m_boundState;
 
     TextureManagerDX12 m_textureManager;
     StateDX m_state;
@@ -105,8 +134,35 @@ private:
     bool m_isFullScreen = false;
 
     ID3D12DescriptorHeap* m_imguiDescriptorHeap = nullptr;
+
+    uint32 m_frameDrawsSkipped = 0;
+    RenderStats m_lastFrameStats;
 };
 
+inline const RenderStats& RendererDX12::GetLastFrameStats() const
+{
+    return m_lastFrameStats;
+}
+
+inline void RendererDX12::BoundState::Reset()
+{
+    PipelineState = nullptr;
+    RootSignature = nullptr;
+    DescriptorHeap = nullptr;
+    Mesh = nullptr;
+    RootParameters.clear();
+}
+
+inline bool RendererDX12::BoundState::SetRootParameter(uint32 index, uint64 value)
+{
+    if (index >= RootParameters.size())
+        RootParameters.resize(index + 1, InvalidRootParameter);
+    if (RootParameters[index] == value)
+        return false;
+    RootParameters[index] = value;
+    return true;
+}
+
 inline TextureHandle RendererDX12::GetCurrentBackBufferHandle() const
 {
     return m_swapChain.GetCurrentBackBufferHandle();
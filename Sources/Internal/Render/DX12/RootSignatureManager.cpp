@@ -89,9 +89,7 @@ void RootSignatureManager::CreateRootSignature(const StateDX& state, const Shade
 
 ID3D12RootSignature* RootSignatureManager::GetRootSignature(ShaderHandle handle) const
 {
-    auto it = m_rootSignatures.find(handle);
-    if (it != m_rootSignatures.cend())
-        return it->second.Get();
-    return nullptr;
+    const Microsoft::WRL::ComPtr<ID3D12RootSignature>* rootSignature = m_rootSignatures.Find(handle);
+    return rootSignature != nullptr ? rootSignature->Get() : nullptr;
 }
 }
\ No newline at end of file
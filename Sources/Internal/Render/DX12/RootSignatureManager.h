@@ -1,9 +1,9 @@
 #pragma once
 
 #include <d3d12.h>
-#include <map>
 #include <wrl/client.h>
 
+#include "Render/HandleTable.h"
 #include "Render/RendererPublic.h"
 #include "Render/ShaderData.h"
 
@@ -18,6 +18,6 @@ public:
     ID3D12RootSignature* GetRootSignature(ShaderHandle handle) const;
 
 private:
-    std::map<ShaderHandle, Microsoft::WRL::ComPtr<ID3D12RootSignature>> m_rootSignatures;
+    HandleTable<ShaderHandle, Microsoft::WRL::ComPtr<ID3D12RootSignature>> m_rootSignatures;
 };
 }
\ No newline at end of file
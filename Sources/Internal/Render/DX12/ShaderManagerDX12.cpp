@@ -12,8 +12,7 @@ namespace Kioto::Renderer
 {
 void ShaderManagerDX12::RegisterShader(Shader* shader)
 {
-    auto it = m_shaders.find(shader->GetHandle());
-    if (it != m_shaders.cend())
+    if (m_shaders.Contains(shader->GetHandle()))
         return;
     shader->SetHandle(GetNewHandle());
 
@@ -36,11 +35,10 @@ void ShaderManagerDX12::RegisterShader(Shader* shader)
 
 const CD3DX12_SHADER_BYTECODE* ShaderManagerDX12::GetShaderBytecode(ShaderHandle handle, ShaderProgramType type) const
 {
-    auto it = m_shaders.find(handle);
-    if (it == m_shaders.cend())
+    const std::vector<ShaderDX12>* shaders = m_shaders.Find(handle);
+    if (shaders == nullptr)
         return nullptr;
-    auto& shaders = it->second;
-    for (auto& dxShader : shaders)
+    for (auto& dxShader : *shaders)
     {
         if (dxShader.GetType() == type)
             return &dxShader.GetBytecode();
@@ -50,10 +48,7 @@ const CD3DX12_SHADER_BYTECODE* ShaderManagerDX12::GetShaderBytecode(ShaderHandle
 
 const std::vector<ShaderDX12>* ShaderManagerDX12::GetDxShaders(ShaderHandle handle) const
 {
-    auto it = m_shaders.find(handle);
-    if (it == m_shaders.cend())
-        return nullptr;
-    return &it->second;
+    return m_shaders.Find(handle);
 }
 
 ShaderDX12 ShaderManagerDX12::CompileDXShader(const Shader& shader, const std::string& entryName, const std::string& shaderModel)
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <map>
-
+#include "Render/HandleTable.h"
 #include "Render/RendererPublic.h"
 #include "Render/DX12/ShaderDX12.h"
 
@@ -16,7 +15,7 @@ public:
     const std::vector<ShaderDX12>* GetDxShaders(ShaderHandle handle) const;
 
 private:
-    std::map<ShaderHandle, std::vector<ShaderDX12>> m_shaders;
+    HandleTable<ShaderHandle, std::vector<ShaderDX12>> m_shaders;
 
     ShaderDX12 CompileDXShader(const Shader& shader, const std::string& entryName, const std::string& shaderModel);
 
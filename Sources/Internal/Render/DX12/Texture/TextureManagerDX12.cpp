@@ -2,6 +2,8 @@
 
 #include "Render/DX12/Texture/TextureManagerDX12.h"
 
+#include <algorithm>
+
 #include "Render/DX12/StateDX.h"
 #include "Render/DX12/Texture/TextureDX12.h"
 #include "Render/Texture/Texture.h"
@@ -22,8 +24,7 @@ TextureManagerDX12::TextureManagerDX12()
 
 void TextureManagerDX12::RegisterTexture(Texture* texture)
 {
-    auto it = m_textures.find(texture->GetHandle());
-    if (it != m_textures.end())
+    if (m_textures.Contains(texture->GetHandle()))
     {
         throw "Texture Already Registered";
         return;
@@ -43,8 +44,8 @@ void TextureManagerDX12::RegisterTexture(Texture* texture)
 TextureManagerDX12::~TextureManagerDX12()
 {
     for (auto& tex : m_textures)
-        delete tex.second;
-    m_textures.clear();
+        delete tex;
+    m_textures.Clear();
 }
 
 void TextureManagerDX12::InitRtvHeap(const StateDX& state)
@@ -58,8 +59,8 @@ void TextureManagerDX12::InitRtvHeap(const StateDX& state)
 
 void TextureManagerDX12::UpdateTextureSetHeap(const StateDX& state, const TextureSet& texSet)
 {
-    if (m_textureHeaps.find(texSet.GetHandle()) != m_textureHeaps.end())
-        m_textureHeaps[texSet.GetHandle()].Reset();
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>& heap = m_textureHeaps[texSet.GetHandle()];
+    heap.Reset();
 
     D3D12_DESCRIPTOR_HEAP_DESC heapDescr = {};
     heapDescr.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
@@ -67,16 +68,16 @@ void TextureManagerDX12::UpdateTextureSetHeap(const StateDX& state, const Textur
     heapDescr.NumDescriptors = texSet.GetTexturesCount();
 
     // [a_vorontcov] TODO: maybe reuse the same heap and overwrite descriptors?
-    ThrowIfFailed(state.Device->CreateDescriptorHeap(&heapDescr, IID_PPV_ARGS(&m_textureHeaps[texSet.GetHandle()])));
+    ThrowIfFailed(state.Device->CreateDescriptorHeap(&heapDescr, IID_PPV_ARGS(&heap)));
 
-    CD3DX12_CPU_DESCRIPTOR_HANDLE handle(m_textureHeaps[texSet.GetHandle()]->GetCPUDescriptorHandleForHeapStart());
+    CD3DX12_CPU_DESCRIPTOR_HANDLE handle(heap->GetCPUDescriptorHandleForHeapStart());
     for (uint32 i = 0; i < texSet.GetTexturesCount(); ++i)
     {
         const Texture* kiotoTex = texSet.GetTexture(i);
-        auto it = m_textures.find(kiotoTex->GetHandle());
-        if (it == m_textures.end())
+        TextureDX12** it = m_textures.Find(kiotoTex->GetHandle());
+        if (it == nullptr)
             throw "ololo";
-        TextureDX12* dxTex = (*it).second;
+        TextureDX12* dxTex = *it;
 
         D3D12_SHADER_RESOURCE_VIEW_DESC texDescr = {};
         texDescr.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
@@ -93,27 +94,21 @@ void TextureManagerDX12::UpdateTextureSetHeap(const StateDX& state, const Textur
 
 ID3D12DescriptorHeap* TextureManagerDX12::GetTextureHeap(TextureSetHandle handle) const
 {
-    auto it = m_textureHeaps.find(handle);
-    if (it != m_textureHeaps.cend())
-        return it->second.Get();
-    return nullptr;
+    const Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>* heap = m_textureHeaps.Find(handle);
+    return heap != nullptr ? heap->Get() : nullptr;
 }
 
 TextureDX12* TextureManagerDX12::FindTexture(TextureHandle handle)
 {
-    auto it = m_textures.find(handle);
-    if (it != m_textures.cend())
-        return it->second;
-    it = m_notOwningTextures.find(handle);
-    if (it != m_notOwningTextures.cend())
-        return it->second;
-    return nullptr;
+    TextureDX12** tex = m_textures.Find(handle);
+    if (tex == nullptr)
+        tex = m_notOwningTextures.Find(handle);
+    return tex != nullptr ? *tex : nullptr;
 }
 
 void TextureManagerDX12::RegisterTextureWithoutOwnership(TextureDX12* texture)
 {
-    auto it = m_notOwningTextures.find(texture->GetHandle());
-    if (it != m_notOwningTextures.end())
+    if (m_notOwningTextures.Contains(texture->GetHandle()))
     {
         throw "Texture Already Registered";
         return;
@@ -121,6 +116,24 @@ void TextureManagerDX12::RegisterTextureWithoutOwnership(TextureDX12* texture)
     m_notOwningTextures[texture->GetHandle()] = texture;
 }
 
+void TextureManagerDX12::UnregisterTexture(TextureHandle handle)
+{
+    TextureDX12** it = m_textures.Find(handle);
+    if (it == nullptr)
+        return;
+
+    TextureDX12* tex = *it;
+    m_textureQueue.erase(std::remove(m_textureQueue.begin(), m_textureQueue.end(), tex), m_textureQueue.end());
+    const uint16* rtvOffset = m_rtvHeapOffsets.Find(handle);
+    if (rtvOffset != nullptr)
+    {
+        m_freeRtvOffsets.push_back(*rtvOffset);
+        m_rtvHeapOffsets.Remove(handle);
+    }
+    m_textures.Remove(handle);
+    delete tex;
+}
+
 void TextureManagerDX12::ProcessRegistationQueue(const StateDX& state)
 {
     for (auto& tex : m_textureQueue)
@@ -128,13 +141,21 @@ void TextureManagerDX12::ProcessRegistationQueue(const StateDX& state)
         tex->Create(state.Device.Get(), state.CommandList.Get());
         if (tex->GetIsFromMemoryAsset() && ((tex->GetDx12TextureFlags() & D3D12_RESOURCE_FLAGS::D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0))
         {
-            assert(m_rtvHeapOffsets.count(tex->GetHandle()) == 0);
-            m_rtvHeapOffsets[tex->GetHandle()] = m_currentRtvOffset;
+            assert(!m_rtvHeapOffsets.Contains(tex->GetHandle()));
+            uint16 rtvOffset = m_currentRtvOffset;
+            if (!m_freeRtvOffsets.empty())
+            {
+                rtvOffset = m_freeRtvOffsets.back();
+                m_freeRtvOffsets.pop_back();
+            }
+            else
+            {
+                m_currentRtvOffset += state.RtvDescriptorSize;
+            }
+            m_rtvHeapOffsets[tex->GetHandle()] = rtvOffset;
 
             CD3DX12_CPU_DESCRIPTOR_HANDLE handle(m_rtvHeap->GetCPUDescriptorHandleForHeapStart());
-            handle.Offset(m_currentRtvOffset);
-
-            m_currentRtvOffset += state.RtvDescriptorSize;
+            handle.Offset(rtvOffset);
 
             D3D12_RENDER_TARGET_VIEW_DESC texDescr = {};
             texDescr.Format = tex->Resource->GetDesc().Format;
@@ -168,9 +189,10 @@ void TextureManagerDX12::ProcessTextureSetUpdates(const StateDX& state)
 
 D3D12_CPU_DESCRIPTOR_HANDLE TextureManagerDX12::GetRtvHandle(TextureHandle handle) const
 {
-    assert(m_rtvHeapOffsets.count(handle) == 1 && "The texture is not registered as a rtv");
+    const uint16* offset = m_rtvHeapOffsets.Find(handle);
+    assert(offset != nullptr && "The texture is not registered as a rtv");
     CD3DX12_CPU_DESCRIPTOR_HANDLE rtvHandle(m_rtvHeap->GetCPUDescriptorHandleForHeapStart());
-    rtvHandle.Offset(m_rtvHeapOffsets.at(handle));
+    rtvHandle.Offset(*offset);
     return rtvHandle;
 }
 
@@ -1,10 +1,10 @@
 #pragma once
 
 #include <d3d12.h>
-#include <map>
 #include <vector>
 #include <wrl/client.h>
 
+#include "Render/HandleTable.h"
 #include "Render/RendererPublic.h"
 
 namespace Kioto::Renderer
@@ -24,6 +24,10 @@ public:
     ~TextureManagerDX12();
     void RegisterTexture(Texture* texture);
     void RegisterTextureWithoutOwnership(TextureDX12* texture);
+    ///
+    /// Delete owned texture right away and free its render target view for the next registered texture.
+    ///
+    void UnregisterTexture(TextureHandle handle);
     void ProcessRegistationQueue(const StateDX& state);
     void InitRtvHeap(const StateDX& state);
     void UpdateTextureSetHeap(const StateDX& state, const TextureSet& texSet);
@@ -36,16 +40,17 @@ public:
     D3D12_CPU_DESCRIPTOR_HANDLE GetRtvHandle(TextureHandle handle) const;
 
 private:
-    std::map<TextureSetHandle, Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>> m_textureHeaps; // [a_vorontcov] TODO: One tex heap for all textures?
+    HandleTable<TextureSetHandle, Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>> m_textureHeaps; // [a_vorontcov] TODO: One tex heap for all textures?
     
-    std::map<TextureHandle, uint16> m_rtvHeapOffsets;
+    HandleTable<TextureHandle, uint16> m_rtvHeapOffsets;
     Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
     uint16 m_currentRtvOffset = 0;
+    std::vector<uint16> m_freeRtvOffsets; // Offsets of unregistered textures.
 
     std::vector<TextureDX12*> m_textureQueue;
     std::vector<const TextureSet*> m_textureSetUpdateQueue;
 
-    std::map<TextureHandle, TextureDX12*> m_textures;
-    std::map<TextureHandle, TextureDX12*> m_notOwningTextures;
+    HandleTable<TextureHandle, TextureDX12*> m_textures;
+    HandleTable<TextureHandle, TextureDX12*> m_notOwningTextures;
 };
 }
\ No newline at end of file
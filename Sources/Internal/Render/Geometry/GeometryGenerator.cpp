@@ -111,6 +111,7 @@ Mesh GenerateFullscreenQuad()
     uint32* meshIdxPrt = mesh.GetIndexPtr(0);
     memcpy(meshIdxPrt, indices, sizeof(uint32) * 6);
 
+    mesh.ComputeBounds();
     return mesh;
 }
 
@@ -164,6 +165,7 @@ Mesh GeometryGenerator::GeneratePlane(float32 sizeX /*= 1.0f*/, float32 sizeZ /*
         *mesh.GetIndexPtr(index++) = i + 1;
     }
 
+    mesh.ComputeBounds();
     return mesh;
 }
 
@@ -348,6 +350,7 @@ Mesh GenerateCube(float32 sizeX /*= 1.0f*/, float32 sizeY /*= 1.0f*/, float32 si
     *res.GetIndexPtr(ind++) = 22;
     *res.GetIndexPtr(ind++) = 21;
 
+    res.ComputeBounds();
     return res;
 }
 
@@ -501,6 +504,7 @@ Mesh GenerateCone(float32 height /*= 1.0f*/, float32 bottomRadius /*= 0.25f*/, f
         *mesh.GetIndexPtr(index++) = tri + 0;
         tri++;
     }
+    mesh.ComputeBounds();
     return mesh;
 }
 
@@ -589,6 +593,7 @@ Mesh GenerateSphere(float32 radius /*=1.0f*/)
         *mesh.GetIndexPtr(index++)  = vCount - (lon + 2) - 1;
         *mesh.GetIndexPtr(index++)  = vCount - (lon + 1) - 1;
     }
+    mesh.ComputeBounds();
     return mesh;
 }
 
@@ -803,6 +808,7 @@ Mesh GenerateTube(float32 height /*= 1.0f*/, float32 bottomRadius1 /*= 0.5f*/, f
 
         sideCounter++;
     }
+    mesh.ComputeBounds();
     return mesh;
 }
 
@@ -898,6 +904,7 @@ Mesh GenerateIcosphere(int32 recursionLevel /*= 3*/, float32 radius /*= 1.0f*/)
         *mesh.GetIndexPtr(index++) = face.i2;
         *mesh.GetIndexPtr(index++) = face.i3;
     }
+    mesh.ComputeBounds();
     return mesh;
 }
 
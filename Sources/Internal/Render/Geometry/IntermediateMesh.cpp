@@ -2,6 +2,8 @@
 
 #include "Render/Geometry/IntermediateMesh.h"
 
+#include "Math/MathBatch.h"
+
 #include <algorithm>
 
 namespace Kioto::Renderer
@@ -55,4 +57,36 @@ void IntermediateMesh::Indexate()
     }
     Vertices.erase(std::remove_if(Vertices.begin(), Vertices.end(), [](const Vertex& v) { return v.marked; }), Vertices.end());
 }
+
+void IntermediateMesh::Transform(const Matrix4& m)
+{
+    if (Vertices.empty())
+        return;
+
+    // Vertex attributes are Vector4 with unused w, transform their xyz parts in place with vertex stride.
+    const uint32 stride = static_cast<uint32>(sizeof(Vertex));
+    uint32 count = static_cast<uint32>(Vertices.size());
+    Vertex& first = Vertices.front();
+    Math::Batch::TransformPoints(m, reinterpret_cast<Vector3*>(first.Pos.data), stride, reinterpret_cast<Vector3*>(first.Pos.data), stride, count);
+
+    if ((LayoutMask & Normal) != 0)
+    {
+        Matrix4 normalMatrix;
+        bool isInversed = m.Inversed(normalMatrix);
+        assert(isInversed);
+        normalMatrix.Transpose();
+        Vector3* normals = reinterpret_cast<Vector3*>(first.Norm.data);
+        Math::Batch::TransformNormals(normalMatrix, normals, stride, normals, stride, count);
+    }
+    if ((LayoutMask & Tanget) != 0)
+    {
+        Vector3* tangents = reinterpret_cast<Vector3*>(first.Tangent.data);
+        Math::Batch::TransformNormals(m, tangents, stride, tangents, stride, count);
+    }
+    if ((LayoutMask & Bitangent) != 0)
+    {
+        Vector3* bitangents = reinterpret_cast<Vector3*>(first.Bitangent.data);
+        Math::Batch::TransformNormals(m, bitangents, stride, bitangents, stride, count);
+    }
+}
 }
\ No newline at end of file
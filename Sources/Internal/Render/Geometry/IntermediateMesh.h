@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "Math/Matrix4.h"
 #include "Math/Vector4.h"
 #include "Math/Vector2.h"
 
@@ -61,5 +62,9 @@ struct IntermediateMesh
     std::vector<uint32> Indices;
 
     void Indexate();
+    ///
+    /// Transform positions by m, normals by inverse transposed m and tangents/bitangents by m. W components are kept.
+    ///
+    void Transform(const Matrix4& m);
 };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Render/Geometry/IntermediateMesh.h"
 #include "Render/Geometry/MeshLoader.h"
+#include "Math/MathBatch.h"
 
 namespace Kioto::Renderer
 {
@@ -29,6 +30,8 @@ Mesh::Mesh(const Mesh& other)
     , m_vertexCount(other.m_vertexCount)
     , m_indexCount(other.m_indexCount)
     , m_layout(other.m_layout)
+    , m_boundingBox(other.m_boundingBox)
+    , m_boundingSphere(other.m_boundingSphere)
 {
 }
 
@@ -116,6 +119,42 @@ void Mesh::FromIntermediateMesh(const IntermediateMesh& iMesh)
                 *GetVertexElementPtr<Vector4>(i, Renderer::eVertexSemantic::Color, texSemIndex) = iMesh.Vertices[i].Color[texSemIndex];
         }
     }
+    ComputeBounds();
+}
+
+void Mesh::Transform(const Matrix4& m)
+{
+    if (m_vertexCount == 0)
+        return;
+
+    uint32 stride = m_layout.GetVertexStride();
+    Vector3* positions = GetPositionPtr(0);
+    Math::Batch::TransformPoints(m, positions, stride, positions, stride, m_vertexCount);
+
+    if (Vector3* normals = GetNormalPtr(0))
+    {
+        Matrix4 normalMatrix;
+        bool isInversed = m.Inversed(normalMatrix);
+        assert(isInversed);
+        normalMatrix.Transpose();
+        Math::Batch::TransformNormals(normalMatrix, normals, stride, normals, stride, m_vertexCount);
+    }
+    if (Vector3* tangents = GetVertexElementPtr<Vector3>(0, eVertexSemantic::Tangent, 0))
+        Math::Batch::TransformNormals(m, tangents, stride, tangents, stride, m_vertexCount);
+    if (Vector3* bitangents = GetVertexElementPtr<Vector3>(0, eVertexSemantic::Bitangent, 0))
+        Math::Batch::TransformNormals(m, bitangents, stride, bitangents, stride, m_vertexCount);
+    ComputeBounds();
+}
+
+void Mesh::ComputeBounds()
+{
+    if (m_vertexCount == 0)
+        return;
+
+    uint32 stride = m_layout.GetVertexStride();
+    const Vector3* positions = GetPositionPtr(0);
+    m_boundingBox = BoundingBox::FromPoints(positions, stride, m_vertexCount);
+    m_boundingSphere = BoundingSphere::FromPoints(positions, stride, m_vertexCount, m_boundingBox.GetCenter());
 }
 
 void Mesh::LayoutFromIntermediateMesh(const IntermediateMesh& iMesh)
@@ -2,6 +2,8 @@
 
 #include "AssetsSystem/Asset.h"
 #include "Core/CoreTypes.h"
+#include "Math/BoundingVolumes.h"
+#include "Math/Matrix4.h"
 #include "Render/VertexLayout.h"
 #include "Render/RendererPublic.h"
 
@@ -46,6 +48,15 @@ public:
 
     void InitFromLayout(VertexLayout layout, uint32 vertexCount, uint32 indexCount);
     void FromIntermediateMesh(const IntermediateMesh& iMesh);
+    ///
+    /// Transform positions by m, normals by inverse transposed m and tangents/bitangents by m in place. Elements must be Vector3.
+    ///
+    void Transform(const Matrix4& m);
+    ///
+    /// Recompute bounds from positions. Meshes built from intermediate mesh or by GeometryGenerator have them computed,
+    /// call it after changing positions through element pointers.
+    ///
+    void ComputeBounds();
 
     uint32* GetIndexPtr(uint32 i);
     eDataFormat GetVertexElementFormat(eVertexSemantic semantic, uint8 semanticIndex) const;
@@ -88,6 +99,9 @@ public:
     MeshHandle GetHandle() const;
     void SetHandle(MeshHandle handle);
 
+    const BoundingBox& GetBoundingBox() const;
+    const BoundingSphere& GetBoundingSphere() const;
+
     friend void swap(Mesh& l, Mesh& r)
     {
         std::swap(l.m_vertexData, r.m_vertexData);
@@ -99,6 +113,8 @@ public:
         std::swap(l.m_vertexCount, r.m_vertexCount);
         std::swap(l.m_indexCount, r.m_indexCount);
         swap(l.m_layout, r.m_layout);
+        std::swap(l.m_boundingBox, r.m_boundingBox);
+        std::swap(l.m_boundingSphere, r.m_boundingSphere);
     }
 
     inline static constexpr uint32 MaxTexcoordCount = 8;
@@ -117,6 +133,9 @@ private:
     uint32 m_indexCount = 0;
     VertexLayout m_layout;
 
+    BoundingBox m_boundingBox;
+    BoundingSphere m_boundingSphere; // Centered in the box center, tighter than the sphere around the box.
+
     MeshHandle m_handle;
 };
 
@@ -208,4 +227,14 @@ inline void Mesh::SetHandle(MeshHandle handle)
 {
     m_handle = handle;
 }
+
+inline const BoundingBox& Mesh::GetBoundingBox() const
+{
+    return m_boundingBox;
+}
+
+inline const BoundingSphere& Mesh::GetBoundingSphere() const
+{
+    return m_boundingSphere;
+}
 }
\ No newline at end of file
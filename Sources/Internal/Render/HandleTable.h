@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+#include "Render/RendererPublic.h"
+
+namespace Kioto::Renderer
+{
+///
+/// Table of values by handles from GetNewHandle. Values are stored densely, a sparse array maps handle to the value index,
+/// so lookup is three array reads. GetNewHandle never returns the same handle twice, so removed handle can't alias a newer
+/// value and the sparse entry serves as generation check. Removal moves the last value in place of removed one, pointers
+/// to values are valid until the table is changed.
+/// Handles are not reused and are shared by all resource types, so the sparse array is split into pages allocated on
+/// demand and released when their last handle is removed: memory follows the live handles, not the greatest one issued.
+/// Handles from MaxHandle on (reserved handles, or a very long run) are mapped by a hash map, slower but without limit.
+///
+template <typename THandle, typename T>
+class HandleTable
+{
+public:
+    static constexpr uint32 InvalidIndex = (std::numeric_limits<uint32>::max)();
+    static constexpr uint32 MaxHandle = 1 << 24; // Handles below are in pages, the page array is 128 KB at most.
+
+    T* Find(THandle handle);
+    const T* Find(THandle handle) const;
+    bool Contains(THandle handle) const;
+    ///
+    /// Get value of the handle, default constructed value is added if there is none.
+    ///
+    T& operator[](THandle handle);
+    bool Remove(THandle handle);
+    void Clear();
+    void Reserve(uint32 count);
+
+    uint32 GetSize() const;
+    bool IsEmpty() const;
+    THandle GetHandle(uint32 index) const;
+
+    typename std::vector<T>::iterator begin();
+    typename std::vector<T>::iterator end();
+    typename std::vector<T>::const_iterator begin() const;
+    typename std::vector<T>::const_iterator end() const;
+
+private:
+    static constexpr uint32 PageSizeLog2 = 10;
+    static constexpr uint32 PageSize = 1 << PageSizeLog2;
+
+    struct Page
+    {
+        uint32 HandlesCount = 0;
+        uint32 Indices[PageSize];
+    };
+
+    uint32 GetIndex(THandle handle) const;
+    ///
+    /// Get value index slot of the handle, page or hash map entry is added if there is none.
+    ///
+    uint32& GetIndexSlot(uint32 h);
+    void SetIndex(uint32 h, uint32 index);
+    void RemoveIndex(uint32 h);
+
+    std::vector<std::unique_ptr<Page>> m_pages; // Value indices of handles below MaxHandle.
+    std::unordered_map<uint32, uint32> m_farIndices; // Value indices of handles from MaxHandle on.
+    std::vector<THandle> m_handles;
+    std::vector<T> m_values;
+};
+
+template <typename THandle, typename T>
+inline uint32 HandleTable<THandle, T>::GetIndex(THandle handle) const
+{
+    uint32 h = handle.GetHandle();
+    if (h >= MaxHandle)
+    {
+        auto it = m_farIndices.find(h);
+        return it != m_farIndices.end() ? it->second : InvalidIndex;
+    }
+
+    uint32 page = h >> PageSizeLog2;
+    if (page >= m_pages.size() || m_pages[page] == nullptr)
+        return InvalidIndex;
+    return m_pages[page]->Indices[h & (PageSize - 1)];
+}
+
+template <typename THandle, typename T>
+inline uint32& HandleTable<THandle, T>::GetIndexSlot(uint32 h)
+{
+    if (h >= MaxHandle)
+        return m_farIndices.emplace(h, InvalidIndex).first->second;
+
+    uint32 page = h >> PageSizeLog2;
+    if (page >= m_pages.size())
+        m_pages.resize(page + 1);
+    if (m_pages[page] == nullptr)
+    {
+        m_pages[page] = std::make_unique<Page>();
+        std::fill(std::begin(m_pages[page]->Indices), std::end(m_pages[page]->Indices), InvalidIndex);
+    }
+    return m_pages[page]->Indices[h & (PageSize - 1)];
+}
+
+template <typename THandle, typename T>
+inline void HandleTable<THandle, T>::SetIndex(uint32 h, uint32 index)
+{
+    if (h >= MaxHandle)
+        m_farIndices[h] = index;
+    else
+        m_pages[h >> PageSizeLog2]->Indices[h & (PageSize - 1)] = index;
+}
+
+template <typename THandle, typename T>
+inline void HandleTable<THandle, T>::RemoveIndex(uint32 h)
+{
+    if (h >= MaxHandle)
+    {
+        m_farIndices.erase(h);
+        return;
+    }
+
+    std::unique_ptr<Page>& page = m_pages[h >> PageSizeLog2];
+    page->Indices[h & (PageSize - 1)] = InvalidIndex;
+    if (--page->HandlesCount == 0)
+        page.reset();
+}
+
+template <typename THandle, typename T>
+inline T* HandleTable<THandle, T>::Find(THandle handle)
+{
+    uint32 index = GetIndex(handle);
+    return index != InvalidIndex ? &m_values[index] : nullptr;
+}
+
+template <typename THandle, typename T>
+inline const T* HandleTable<THandle, T>::Find(THandle handle) const
+{
+    uint32 index = GetIndex(handle);
+    return index != InvalidIndex ? &m_values[index] : nullptr;
+}
+
+template <typename THandle, typename T>
+inline bool HandleTable<THandle, T>::Contains(THandle handle) const
+{
+    return GetIndex(handle) != InvalidIndex;
+}
+
+template <typename THandle, typename T>
+inline T& HandleTable<THandle, T>::operator[](THandle handle)
+{
+    uint32 h = handle.GetHandle();
+    uint32& index = GetIndexSlot(h);
+    if (index == InvalidIndex)
+    {
+        index = static_cast<uint32>(m_values.size());
+        if (h < MaxHandle)
+            ++m_pages[h >> PageSizeLog2]->HandlesCount;
+        m_handles.push_back(handle);
+        m_values.emplace_back();
+    }
+    return m_values[index];
+}
+
+template <typename THandle, typename T>
+inline bool HandleTable<THandle, T>::Remove(THandle handle)
+{
+    uint32 index = GetIndex(handle);
+    if (index == InvalidIndex)
+        return false;
+
+    uint32 last = static_cast<uint32>(m_values.size()) - 1;
+    if (index != last)
+    {
+        m_values[index] = std::move(m_values[last]);
+        m_handles[index] = m_handles[last];
+        SetIndex(m_handles[index].GetHandle(), index);
+    }
+    m_values.pop_back();
+    m_handles.pop_back();
+    RemoveIndex(handle.GetHandle());
+    return true;
+}
+
+template <typename THandle, typename T>
+inline void HandleTable<THandle, T>::Clear()
+{
+    m_pages.clear();
+    m_farIndices.clear();
+    m_handles.clear();
+    m_values.clear();
+}
+
+template <typename THandle, typename T>
+inline void HandleTable<THandle, T>::Reserve(uint32 count)
+{
+    m_handles.reserve(count);
+    m_values.reserve(count);
+}
+
+template <typename THandle, typename T>
+inline uint32 HandleTable<THandle, T>::GetSize() const
+{
+    return static_cast<uint32>(m_values.size());
+}
+
+template <typename THandle, typename T>
+inline bool HandleTable<THandle, T>::IsEmpty() const
+{
+    return m_values.empty();
+}
+
+template <typename THandle, typename T>
+inline THandle HandleTable<THandle, T>::GetHandle(uint32 index) const
+{
+    return m_handles[index];
+}
+
+template <typename THandle, typename T>
+inline typename std::vector<T>::iterator HandleTable<THandle, T>::begin()
+{
+    return m_values.begin();
+}
+
+template <typename THandle, typename T>
+inline typename std::vector<T>::iterator HandleTable<THandle, T>::end()
+{
+    return m_values.end();
+}
+
+template <typename THandle, typename T>
+inline typename std::vector<T>::const_iterator HandleTable<THandle, T>::begin() const
+{
+    return m_values.cbegin();
+}
+
+template <typename THandle, typename T>
+inline typename std::vector<T>::const_iterator HandleTable<THandle, T>::end() const
+{
+    return m_values.cend();
+}
+}
\ No newline at end of file
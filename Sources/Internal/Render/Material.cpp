@@ -2,6 +2,9 @@
 
 #include "Render/Material.h"
 
+#include <mutex>
+#include <shared_mutex>
+
 #include "yaml-cpp/yaml.h"
 
 #include "AssetsSystem/AssetsSystem.h"
@@ -14,6 +17,7 @@
 namespace Kioto::Renderer
 {
 static const float32 CurrentVersion = 0.01f;
+static std::shared_mutex BuildedPassesMutex; // Materials are built lazily by passes recording on different threads.
 
 Material::Material(const std::string& path)
     : Asset(path)
@@ -48,6 +52,14 @@ Material::~Material()
 
 void Material::BuildMaterialForPass(const RenderPass* pass)
 {
+    {
+        std::shared_lock<std::shared_mutex> lock(BuildedPassesMutex);
+        auto it = std::find(m_buildedPassesHandles.cbegin(), m_buildedPassesHandles.cend(), pass->GetHandle());
+        if (it != m_buildedPassesHandles.cend())
+            return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(BuildedPassesMutex);
     auto it = std::find(m_buildedPassesHandles.cbegin(), m_buildedPassesHandles.cend(), pass->GetHandle());
     if (it != m_buildedPassesHandles.cend())
         return;
@@ -0,0 +1,446 @@
+#include "stdafx.h"
+
+#include "Render/Null/RendererNull.h"
+
+#include <algorithm>
+
+#include "Sources/External/IMGUI/imgui.h"
+
+#include "Core/Logger/Logger.h"
+#include "Core/Timer/GlobalTimer.h"
+#include "Render/ConstantBuffer.h"
+#include "Render/Geometry/Mesh.h"
+#include "Render/Material.h"
+#include "Render/RenderObject.h"
+#include "Render/RenderOptions.h"
+#include "Render/RenderPass/RenderPass.h"
+#include "Render/Shader.h"
+#include "Render/Texture/Texture.h"
+#include "Render/Texture/TextureSet.h"
+
+namespace Kioto::Renderer
+{
+namespace
+{
+uint64 GetPipelineStateKey(MaterialHandle material, RenderPassHandle pass)
+{
+    return (static_cast<uint64>(material.GetHandle()) << 32) | pass.GetHandle();
+}
+}
+
+void RendererNull::Init(uint16 width, uint16 height)
+{
+    m_frameCommandLists.reserve(RenderOptions::MaxRenderPassesCount);
+
+    for (auto& backBuffer : m_backBuffers)
+    {
+        backBuffer = GetNewHandle();
+        m_textures.insert(backBuffer.GetHandle());
+        m_textureStates[backBuffer.GetHandle()] = eResourceState::Present;
+    }
+    m_depthStencil = GetNewHandle();
+    m_textures.insert(m_depthStencil.GetHandle());
+    m_textureStates[m_depthStencil.GetHandle()] = eResourceState::DepthWrite;
+
+    InitImGui(width, height);
+}
+
+void RendererNull::InitImGui(uint16 width, uint16 height)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::StyleColorsDark();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float32>(width), static_cast<float32>(height));
+    unsigned char* pixels = nullptr;
+    int32 fontWidth = 0;
+    int32 fontHeight = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight); // Atlas must be built before the first frame even if nothing is drawn.
+}
+
+void RendererNull::Resize(uint16 width, uint16 height)
+{
+    ImGui::GetIO().DisplaySize = ImVec2(static_cast<float32>(width), static_cast<float32>(height));
+}
+
+void RendererNull::ChangeFullScreenMode(bool fullScreen)
+{
+    m_isFullScreen = fullScreen;
+}
+
+void RendererNull::Shutdown()
+{
+    ImGui::DestroyContext();
+    LOG("Null renderer validation errors:", m_errorsCount);
+}
+
+void RendererNull::Update(float32 dt)
+{
+}
+
+void RendererNull::StartFrame()
+{
+    float32 dt = GlobalTimer::GetUnscaledDt();
+    ImGui::GetIO().DeltaTime = dt > 0.0f ? dt : 1.0f / 60.0f;
+    ImGui::NewFrame();
+}
+
+void RendererNull::Present()
+{
+    // Frame waits for the frame which used the same back buffer, so frames older than FrameCount are completed.
+    ++m_frame;
+    m_constantUploadRing.Reclaim(m_frame > FrameCount ? m_frame - FrameCount : 0);
+
+    m_frameStats = {};
+    m_currentMaterial = InvalidHandle;
+    m_currentPass = InvalidHandle;
+    m_currentShader = InvalidHandle;
+    m_currentTextureSet = InvalidHandle;
+    m_currentMesh = InvalidHandle;
+    m_currentConstantBuffers.clear();
+    m_hasRenderTargets = false;
+    m_gpuEventsDepth = 0;
+
+    ProcessBufferUpdates();
+
+    m_textureStates[GetCurrentBackBufferHandle().GetHandle()] = eResourceState::RenderTarget;
+    for (const CommandList* commandList : m_frameCommandLists)
+        ExecuteCommandList(*commandList);
+    m_textureStates[GetCurrentBackBufferHandle().GetHandle()] = eResourceState::Present;
+
+    if (m_gpuEventsDepth != 0)
+        ReportError("Gpu events are not balanced", InvalidStringId);
+
+    ImGui::Render();
+
+    m_frameCommandLists.clear();
+    m_constantUploadRing.FinishFrame(m_frame);
+    m_frameIndex = (m_frameIndex + 1) % FrameCount;
+    m_lastFrameStats = m_frameStats;
+}
+
+void RendererNull::ProcessBufferUpdates()
+{
+    for (auto& upload : m_pendingUploads)
+    {
+        assert(upload.Buffer->IsAllocated());
+        ++m_frameStats.ConstantBuffersUploaded;
+        m_frameStats.ConstantDataUploaded += upload.Buffer->GetDataSize();
+        --upload.FramesLeft;
+    }
+    auto it = std::remove_if(m_pendingUploads.begin(), m_pendingUploads.end(), [](const PendingUpload& upload) { return upload.FramesLeft == 0; });
+    m_pendingUploads.erase(it, m_pendingUploads.end());
+}
+
+void RendererNull::UploadDynamicBuffer(ConstantBufferState& state, StringId passName)
+{
+    if (state.UploadedFrame == m_frame)
+        return;
+    state.UploadedFrame = m_frame;
+
+    uint32 size = state.Buffer->GetDataSize();
+    if (state.ResidentVersion == state.Buffer->GetVersion())
+    {
+        ++m_frameStats.ConstantBuffersSkipped;
+        m_frameStats.ConstantDataSkipped += size;
+        state.ResidentFrame = m_frame;
+        return;
+    }
+
+    ++m_frameStats.ConstantBuffersUploaded;
+    m_frameStats.ConstantDataUploaded += size;
+    if (state.ResidentFrame == 0 || state.ResidentFrame + FrameCount <= m_frame)
+    {
+        // Persistent copy isn't read by frames in flight, so it's rewritten in place.
+        state.ResidentVersion = state.Buffer->GetVersion();
+        state.ResidentFrame = m_frame;
+        return;
+    }
+
+    if (m_constantUploadRing.Allocate(size) == UploadRingAllocator::InvalidOffset)
+    {
+        // DX12 backend waits for the frames in flight here.
+        m_constantUploadRing.Reclaim(m_frame - 1);
+        if (m_constantUploadRing.Allocate(size) == UploadRingAllocator::InvalidOffset)
+        {
+            ReportError("Constant data of the frame doesn't fit into the upload ring", passName);
+        }
+    }
+}
+
+void RendererNull::ExecuteCommandList(const CommandList& commandList)
+{
+    ++m_frameStats.CommandListsCount;
+    m_frameStats.CommandsDataSize += commandList.GetDataSize();
+
+    uint32 commandsCount = 0;
+    uint32 dataSize = 0;
+    for (const RenderCommandHeader& cmd : commandList)
+    {
+        // Size is checked before the iterator moves by it, broken size would make the rest of the list unreadable.
+        if (cmd.Size < sizeof(RenderCommandHeader) || cmd.Size % alignof(RenderCommandHeader) != 0 || dataSize + cmd.Size > commandList.GetDataSize())
+        {
+            ReportError("Command has invalid size", cmd.PassName);
+            return;
+        }
+        dataSize += cmd.Size;
+        ++commandsCount;
+        ++m_frameStats.CommandsCount;
+
+        if (cmd.CommandType == eRenderCommandType::eSetRenderTargets)
+        {
+            const SetRenderTargetsCommand& srtCommand = cmd.GetCommand<SetRenderTargetsCommand>();
+            ++m_frameStats.RenderTargetChanges;
+            if (srtCommand.RenderTargetCount == 0 || srtCommand.RenderTargetCount > MaxRenderTargetsCount)
+                ReportError("Invalid render targets count", cmd.PassName);
+            else if (srtCommand.GetRenderTarget(0) != DefaultBackBufferHandle && !IsTextureRegistered(srtCommand.GetRenderTarget(0)))
+                ReportError("Render target is not registered", cmd.PassName);
+            if (srtCommand.GetDepthStencil() != DefaultDepthStencilHandle)
+                ReportError("Only default depth stencil is supported", cmd.PassName);
+            m_hasRenderTargets = true;
+        }
+        else if (cmd.CommandType == eRenderCommandType::eEndRenderPass)
+        {
+            m_hasRenderTargets = false;
+        }
+        else if (cmd.CommandType == eRenderCommandType::eResourceTransitonCommand)
+        {
+            ExecuteResourceTransition(cmd);
+        }
+        else if (cmd.CommandType == eRenderCommandType::eSubmitRenderPacket)
+        {
+            ExecuteRenderPacket(cmd);
+        }
+        else if (cmd.CommandType == eRenderCommandType::eBeginGpuEvent)
+        {
+            ++m_gpuEventsDepth;
+        }
+        else if (cmd.CommandType == eRenderCommandType::eEndGpuEvent)
+        {
+            if (--m_gpuEventsDepth < 0)
+                ReportError("Gpu event ends without begin", cmd.PassName);
+        }
+        else if (cmd.CommandType == eRenderCommandType::eSetGpuMarker)
+        {
+        }
+        else
+        {
+            ReportError("Invalid command type", cmd.PassName);
+        }
+    }
+
+    if (commandsCount != commandList.GetCommandsCount() || dataSize != commandList.GetDataSize())
+        ReportError("Command list size doesn't match its commands", InvalidStringId);
+}
+
+void RendererNull::ExecuteRenderPacket(const RenderCommandHeader& cmd)
+{
+    const SubmitRenderPacketCommand& packet = cmd.GetCommand<SubmitRenderPacketCommand>();
+    uint32 extraSize = (packet.ConstantBuffersCount + packet.UniformConstantsCount) * sizeof(uint32);
+    if (sizeof(RenderCommandHeader) + sizeof(SubmitRenderPacketCommand) + extraSize > cmd.Size)
+    {
+        ReportError("Render packet data is out of command", cmd.PassName);
+        return;
+    }
+
+    if (!m_hasRenderTargets)
+        ReportError("Draw without render targets", cmd.PassName);
+    if (m_pipelineStates.count(GetPipelineStateKey(packet.Material, packet.Pass)) == 0)
+        ReportError("Material is not built for the pass", cmd.PassName);
+    if (m_shaders.count(packet.Shader.GetHandle()) == 0)
+        ReportError("Shader is not registered", cmd.PassName);
+    if (m_meshes.count(packet.Mesh.GetHandle()) == 0)
+        ReportError("Mesh is not registered", cmd.PassName);
+    if (packet.TextureSet != InvalidHandle && m_textureSets.count(packet.TextureSet.GetHandle()) == 0)
+        ReportError("Texture set is not registered", cmd.PassName);
+    if (packet.InstanceCount == 0)
+        ReportError("Draw without instances", cmd.PassName);
+    for (uint32 i = 0; i < packet.ConstantBuffersCount; ++i)
+    {
+        auto it = m_constantBuffers.find(packet.GetConstantBufferHandles()[i].GetHandle());
+        if (it == m_constantBuffers.end())
+            ReportError("Constant buffer is not registered", cmd.PassName);
+        else if (it->second.Buffer->GetElemCount() == 1)
+            UploadDynamicBuffer(it->second, cmd.PassName);
+    }
+
+    // Same state tracking as in RendererDX12::SubmitRenderPacket, pipeline state is built per material and pass.
+    uint64 pipelineState = GetPipelineStateKey(packet.Material, packet.Pass);
+    uint64 currentPipelineState = GetPipelineStateKey(m_currentMaterial, m_currentPass);
+    SetState(currentPipelineState, pipelineState, m_frameStats.PipelineStateChanges);
+    m_currentMaterial = packet.Material;
+    m_currentPass = packet.Pass;
+
+    if (packet.Shader != m_currentShader)
+        m_currentConstantBuffers.clear();
+    SetState(m_currentShader, packet.Shader, m_frameStats.RootSignatureChanges);
+
+    if (m_currentConstantBuffers.size() < packet.ConstantBuffersCount)
+        m_currentConstantBuffers.resize(packet.ConstantBuffersCount, InvalidHandle);
+    for (uint32 i = 0; i < packet.ConstantBuffersCount; ++i)
+        SetState(m_currentConstantBuffers[i], packet.GetConstantBufferHandles()[i], m_frameStats.ConstantBufferBindings);
+
+    if (packet.TextureSet != InvalidHandle)
+        SetState(m_currentTextureSet, packet.TextureSet, m_frameStats.TextureSetChanges);
+    SetState(m_currentMesh, packet.Mesh, m_frameStats.MeshChanges);
+    ++m_frameStats.DrawsCount;
+    m_frameStats.InstancesCount += packet.InstanceCount;
+}
+
+void RendererNull::ExecuteResourceTransition(const RenderCommandHeader& cmd)
+{
+    const ResourceTransitonCommand& transitionCommand = cmd.GetCommand<ResourceTransitonCommand>();
+    auto it = m_textureStates.find(transitionCommand.ResourceHandle.GetHandle());
+    if (it == m_textureStates.end())
+    {
+        ReportError("Transition of not registered texture", cmd.PassName);
+        return;
+    }
+
+    ++m_frameStats.ResourceTransitions;
+    if (it->second == transitionCommand.DestState)
+        ++m_frameStats.RedundantTransitions;
+    it->second = transitionCommand.DestState;
+}
+
+bool RendererNull::IsTextureRegistered(TextureHandle handle) const
+{
+    return m_textures.count(handle.GetHandle()) != 0;
+}
+
+void RendererNull::ReportError(const char* message, StringId passName)
+{
+    ++m_frameStats.ValidationErrors;
+    if (m_errorsCount++ < MaxLoggedErrorsCount)
+        LOG("Null renderer:", message, StringTable::GetString(passName));
+}
+
+void RendererNull::RegisterTexture(Texture* texture)
+{
+    if (m_textures.count(texture->GetHandle().GetHandle()) != 0)
+        throw "Texture Already Registered";
+
+    texture->SetHandle(GetNewHandle());
+    m_textures.insert(texture->GetHandle().GetHandle());
+    m_textureStates[texture->GetHandle().GetHandle()] = texture->GetDescriptor().InitialState;
+}
+
+void RendererNull::UnregisterTexture(Texture* texture)
+{
+    m_textures.erase(texture->GetHandle().GetHandle());
+    m_textureStates.erase(texture->GetHandle().GetHandle());
+}
+
+void RendererNull::RegisterShader(Shader* shader)
+{
+    shader->SetHandle(GetNewHandle());
+    m_shaders.insert(shader->GetHandle().GetHandle());
+}
+
+void RendererNull::RegisterMaterial(Material* material)
+{
+    material->SetHandle(GetNewHandle());
+    m_materials.insert(material->GetHandle().GetHandle());
+}
+
+void RendererNull::BuildMaterialForPass(Material& mat, const RenderPass* pass)
+{
+    assert(m_materials.count(mat.GetHandle().GetHandle()) != 0);
+    m_pipelineStates.insert(GetPipelineStateKey(mat.GetHandle(), pass->GetHandle()));
+}
+
+void RendererNull::RegisterMesh(Mesh* mesh)
+{
+    mesh->SetHandle(GetNewHandle());
+    m_meshes.insert(mesh->GetHandle().GetHandle());
+}
+
+void RendererNull::RegisterRenderPass(RenderPass* renderPass)
+{
+    renderPass->SetHandle(GetNewHandle());
+    m_renderPasses.insert(renderPass->GetHandle().GetHandle());
+}
+
+void RendererNull::RegisterRenderObject(RenderObject& renderObject)
+{
+    std::unordered_map<std::string, RenderObjectBufferLayout>& bufferLayouts = renderObject.GetBuffersLayouts();
+    for (auto& layoutElem : bufferLayouts)
+    {
+        RenderObjectBufferLayout& bufferLayout = layoutElem.second;
+        for (size_t i = 0; i < bufferLayout.size(); ++i)
+        {
+            if (bufferLayout[i].IsPerObjectBuffer())
+                RegisterConstantBuffer(bufferLayout[i]);
+        }
+    }
+}
+
+void RendererNull::UnregisterRenderObject(RenderObject& renderObject)
+{
+    std::unordered_map<std::string, RenderObjectBufferLayout>& bufferLayouts = renderObject.GetBuffersLayouts();
+    for (auto& layoutElem : bufferLayouts)
+    {
+        RenderObjectBufferLayout& bufferLayout = layoutElem.second;
+        for (size_t i = 0; i < bufferLayout.size(); ++i)
+        {
+            if (bufferLayout[i].IsPerObjectBuffer())
+                UnregisterConstantBuffer(bufferLayout[i]);
+        }
+    }
+}
+
+void RendererNull::RegisterTextureSet(TextureSet& set)
+{
+    set.SetHandle(GetNewHandle());
+    m_textureSets.insert(set.GetHandle().GetHandle());
+}
+
+void RendererNull::QueueTextureSetForUpdate(const TextureSet& set)
+{
+    for (uint32 i = 0; i < set.GetTexturesCount(); ++i)
+    {
+        const Texture* texture = set.GetTexture(i);
+        if (texture != nullptr && !IsTextureRegistered(texture->GetHandle()))
+            ReportError("Texture set references not registered texture", InvalidStringId);
+    }
+}
+
+void RendererNull::RegisterConstantBuffer(ConstantBuffer& buffer)
+{
+    if (buffer.GetHandle() != InvalidHandle)
+        return;
+
+    buffer.SetHandle(GetNewHandle());
+    m_constantBuffers[buffer.GetHandle().GetHandle()] = { &buffer, 0 };
+    QueueConstantBufferForUpdate(buffer);
+}
+
+void RendererNull::UnregisterConstantBuffer(ConstantBuffer& buffer)
+{
+    if (buffer.GetHandle() == InvalidHandle)
+        return;
+
+    m_constantBuffers.erase(buffer.GetHandle().GetHandle());
+    auto it = std::remove_if(m_pendingUploads.begin(), m_pendingUploads.end(), [&buffer](const PendingUpload& upload) { return upload.Buffer == &buffer; });
+    m_pendingUploads.erase(it, m_pendingUploads.end());
+    buffer.SetHandle(InvalidHandle);
+}
+
+void RendererNull::QueueConstantBufferForUpdate(ConstantBuffer& buffer)
+{
+    if (buffer.GetHandle() == InvalidHandle || buffer.GetElemCount() == 1)
+        return; // Dynamic buffers are read when bound.
+
+    auto it = std::find_if(m_pendingUploads.begin(), m_pendingUploads.end(), [&buffer](const PendingUpload& upload) { return upload.Buffer == &buffer; });
+    if (it != m_pendingUploads.end())
+        it->FramesLeft = FrameCount;
+    else
+        m_pendingUploads.push_back({ &buffer, FrameCount });
+}
+
+void RendererNull::SubmitRenderCommands(const CommandList* commandList)
+{
+    m_frameCommandLists.push_back(commandList);
+}
+}
\ No newline at end of file
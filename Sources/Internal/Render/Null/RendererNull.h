@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Core/DataStructures/StringTable.h"
+#include "Render/Buffers/UploadRingAllocator.h"
+#include "Render/RenderCommand.h"
+#include "Render/RendererPublic.h"
+#include "Render/RenderOptions.h"
+#include "Render/RenderStats.h"
+
+namespace Kioto
+{
+class Mesh;
+}
+
+namespace Kioto::Renderer
+{
+class RenderObject;
+
+///
+/// Backend without GPU. Accepts the same registrations and command lists as DX12 backend, validates the command stream
+/// and counts what DX12 backend would do with it. Lets everything above the backend run headless, e.g. for CPU profiling.
+///
+class RendererNull final
+{
+public:
+    static constexpr uint32 FrameCount = 3;
+    static constexpr uint32 MaxLoggedErrorsCount = 32;
+
+    RendererNull() = default;
+    RendererNull(const RendererNull&) = delete;
+    RendererNull(RendererNull&&) = delete;
+    RendererNull& operator= (const RendererNull&) = delete;
+    RendererNull& operator= (const RendererNull&&) = delete;
+    ~RendererNull() = default;
+
+    void Init(uint16 width, uint16 height);
+    void Resize(uint16 width, uint16 height);
+    void ChangeFullScreenMode(bool fullScreen);
+    void Shutdown();
+    void Present();
+    void Update(float32 dt);
+    void StartFrame();
+
+    void RegisterTexture(Texture* texture);
+    void UnregisterTexture(Texture* texture);
+    void RegisterShader(Shader* shader);
+    void RegisterMaterial(Material* material);
+    void BuildMaterialForPass(Material& mat, const RenderPass* pass);
+    void RegisterMesh(Mesh* mesh);
+
+    void RegisterRenderPass(RenderPass* renderPass);
+    void RegisterRenderObject(RenderObject& renderObject);
+    void UnregisterRenderObject(RenderObject& renderObject);
+
+    void RegisterTextureSet(TextureSet& set);
+    void QueueTextureSetForUpdate(const TextureSet& set);
+
+    void RegisterConstantBuffer(ConstantBuffer& buffer);
+    void UnregisterConstantBuffer(ConstantBuffer& buffer);
+    void QueueConstantBufferForUpdate(ConstantBuffer& buffer);
+
+    void SubmitRenderCommands(const CommandList* commandList);
+
+    TextureHandle GetCurrentBackBufferHandle() const;
+    TextureHandle GetDepthStencilHandle() const;
+
+    ///
+    /// Get counters of the last presented frame.
+    ///
+    const RenderStats& GetLastFrameStats() const;
+
+private:
+    struct PendingUpload
+    {
+        ConstantBuffer* Buffer = nullptr;
+        uint32 FramesLeft = 0; // Every frame of the ring has its own copy of the buffer.
+    };
+
+    struct ConstantBufferState
+    {
+        ConstantBuffer* Buffer = nullptr;
+        uint64 UploadedFrame = 0;
+        uint32 ResidentVersion = 0; // Version of the persistent copy DX12 backend binds while data doesn't change.
+        uint64 ResidentFrame = 0; // Last frame which has read the persistent copy.
+    };
+
+    void InitImGui(uint16 width, uint16 height);
+    void ProcessBufferUpdates();
+    void UploadDynamicBuffer(ConstantBufferState& state, StringId passName);
+    void ExecuteCommandList(const CommandList& commandList);
+    void ExecuteRenderPacket(const RenderCommandHeader& cmd);
+    void ExecuteResourceTransition(const RenderCommandHeader& cmd);
+    bool IsTextureRegistered(TextureHandle handle) const;
+    void ReportError(const char* message, StringId passName);
+    template <typename T>
+    void SetState(T& current, T value, uint32& changesCount);
+
+    std::vector<const CommandList*> m_frameCommandLists; // Lists live in frame memory, they are read in place in Present.
+
+    std::unordered_set<uint32> m_textures;
+    std::unordered_set<uint32> m_shaders;
+    std::unordered_set<uint32> m_materials;
+    std::unordered_set<uint32> m_renderPasses;
+    std::unordered_set<uint32> m_textureSets;
+    std::unordered_set<uint32> m_meshes;
+    std::unordered_map<uint32, ConstantBufferState> m_constantBuffers;
+    std::unordered_set<uint64> m_pipelineStates; // Material handle in high bits, pass handle in low bits.
+    std::unordered_map<uint32, eResourceState> m_textureStates;
+    std::vector<PendingUpload> m_pendingUploads; // Buffers of several elements, they have own resources in DX12 backend.
+    UploadRingAllocator m_constantUploadRing{ RenderOptions::ConstantUploadRingSize }; // Dynamic buffers are copied to it when bound, as in DX12 backend.
+
+    std::array<TextureHandle, FrameCount> m_backBuffers;
+    TextureHandle m_depthStencil;
+    uint32 m_frameIndex = 0;
+    uint64 m_frame = 0; // Frame number, serves as fence value of the upload ring.
+
+    // State set by the previous draw, kept during the whole frame like in the single DX12 command list.
+    MaterialHandle m_currentMaterial;
+    RenderPassHandle m_currentPass;
+    ShaderHandle m_currentShader;
+    TextureSetHandle m_currentTextureSet;
+    MeshHandle m_currentMesh;
+    std::vector<ConstantBufferHandle> m_currentConstantBuffers; // Reset with root signature.
+    bool m_hasRenderTargets = false;
+    int32 m_gpuEventsDepth = 0;
+
+    RenderStats m_frameStats;
+    RenderStats m_lastFrameStats;
+    uint32 m_errorsCount = 0;
+    bool m_isFullScreen = false;
+};
+
+inline TextureHandle RendererNull::GetCurrentBackBufferHandle() const
+{
+    return m_backBuffers[m_frameIndex];
+}
+
+inline TextureHandle RendererNull::GetDepthStencilHandle() const
+{
+    return m_depthStencil;
+}
+
+template <typename T>
+inline void RendererNull::SetState(T& current, T value, uint32& changesCount)
+{
+    if (current == value)
+    {
+        ++m_frameStats.SkippedStateChanges;
+        return;
+    }
+    current = value;
+    ++changesCount;
+}
+
+inline const RenderStats& RendererNull::GetLastFrameStats() const
+{
+    return m_lastFrameStats;
+}
+}
\ No newline at end of file
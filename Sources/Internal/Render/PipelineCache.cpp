@@ -0,0 +1,223 @@
+#include "stdafx.h"
+
+#include "Render/PipelineCache.h"
+
+#include <fstream>
+
+#include "Core/CoreHelpers.h"
+#include "Render/PipelineState.h"
+#include "Render/VertexLayout.h"
+
+namespace Kioto::Renderer
+{
+namespace
+{
+struct FileHeader
+{
+    uint32 Magic = PipelineCache::FileMagic;
+    uint32 Version = PipelineCache::FormatVersion;
+    uint64 DeviceTag = 0;
+    uint32 EntriesCount = 0;
+};
+
+struct EntryHeader
+{
+    uint64 Key = 0;
+    uint64 BlobHash = 0; // Partially written files are detected by blob hashes.
+    uint32 BlobSize = 0;
+};
+
+template <typename T>
+void Write(std::vector<byte>& dst, const T& value)
+{
+    const byte* src = reinterpret_cast<const byte*>(&value);
+    dst.insert(dst.end(), src, src + sizeof(T));
+}
+
+template <typename T>
+bool Read(const byte* data, size_t size, size_t& offset, T& value)
+{
+    if (size - offset < sizeof(T))
+        return false;
+    memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+uint64 HashStencil(uint64 seed, const StencilDesc& desc)
+{
+    seed = HashCombine(seed, static_cast<uint64>(desc.StencilFailOp));
+    seed = HashCombine(seed, static_cast<uint64>(desc.StencilDepthFailOp));
+    seed = HashCombine(seed, static_cast<uint64>(desc.StencilPassOp));
+    return HashCombine(seed, static_cast<uint64>(desc.StencilFunc));
+}
+}
+
+bool PipelineCache::Find(uint64 key, std::vector<byte>& blob) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return false;
+    blob = it->second;
+    return true;
+}
+
+void PipelineCache::Store(uint64 key, std::vector<byte> blob)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[key] = std::move(blob);
+    m_isDirty = true;
+}
+
+void PipelineCache::Remove(uint64 key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.erase(key) > 0)
+        m_isDirty = true;
+}
+
+void PipelineCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isDirty = m_isDirty || !m_entries.empty();
+    m_entries.clear();
+}
+
+uint32 PipelineCache::GetEntriesCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32>(m_entries.size());
+}
+
+bool PipelineCache::GetIsDirty() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isDirty;
+}
+
+std::vector<byte> PipelineCache::Serialize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FileHeader header;
+    header.DeviceTag = m_deviceTag;
+    header.EntriesCount = static_cast<uint32>(m_entries.size());
+
+    std::vector<byte> data;
+    Write(data, header);
+    for (const auto& entry : m_entries)
+    {
+        EntryHeader entryHeader;
+        entryHeader.Key = entry.first;
+        entryHeader.BlobHash = HashData(entry.second.data(), entry.second.size());
+        entryHeader.BlobSize = static_cast<uint32>(entry.second.size());
+        Write(data, entryHeader);
+        data.insert(data.end(), entry.second.begin(), entry.second.end());
+    }
+    return data;
+}
+
+bool PipelineCache::Deserialize(const byte* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_isDirty = false;
+
+    size_t offset = 0;
+    FileHeader header;
+    if (!Read(data, size, offset, header) || header.Magic != FileMagic || header.Version != FormatVersion || header.DeviceTag != m_deviceTag)
+        return false;
+
+    for (uint32 i = 0; i < header.EntriesCount; ++i)
+    {
+        EntryHeader entryHeader;
+        if (!Read(data, size, offset, entryHeader) || size - offset < entryHeader.BlobSize
+            || HashData(data + offset, entryHeader.BlobSize) != entryHeader.BlobHash)
+        {
+            m_entries.clear();
+            return false;
+        }
+        m_entries[entryHeader.Key].assign(data + offset, data + offset + entryHeader.BlobSize);
+        offset += entryHeader.BlobSize;
+    }
+    return offset == size;
+}
+
+bool PipelineCache::Load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return Deserialize(nullptr, 0);
+
+    std::vector<byte> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    if (!file)
+        data.clear();
+    return Deserialize(data.data(), data.size());
+}
+
+bool PipelineCache::Save(const std::string& path)
+{
+    std::vector<byte> data = Serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isDirty = false;
+    return true;
+}
+
+uint64 PipelineCache::HashData(const void* data, size_t size, uint64 seed)
+{
+    const byte* bytes = static_cast<const byte*>(data);
+    uint64 hash = seed;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint64>(bytes[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64 PipelineCache::ComputeKey(const PipelineState& state, uint64 shaderHash, const VertexLayout& layout, const uint32* renderTargetFormats, uint32 renderTargetsCount, uint32 depthStencilFormat)
+{
+    // Fields are combined one by one, hashing the struct memory would hash padding and the shader pointer.
+    uint64 key = HashCombine(FormatVersion, shaderHash);
+    key = HashCombine(key, static_cast<uint64>(state.LayerType));
+    key = HashCombine(key, static_cast<uint64>(state.Fill));
+    key = HashCombine(key, static_cast<uint64>(state.Cull));
+    key = HashCombine(key, static_cast<uint64>(state.Ztest));
+    key = HashStencil(key, state.FrontFaceStencilDesc);
+    key = HashStencil(key, state.BackFaceStencilDesc);
+    key = HashCombine(key, state.StencilWriteMask);
+    key = HashCombine(key, state.StencilReadMask);
+    key = HashCombine(key, static_cast<uint64>(state.SrcBlend));
+    key = HashCombine(key, static_cast<uint64>(state.DstBlend));
+    key = HashCombine(key, static_cast<uint64>(state.BlendOp));
+    key = HashCombine(key, static_cast<uint64>(state.ColorMask));
+    key = HashCombine(key, state.Zwrite);
+    key = HashCombine(key, state.EnableStencill);
+    key = HashCombine(key, state.EnableDepth);
+    key = HashCombine(key, state.WindingCCW);
+
+    key = HashCombine(key, layout.GetElementsCount());
+    for (uint32 i = 0; i < layout.GetElementsCount(); ++i)
+    {
+        const SemanticDesc& element = layout.GetElement(i);
+        key = HashCombine(key, element.Offset);
+        key = HashCombine(key, static_cast<uint64>(element.Semantic));
+        key = HashCombine(key, element.SemanticIndex);
+        key = HashCombine(key, static_cast<uint64>(element.Format));
+    }
+
+    key = HashCombine(key, renderTargetsCount);
+    for (uint32 i = 0; i < renderTargetsCount; ++i)
+        key = HashCombine(key, renderTargetFormats[i]);
+    return HashCombine(key, depthStencilFormat);
+}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Renderer
+{
+struct PipelineState;
+class VertexLayout;
+
+///
+/// Compiled pipeline state blobs by key, persisted between runs. Key covers everything the compiled state depends on, so entries
+/// never go stale: changed state, shader or target formats give a new key. Blobs are backend and driver specific, cache file
+/// written with another device tag or format version is discarded on load. Find, Store and Remove are thread safe.
+///
+class PipelineCache
+{
+public:
+    static constexpr uint32 FileMagic = 0x4843504B; // "KPCH"
+    static constexpr uint32 FormatVersion = 1; // Increment when the file layout or the key composition changes.
+
+    PipelineCache() = default;
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    ///
+    /// Set tag of the device and driver which blobs are stored, cache of another tag is discarded on load.
+    ///
+    void SetDeviceTag(uint64 tag);
+    uint64 GetDeviceTag() const;
+
+    bool Find(uint64 key, std::vector<byte>& blob) const;
+    void Store(uint64 key, std::vector<byte> blob);
+    void Remove(uint64 key);
+    void Clear();
+    uint32 GetEntriesCount() const;
+    ///
+    /// Get if entries were stored or removed since the last load or save.
+    ///
+    bool GetIsDirty() const;
+
+    std::vector<byte> Serialize() const;
+    ///
+    /// Replace entries with serialized ones. Returns false and leaves cache empty if data is corrupted or written for another device.
+    ///
+    bool Deserialize(const byte* data, size_t size);
+    bool Load(const std::string& path);
+    bool Save(const std::string& path);
+
+    ///
+    /// FNV-1a hash of the bytes, stable between runs.
+    ///
+    static uint64 HashData(const void* data, size_t size, uint64 seed = 14695981039346656037ull);
+    ///
+    /// Get key of the pipeline state compiled with shaders which bytecode hashes to shaderHash, vertex layout and target formats.
+    /// Formats are backend values, 0 is unknown format.
+    ///
+    static uint64 ComputeKey(const PipelineState& state, uint64 shaderHash, const VertexLayout& layout, const uint32* renderTargetFormats, uint32 renderTargetsCount, uint32 depthStencilFormat);
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64, std::vector<byte>> m_entries;
+    uint64 m_deviceTag = 0;
+    bool m_isDirty = false;
+};
+
+inline void PipelineCache::SetDeviceTag(uint64 tag)
+{
+    m_deviceTag = tag;
+}
+
+inline uint64 PipelineCache::GetDeviceTag() const
+{
+    return m_deviceTag;
+}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Renderer
+{
+///
+/// Queue of pipeline state compilations by key, executed by own threads. Compilation takes tens of milliseconds, so it
+/// doesn't go to the job system: JobSystem::Wait executes queued jobs on the waiting thread and would stall the frame.
+/// Results are collected on the render thread. Without Start jobs are executed immediately by Enqueue, which gives
+/// deterministic order for debugging.
+///
+template <typename T>
+class PipelineCompileQueue
+{
+public:
+    PipelineCompileQueue() = default;
+    PipelineCompileQueue(const PipelineCompileQueue&) = delete;
+    PipelineCompileQueue& operator=(const PipelineCompileQueue&) = delete;
+    ~PipelineCompileQueue();
+
+    void Start(uint32 threadsCount = 1);
+    ///
+    /// Wait for the running jobs and join threads. Jobs not started yet are dropped, their keys are not pending anymore.
+    ///
+    void Stop();
+    bool GetIsStarted() const;
+
+    ///
+    /// Queue job compiling the key. Returns false if the key is already pending.
+    ///
+    bool Enqueue(uint64 key, std::function<T()> job);
+    bool IsPending(uint64 key) const;
+    uint32 GetPendingCount() const;
+    ///
+    /// Call f(key, result) for the jobs done since the last call.
+    ///
+    template <typename F>
+    void CollectCompleted(F&& f);
+
+private:
+    struct Job
+    {
+        uint64 Key = 0;
+        std::function<T()> Compile;
+    };
+
+    void WorkerLoop();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAdded;
+    std::deque<Job> m_jobs;
+    std::vector<std::pair<uint64, T>> m_completed;
+    std::unordered_set<uint64> m_pending; // Queued, running and completed but not collected keys.
+    std::vector<std::thread> m_threads;
+    bool m_isStopping = false;
+};
+
+template <typename T>
+inline PipelineCompileQueue<T>::~PipelineCompileQueue()
+{
+    Stop();
+}
+
+template <typename T>
+inline void PipelineCompileQueue<T>::Start(uint32 threadsCount)
+{
+    assert(m_threads.empty());
+    m_isStopping = false;
+    for (uint32 i = 0; i < threadsCount; ++i)
+        m_threads.emplace_back(&PipelineCompileQueue::WorkerLoop, this);
+}
+
+template <typename T>
+inline void PipelineCompileQueue<T>::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+        for (const Job& job : m_jobs)
+            m_pending.erase(job.Key);
+        m_jobs.clear();
+    }
+    m_jobAdded.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+}
+
+template <typename T>
+inline bool PipelineCompileQueue<T>::GetIsStarted() const
+{
+    return !m_threads.empty();
+}
+
+template <typename T>
+inline bool PipelineCompileQueue<T>::Enqueue(uint64 key, std::function<T()> job)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_pending.insert(key).second)
+        return false;
+
+    if (m_threads.empty())
+    {
+        lock.unlock();
+        T result = job();
+        lock.lock();
+        m_completed.emplace_back(key, std::move(result));
+        return true;
+    }
+
+    m_jobs.push_back({ key, std::move(job) });
+    lock.unlock();
+    m_jobAdded.notify_one();
+    return true;
+}
+
+template <typename T>
+inline bool PipelineCompileQueue<T>::IsPending(uint64 key) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.count(key) > 0;
+}
+
+template <typename T>
+inline uint32 PipelineCompileQueue<T>::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32>(m_pending.size());
+}
+
+template <typename T>
+template <typename F>
+inline void PipelineCompileQueue<T>::CollectCompleted(F&& f)
+{
+    std::vector<std::pair<uint64, T>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+        for (const auto& result : completed)
+            m_pending.erase(result.first);
+    }
+    for (auto& result : completed)
+        f(result.first, result.second);
+}
+
+template <typename T>
+inline void PipelineCompileQueue<T>::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_jobAdded.wait(lock, [this]() { return m_isStopping || !m_jobs.empty(); });
+        if (m_isStopping)
+            return;
+
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        lock.unlock();
+        T result = job.Compile();
+        lock.lock();
+        m_completed.emplace_back(job.Key, std::move(result));
+    }
+}
+}
\ No newline at end of file
@@ -11,6 +11,8 @@ class Node;
 
 namespace Kioto::Renderer
 {
+class Shader;
+
 struct PipelineState
 {
     eRenderLayerType LayerType = eRenderLayerType::Opaque;
@@ -2,86 +2,115 @@
 
 #include "Render/RenderCommand.h"
 
+#include "Core/DataStructures/RadixSort.h"
 #include "Render/RenderPass/RenderPass.h"
 #include "Render/ConstantBuffer.h"
 
-namespace Kioto::Renderer::RenderCommandHelpers
+namespace Kioto::Renderer
 {
-RenderCommand CreateRenderPacketCommand(RenderPacket packet, RenderPass* pass)
+void CommandList::AppendSorted(const CommandList* lists, uint32 listsCount)
 {
-    SubmitRenderPacketCommand rpCommand;
-    rpCommand.Packet = packet;
-
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eSubmitRenderPacket;
-    command.Command = rpCommand;
-    command.PassName = pass->GetName();
-
-    return command;
+    struct SortItem
+    {
+        uint64 Key;
+        const RenderCommandHeader* Command;
+    };
+
+    uint32 count = 0;
+    uint32 size = m_size;
+    for (uint32 l = 0; l < listsCount; ++l)
+    {
+        count += lists[l].GetCommandsCount();
+        size += lists[l].GetDataSize();
+    }
+    if (count == 0)
+        return;
+
+    SortItem* items = FrameAllocator::NewArray<SortItem>(count * 2);
+    uint32 i = 0;
+    for (uint32 l = 0; l < listsCount; ++l)
+    {
+        for (const RenderCommandHeader& cmd : lists[l])
+            items[i++] = { cmd.GetCommand<SubmitRenderPacketCommand>().SortKey, &cmd };
+    }
+    RadixSort(items, items + count, count, [](const SortItem& item) { return item.Key; });
+
+    Reserve(size);
+    for (i = 0; i < count; ++i)
+    {
+        memcpy(m_data + m_size, items[i].Command, items[i].Command->Size);
+        m_size += items[i].Command->Size;
+    }
+    m_commandsCount += count;
+}
 }
 
-RenderCommand CreateSetRenderTargetCommand(SetRenderTargetsCommand setRTCmd, RenderPass* pass)
+namespace Kioto::Renderer::RenderCommandHelpers
 {
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eSetRenderTargets;
-    command.Command = setRTCmd;
-    command.PassName = pass->GetName();
-
-    return command;
+void PushRenderPacketCommand(CommandList* commandList, const RenderPacket& packet, const RenderPass* pass)
+{
+    uint32 buffersCount = static_cast<uint32>(packet.ConstantBufferHandles.size());
+    uint32 constantsCount = static_cast<uint32>(packet.UniformConstants.size());
+    uint32 extraSize = buffersCount * sizeof(ConstantBufferHandle) + constantsCount * sizeof(uint32);
+
+    SubmitRenderPacketCommand& command = commandList->PushCommand<SubmitRenderPacketCommand>(pass->GetNameId(), extraSize);
+    command.Material = packet.Material;
+    command.Pass = packet.Pass;
+    command.Shader = packet.Shader;
+    command.VertexLayout = packet.VertexLayout;
+    command.TextureSet = packet.TextureSet;
+    command.Mesh = packet.Mesh;
+    command.SortKey = packet.SortKey;
+    command.InstanceCount = packet.InstanceCount;
+    command.ConstantBuffersCount = buffersCount;
+    command.UniformConstantsCount = constantsCount;
+    if (buffersCount > 0)
+        memcpy(command.GetConstantBufferHandles(), packet.ConstantBufferHandles.data(), buffersCount * sizeof(ConstantBufferHandle));
+    if (constantsCount > 0)
+        memcpy(command.GetUniformConstants(), packet.UniformConstants.data(), constantsCount * sizeof(uint32));
 }
 
-RenderCommand CreatePassEndsCommand(RenderPass* pass)
+void PushSetRenderTargetCommand(CommandList* commandList, const SetRenderTargetsCommand& setRTCmd, const RenderPass* pass)
 {
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eEndRenderPass;
-    command.PassName = pass->GetName();
-
-    return command;
+    commandList->PushCommand<SetRenderTargetsCommand>(pass->GetNameId()) = setRTCmd;
 }
 
-RenderCommand CreateBeginGpuEventCommand(std::string name)
+void PushPassEndsCommand(CommandList* commandList, const RenderPass* pass)
 {
-    BeginGpuEventCommand cmd;
-    cmd.Name = std::move(name);
-
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eBeginGpuEvent;
-    command.Command = cmd;
-
-    return command;
+    commandList->PushCommand<PassEndsCommand>(pass->GetNameId());
 }
 
-RenderCommand CreateEndGpuEventCommand()
+void PushBeginGpuEventCommand(CommandList* commandList, StringId name)
 {
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eEndGpuEvent;
-
-    return command;
+    commandList->PushCommand<BeginGpuEventCommand>().Name = name;
 }
 
-RenderCommand CreateGpuMarkerCommand(std::string name)
+void PushEndGpuEventCommand(CommandList* commandList)
 {
-    SetGpuMarkerCommand cmd;
-    cmd.Name = std::move(name);
-
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eSetGpuMarker;
-    command.Command = cmd;
+    commandList->PushCommand<EndGpuEventCommand>();
+}
 
-    return command;
+void PushGpuMarkerCommand(CommandList* commandList, StringId name)
+{
+    commandList->PushCommand<SetGpuMarkerCommand>().Name = name;
 }
 
-RenderCommand CreateResourceTransitonCommand(TextureHandle handle, eResourceState destState, RenderPass* pass)
+#ifdef _DEBUG
+void PushBeginGpuEventCommand(CommandList* commandList, const std::string& name)
 {
-    ResourceTransitonCommand cmd;
-    cmd.ResourceHandle = handle;
-    cmd.DestState = destState;
+    PushBeginGpuEventCommand(commandList, StringTable::Intern(name));
+}
 
-    RenderCommand command;
-    command.CommandType = eRenderCommandType::eResourceTransitonCommand;
-    command.PassName = pass->GetName();
-    command.Command = cmd;
+void PushGpuMarkerCommand(CommandList* commandList, const std::string& name)
+{
+    PushGpuMarkerCommand(commandList, StringTable::Intern(name));
+}
+#endif
 
-    return command;
+void PushResourceTransitonCommand(CommandList* commandList, TextureHandle handle, eResourceState destState, const RenderPass* pass)
+{
+    ResourceTransitonCommand& command = commandList->PushCommand<ResourceTransitonCommand>(pass->GetNameId());
+    command.ResourceHandle = handle;
+    command.DestState = destState;
 }
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
-#include <variant>
+#include <cstring>
+#include <type_traits>
 
 #include "Core/CoreTypes.h"
+#include "Core/DataStructures/StringTable.h"
+#include "Core/Memory/FrameAllocator.h"
 #include "Math/Rect.h"
 #include "Render/Color.h"
 #include "Render/RendererPublic.h"
@@ -25,9 +29,14 @@ enum class eRenderCommandType
     eResourceTransitonCommand
 };
 
+// Commands are written to CommandList as raw bytes and read in place by the backend, so all of them must be trivially copyable.
+// Type of the command is known from its header, every command struct names its own type.
+
 struct SetRenderTargetsCommand final
 {
 public:
+    static constexpr eRenderCommandType Type = eRenderCommandType::eSetRenderTargets;
+
     void SetRenderTargets(
         TextureHandle rt0 = InvalidHandle,
         TextureHandle rt1 = InvalidHandle,
@@ -125,78 +134,294 @@ struct SubmitConstantBufferCommand final
 
 struct ResourceTransitonCommand final
 {
+    static constexpr eRenderCommandType Type = eRenderCommandType::eResourceTransitonCommand;
+
     TextureHandle ResourceHandle;
     eResourceState DestState;
 };
 
+///
+/// Draw of one render packet. Constant buffer handles and uniform constants follow the command in the stream.
+///
 struct SubmitRenderPacketCommand final
 {
-    RenderPacket Packet;
+    static constexpr eRenderCommandType Type = eRenderCommandType::eSubmitRenderPacket;
+
+    MaterialHandle Material;
+    RenderPassHandle Pass;
+    ShaderHandle Shader;
+    VertexLayoutHandle VertexLayout;
+    TextureSetHandle TextureSet;
+    MeshHandle Mesh;
+    uint64 SortKey = 0;
+    uint32 InstanceCount = 1;
+    uint32 ConstantBuffersCount = 0;
+    uint32 UniformConstantsCount = 0;
+
+    ConstantBufferHandle* GetConstantBufferHandles();
+    const ConstantBufferHandle* GetConstantBufferHandles() const;
+    uint32* GetUniformConstants();
+    const uint32* GetUniformConstants() const;
 };
 
-struct BeginGpuEventCommand
+struct BeginGpuEventCommand final
 {
-    std::string Name;
+    static constexpr eRenderCommandType Type = eRenderCommandType::eBeginGpuEvent;
+
+    StringId Name = InvalidStringId;
 };
 
-struct EndGpuEventCommand
+struct EndGpuEventCommand final
 {
+    static constexpr eRenderCommandType Type = eRenderCommandType::eEndGpuEvent;
 };
 
-struct SetGpuMarkerCommand
+struct SetGpuMarkerCommand final
 {
-    std::string Name;
+    static constexpr eRenderCommandType Type = eRenderCommandType::eSetGpuMarker;
+
+    StringId Name = InvalidStringId;
 };
 
-struct RenderCommand
+struct PassEndsCommand final
+{
+    static constexpr eRenderCommandType Type = eRenderCommandType::eEndRenderPass;
+};
+
+///
+/// Fixed size part of every command in the stream. Command struct follows the header, variable size data follows the command.
+///
+struct alignas(8) RenderCommandHeader
 {
     eRenderCommandType CommandType = eRenderCommandType::eInvalidCommand;
-    std::variant<SetRenderTargetsCommand, SubmitConstantBufferCommand, SubmitRenderPacketCommand, BeginGpuEventCommand, EndGpuEventCommand, SetGpuMarkerCommand, ResourceTransitonCommand> Command;
+    StringId PassName = InvalidStringId; // [a_vorontcov] For debugging.
+    uint32 Size = 0; // Size of the whole command including header, aligned to header alignment.
 
-    std::string PassName; // [a_vorontcov] For debugging.
+    template <typename T>
+    const T& GetCommand() const;
 };
 
-struct PassEndsCommand
-{};
-
+///
+/// Packed stream of commands of one pass. Commands are written once into a linear buffer in frame memory and read in place by the backend.
+/// List itself is trivially destructible, it may be allocated in frame memory and is valid while its frame memory is.
+///
 class CommandList
 {
 public:
-    CommandList()
-    {
-        m_commands.reserve(512);
-    }
-
-    void PushCommand(RenderCommand&& command)
-    {
-        m_commands.push_back(command);
-    }
-
-    void ClearCommands()
-    {
-        m_commands.clear();
-    }
-
-    const std::vector<RenderCommand>& GetCommands() const
+    class Iterator
     {
-        return m_commands;
-    }
+    public:
+        explicit Iterator(const byte* command) : m_command(command)
+        {
+        }
+
+        const RenderCommandHeader& operator*() const
+        {
+            return *reinterpret_cast<const RenderCommandHeader*>(m_command);
+        }
+
+        Iterator& operator++()
+        {
+            m_command += (**this).Size;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_command != other.m_command;
+        }
+
+    private:
+        const byte* m_command = nullptr;
+    };
+
+    static constexpr uint32 DefaultCapacity = 16 * 1024;
+
+    ///
+    /// Frame memory for capacity bytes is taken right away, zero capacity list allocates on the first push.
+    ///
+    explicit CommandList(uint32 capacity = DefaultCapacity);
+
+    ///
+    /// Append command T followed by extraSize bytes of uninitialized data. Returned reference is valid until the next push.
+    ///
+    template <typename T>
+    T& PushCommand(StringId passName = InvalidStringId, uint32 extraSize = 0);
+    ///
+    /// Append all commands of other list preserving their order. Used to join lists recorded in parallel.
+    ///
+    void Append(const CommandList& other);
+    ///
+    /// Append all commands of listsCount lists one after another, reserving memory once.
+    ///
+    void Append(const CommandList* lists, uint32 listsCount);
+    ///
+    /// Append render packet commands of other list ordered by their sort keys. Packets with equal keys keep their order.
+    /// other must contain only SubmitRenderPacketCommand.
+    ///
+    void AppendSorted(const CommandList& other);
+    ///
+    /// Same as AppendSorted for commands of listsCount lists taken in list order, so chunks recorded in parallel are
+    /// sorted without joining them first.
+    ///
+    void AppendSorted(const CommandList* lists, uint32 listsCount);
+
+    void ClearCommands();
+
+    uint32 GetCommandsCount() const;
+    uint32 GetDataSize() const;
+
+    Iterator begin() const;
+    Iterator end() const;
 
 private:
-    std::vector<RenderCommand> m_commands;
+    void Reserve(uint32 size);
+
+    byte* m_data = nullptr;
+    uint32 m_size = 0;
+    uint32 m_capacity = 0;
+    uint32 m_commandsCount = 0;
 };
 
 namespace RenderCommandHelpers
 {
-RenderCommand CreateRenderPacketCommand(RenderPacket packet, RenderPass* pass);
-RenderCommand CreateSetRenderTargetCommand(SetRenderTargetsCommand setRTCmd, RenderPass* pass);
-RenderCommand CreateSetRenderTargetCommand(SetRenderTargetsCommand setRTCmd, RenderPass* pass);
-RenderCommand CreatePassEndsCommand(RenderPass* pass);
-RenderCommand CreateBeginGpuEventCommand(std::string name);
-RenderCommand CreateEndGpuEventCommand();
-RenderCommand CreateGpuMarkerCommand(std::string name);
-RenderCommand CreateResourceTransitonCommand(TextureHandle handle, eResourceState destState, RenderPass* pass);
+void PushRenderPacketCommand(CommandList* commandList, const RenderPacket& packet, const RenderPass* pass);
+void PushSetRenderTargetCommand(CommandList* commandList, const SetRenderTargetsCommand& setRTCmd, const RenderPass* pass);
+void PushPassEndsCommand(CommandList* commandList, const RenderPass* pass);
+void PushBeginGpuEventCommand(CommandList* commandList, StringId name);
+void PushEndGpuEventCommand(CommandList* commandList);
+void PushGpuMarkerCommand(CommandList* commandList, StringId name);
+#ifdef _DEBUG
+///
+/// Debug only overloads for ad hoc names. Every call interns the name under the string table lock and new names are never
+/// released, so recording code interns its names once and passes ids.
+///
+void PushBeginGpuEventCommand(CommandList* commandList, const std::string& name);
+void PushGpuMarkerCommand(CommandList* commandList, const std::string& name);
+#endif
+void PushResourceTransitonCommand(CommandList* commandList, TextureHandle handle, eResourceState destState, const RenderPass* pass);
+
+///
+/// Scope GPU event in the command list. Name is interned once per call site, so it must be the same on every call.
+///
+#define SCOPED_GPU_EVENT(cmdList, name) \
+    static const StringId ____gpuEventName___ ## __LINE__ = StringTable::Intern(name); \
+    ScopedGpuProfiler ____scopedProfiler___ ## __LINE__(cmdList, ____gpuEventName___ ## __LINE__);
+}
 
-#define SCOPED_GPU_EVENT(name) ScopedGpuProfiler ____scopedProfiler___ ## __LINE__(this, name);
+inline ConstantBufferHandle* SubmitRenderPacketCommand::GetConstantBufferHandles()
+{
+    return reinterpret_cast<ConstantBufferHandle*>(this + 1);
+}
+
+inline const ConstantBufferHandle* SubmitRenderPacketCommand::GetConstantBufferHandles() const
+{
+    return reinterpret_cast<const ConstantBufferHandle*>(this + 1);
+}
+
+inline uint32* SubmitRenderPacketCommand::GetUniformConstants()
+{
+    return reinterpret_cast<uint32*>(GetConstantBufferHandles() + ConstantBuffersCount);
+}
+
+inline const uint32* SubmitRenderPacketCommand::GetUniformConstants() const
+{
+    return reinterpret_cast<const uint32*>(GetConstantBufferHandles() + ConstantBuffersCount);
+}
+
+template <typename T>
+inline const T& RenderCommandHeader::GetCommand() const
+{
+    assert(T::Type == CommandType);
+    return *reinterpret_cast<const T*>(this + 1);
+}
+
+inline CommandList::CommandList(uint32 capacity)
+    : m_data(capacity > 0 ? static_cast<byte*>(FrameAllocator::Allocate(capacity, alignof(RenderCommandHeader))) : nullptr)
+    , m_capacity(capacity)
+{
+}
+
+template <typename T>
+T& CommandList::PushCommand(StringId passName, uint32 extraSize)
+{
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "Render commands must be POD.");
+    static_assert(alignof(T) <= alignof(RenderCommandHeader), "Render command alignment is too big.");
+
+    constexpr uint32 alignment = alignof(RenderCommandHeader);
+    uint32 size = (static_cast<uint32>(sizeof(RenderCommandHeader) + sizeof(T)) + extraSize + alignment - 1) & ~(alignment - 1);
+    Reserve(m_size + size);
+
+    RenderCommandHeader* header = new (m_data + m_size) RenderCommandHeader();
+    header->CommandType = T::Type;
+    header->PassName = passName;
+    header->Size = size;
+    m_size += size;
+    ++m_commandsCount;
+    return *new (header + 1) T();
+}
+
+inline void CommandList::Append(const CommandList& other)
+{
+    if (other.m_size == 0)
+        return;
+    Reserve(m_size + other.m_size);
+    memcpy(m_data + m_size, other.m_data, other.m_size);
+    m_size += other.m_size;
+    m_commandsCount += other.m_commandsCount;
+}
+
+inline void CommandList::Append(const CommandList* lists, uint32 listsCount)
+{
+    uint32 size = m_size;
+    for (uint32 i = 0; i < listsCount; ++i)
+        size += lists[i].m_size;
+    Reserve(size);
+    for (uint32 i = 0; i < listsCount; ++i)
+        Append(lists[i]);
+}
+
+inline void CommandList::AppendSorted(const CommandList& other)
+{
+    AppendSorted(&other, 1);
+}
+
+inline void CommandList::Reserve(uint32 size)
+{
+    if (size <= m_capacity)
+        return;
+    // Old buffer is frame memory and is released with the frame, commands are POD so they are just moved with memcpy.
+    uint32 capacity = (std::max)(m_capacity * 2, size);
+    byte* data = static_cast<byte*>(FrameAllocator::Allocate(capacity, alignof(RenderCommandHeader)));
+    if (m_size > 0)
+        memcpy(data, m_data, m_size);
+    m_data = data;
+    m_capacity = capacity;
+}
+
+inline void CommandList::ClearCommands()
+{
+    m_size = 0;
+    m_commandsCount = 0;
+}
+
+inline uint32 CommandList::GetCommandsCount() const
+{
+    return m_commandsCount;
+}
+
+inline uint32 CommandList::GetDataSize() const
+{
+    return m_size;
+}
+
+inline CommandList::Iterator CommandList::begin() const
+{
+    return Iterator(m_data);
+}
+
+inline CommandList::Iterator CommandList::end() const
+{
+    return Iterator(m_data + m_size);
 }
 }
\ No newline at end of file
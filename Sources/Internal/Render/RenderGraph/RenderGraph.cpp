@@ -2,6 +2,11 @@
 
 #include "Render/RenderGraph/RenderGraph.h"
 
+#include <algorithm>
+
+#include "Core/CoreHelpers.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Logger/Logger.h"
 #include "Render/Renderer.h"
 #include "Render/RenderOptions.h"
 #include "Render/RenderPass/RenderPass.h"
@@ -13,14 +18,28 @@ namespace Kioto::Renderer
 RenderGraph::RenderGraph()
 {
     m_registredPasses.reserve(RenderOptions::MaxRenderPassesCount);
+    m_configuredPasses.reserve(RenderOptions::MaxRenderPassesCount);
+    m_configuredBlackboards.reserve(RenderOptions::MaxRenderPassesCount);
     m_activePasses.reserve(RenderOptions::MaxRenderPassesCount);
-
-    m_commandListPool.resize(RenderOptions::MaxRenderCommandsCount);
 }
 
 void RenderGraph::AddPass(RenderPass* renderPass)
 {
     m_registredPasses.push_back(renderPass);
+    Invalidate();
+}
+
+void RenderGraph::RemovePass(RenderPass* renderPass)
+{
+    m_registredPasses.erase(std::remove(m_registredPasses.begin(), m_registredPasses.end(), renderPass), m_registredPasses.end());
+    m_cachedGraphs.clear(); // Address of the removed pass may be reused by a new one.
+    m_currentGraph = nullptr;
+    Invalidate();
+}
+
+void RenderGraph::Invalidate()
+{
+    m_isDirty = true;
 }
 
 RenderGraph::~RenderGraph()
@@ -30,13 +49,103 @@ RenderGraph::~RenderGraph()
 
 void RenderGraph::SheduleGraph()
 {
+    if (m_isDirty)
+    {
+        uint64 key = ConfigurePasses();
+        CachedGraph* graph = FindCachedGraph(key);
+        if (graph == nullptr)
+            graph = CompileGraph(key);
+        if (graph != m_currentGraph)
+        {
+            m_currentGraph = graph;
+            m_resourceTable.AcquireTransientResources(graph->Graph);
+        }
+        m_isDirty = false;
+    }
+    m_resourceTable.ReleaseUnusedTextures();
+
+    UpdateTransitions();
+
+    for (const auto& compiledPass : m_currentGraph->Graph.Passes)
+        m_activePasses.push_back({ m_currentGraph->Passes[compiledPass.PassIndex], FrameAllocator::New<CommandList>(), &compiledPass.Transitions });
+}
+
+uint64 RenderGraph::ConfigurePasses()
+{
+    m_resourceTable.ClearBlackboards();
+    m_configuredPasses.clear();
+    m_configuredBlackboards.clear();
+
+    uint64 key = 0;
     for (auto pass : m_registredPasses)
     {
         PassBlackboard* passBlackboard = m_resourceTable.GetNextBlackboard();
         passBlackboard->first = pass;
         if (pass->ConfigureInputsAndOutputs(passBlackboard->second))
-            m_activePasses.push_back({ pass, &m_commandListPool[m_currentCommandListIndex++] });
+        {
+            m_configuredPasses.push_back(pass);
+            m_configuredBlackboards.push_back(&passBlackboard->second);
+            key = HashCombine(key, PtrToUint(pass));
+            key = HashCombine(key, passBlackboard->second.GetHash());
+        }
+    }
+    return key;
+}
+
+RenderGraph::CachedGraph* RenderGraph::FindCachedGraph(uint64 key)
+{
+    for (auto& graph : m_cachedGraphs)
+    {
+        if (graph->Key == key && graph->Passes == m_configuredPasses)
+            return graph.get();
+    }
+    return nullptr;
+}
+
+RenderGraph::CachedGraph* RenderGraph::CompileGraph(uint64 key)
+{
+    if (m_cachedGraphs.size() >= MaxCachedGraphsCount)
+    {
+        auto oldest = m_cachedGraphs.begin();
+        if (oldest->get() == m_currentGraph)
+            ++oldest;
+        m_cachedGraphs.erase(oldest);
+    }
+
+    m_cachedGraphs.push_back(std::make_unique<CachedGraph>());
+    CachedGraph* graph = m_cachedGraphs.back().get();
+    graph->Key = key;
+    graph->Passes = m_configuredPasses;
+    m_compiler.Compile(m_configuredBlackboards, graph->Graph);
+    assert(!graph->Graph.HasCycle && "Render passes have cyclic resource dependencies");
+
+    if (graph->Graph.TransientMemorySize != m_reportedTransientMemorySize || graph->Graph.AliasedMemorySize != m_reportedAliasedMemorySize)
+    {
+        m_reportedTransientMemorySize = graph->Graph.TransientMemorySize;
+        m_reportedAliasedMemorySize = graph->Graph.AliasedMemorySize;
+        LOG("Render graph transient memory, bytes: ", m_reportedTransientMemorySize, " without aliasing, ", m_reportedAliasedMemorySize, " with aliasing.");
     }
+    return graph;
+}
+
+void RenderGraph::UpdateTransitions()
+{
+    // Transitions depend only on states left by the previous frame, so they are recomputed only until the graph reaches steady state.
+    // Copies below reuse capacity of the cached states, so they don't allocate.
+    ResourceStates& states = m_resourceTable.GetPhysicalStates();
+    if (!m_currentGraph->HasTransitions || states != m_currentGraph->StatesBefore)
+    {
+        m_currentGraph->StatesBefore = states;
+        RenderGraphCompiler::ComputeTransitions(states, m_currentGraph->Graph);
+        m_currentGraph->StatesAfter = states;
+        m_currentGraph->HasTransitions = true;
+        m_currentGraph->KeepsStates = states == m_currentGraph->StatesBefore;
+    }
+    else if (!m_currentGraph->KeepsStates)
+    {
+        states = m_currentGraph->StatesAfter; // Steady state graphs skip the copy, their states are already equal.
+    }
+    m_resourceTable.CommitPhysicalStates();
 }
 
 void RenderGraph::Execute(DrawData& drawData)
@@ -47,42 +156,55 @@ void RenderGraph::Execute(DrawData& drawData)
         submInfo.Pass->Setup();
     }
 
+    // Transitions are recorded serially, passes only read the resource table while recording.
     for (auto& submInfo : m_activePasses)
     {
-        submInfo.CmdList->PushCommand(RenderCommandHelpers::CreateBeginGpuEventCommand(submInfo.Pass->GetName()));
-        ResourcesBlackboard* blackboard = m_resourceTable.GetBalackboardForPass(submInfo.Pass);
-
-        m_resourceTable.CreateResourcesForPass(submInfo.Pass);
-        for (const auto& transitions : blackboard->GetTransitionRequests())
+        RenderCommandHelpers::PushBeginGpuEventCommand(submInfo.CmdList, submInfo.Pass->GetNameId());
+        for (const auto& transitions : *submInfo.Transitions)
         {
             Texture* tex = m_resourceTable.GetResource(transitions.ResourceName);
-            submInfo.CmdList->PushCommand(RenderCommandHelpers::CreateResourceTransitonCommand(tex->GetHandle(), transitions.TransitionTo, submInfo.Pass));
+            RenderCommandHelpers::PushResourceTransitonCommand(submInfo.CmdList, tex->GetHandle(), transitions.TransitionTo, submInfo.Pass);
         }
+    }
 
-        submInfo.Pass->BuildRenderPackets(submInfo.CmdList, m_resourceTable);
+    // Every pass records to its own list, Submit keeps the order of m_activePasses.
+    JobSystem::JobCounter counter;
+    for (auto& submInfo : m_activePasses)
+    {
+        JobSystem::Run([this, &submInfo]()
+        {
+            submInfo.Pass->BuildRenderPackets(submInfo.CmdList, m_resourceTable);
+        }, &counter);
+    }
+    JobSystem::Wait(&counter);
+
+    for (auto& submInfo : m_activePasses)
+    {
         submInfo.Pass->Cleanup();
-        submInfo.CmdList->PushCommand(RenderCommandHelpers::CreateEndGpuEventCommand());
+        RenderCommandHelpers::PushEndGpuEventCommand(submInfo.CmdList);
+        submInfo.Pass->SetDrawData(nullptr); // Draw data lives in frame memory of the caller.
     }
-    m_resourceTable.ClearBlackboards();
 }
 
 void RenderGraph::Submit()
 {
     for (auto& submInfo : m_activePasses)
     {
-        Renderer::SubmitRenderCommands(submInfo.CmdList->GetCommands());
+        Renderer::SubmitRenderCommands(submInfo.CmdList);
         submInfo.Pass->Cleanup();
     }
-    Clear();
+    m_activePasses.clear();
 }
 
 void RenderGraph::Clear()
 {
     m_registredPasses.clear();
+    m_configuredPasses.clear();
+    m_configuredBlackboards.clear();
     m_activePasses.clear();
-    for (uint32 i = 0; i < m_currentCommandListIndex; ++i)
-        m_commandListPool[i].ClearCommands();
-    m_currentCommandListIndex = 0;
+    m_cachedGraphs.clear();
+    m_currentGraph = nullptr;
+    m_isDirty = true;
 }
 
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+
+#include "Render/RenderGraph/RenderGraphCompiler.h"
 #include "Render/RenderGraph/ResourceTable.h"
 #include "Render/RenderCommand.h"
 
@@ -16,24 +19,55 @@ public:
     ~RenderGraph();
 
     // TODO: [a_vorontcov] Maybe move ownership of passes here?
-    void AddPass(RenderPass* renderPass);
+    void AddPass(RenderPass* renderPass); // Passes stay registered between frames.
+    void RemovePass(RenderPass* renderPass);
+    ///
+    /// Query passes for their inputs and outputs in the next SheduleGraph. Must be called when anything ConfigureInputsAndOutputs
+    /// depends on changes, e.g. render mode or resolution. Otherwise the graph compiled for the previous frame is replayed.
+    ///
+    void Invalidate();
     void SheduleGraph();
     void Execute(DrawData& drawData); // [a_vorontcov] TODO: for now, normally call culling system for object for pass.
     void Submit();
     void Clear();
 
 private:
+    static constexpr uint32 MaxCachedGraphsCount = 8;
+
+    struct CachedGraph
+    {
+        uint64 Key = 0;
+        std::vector<RenderPass*> Passes; // Configured passes in registration order, indexed by CompiledPass::PassIndex.
+        CompiledGraph Graph;
+        ResourceStates StatesBefore; // States of physical resources the transitions were computed for.
+        ResourceStates StatesAfter;
+        bool HasTransitions = false;
+        bool KeepsStates = false; // StatesAfter are equal to StatesBefore, so replaying the graph leaves physical states as they are.
+    };
+
     struct PassSubmitionInfo
     {
         RenderPass* Pass;
         CommandList* CmdList;
+        const std::vector<ResourceTransitionRequest>* Transitions;
     };
 
+    uint64 ConfigurePasses();
+    CachedGraph* FindCachedGraph(uint64 key);
+    CachedGraph* CompileGraph(uint64 key);
+    void UpdateTransitions();
+
     std::vector<RenderPass*> m_registredPasses;
-    std::vector<PassSubmitionInfo> m_activePasses;
+    std::vector<RenderPass*> m_configuredPasses; // Passes which want to run, in registration order.
+    std::vector<const ResourcesBlackboard*> m_configuredBlackboards;
+    std::vector<PassSubmitionInfo> m_activePasses; // Sorted and culled. Command lists are allocated in frame memory, backend reads them until the end of the frame.
 
-    std::vector<CommandList> m_commandListPool;
-    uint32 m_currentCommandListIndex = 0;
+    RenderGraphCompiler m_compiler;
+    std::vector<std::unique_ptr<CachedGraph>> m_cachedGraphs; // Keyed by passes and their declarations, so switching render modes back doesn't recompile.
+    CachedGraph* m_currentGraph = nullptr;
+    bool m_isDirty = true;
+    uint64 m_reportedTransientMemorySize = 0;
+    uint64 m_reportedAliasedMemorySize = 0;
 
     ResourceTable m_resourceTable;
 };
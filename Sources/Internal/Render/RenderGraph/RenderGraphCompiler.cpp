@@ -0,0 +1,275 @@
+#include "stdafx.h"
+
+#include "Render/RenderGraph/RenderGraphCompiler.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace Kioto::Renderer
+{
+
+void RenderGraphCompiler::Compile(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result)
+{
+    result.Clear();
+    uint32 passesCount = static_cast<uint32>(passes.size());
+
+    for (auto& it : m_accesses)
+        it.second.clear();
+    m_backBufferWriters.clear();
+    m_successors.resize(passesCount);
+    m_producers.resize(passesCount);
+    for (uint32 i = 0; i < passesCount; ++i)
+    {
+        m_successors[i].clear();
+        m_producers[i].clear();
+    }
+
+    for (uint32 i = 0; i < passesCount; ++i)
+    {
+        for (const auto& request : passes[i]->GetCreationRequest())
+            AddAccess(request.ResourceName, i, true);
+        for (const auto& request : passes[i]->GetTransitionRequests())
+            AddAccess(request.ResourceName, i, request.IsWrite);
+        if (passes[i]->GetWritesBackBuffer())
+            m_backBufferWriters.push_back(i);
+    }
+
+    for (const auto& it : m_accesses)
+        BuildEdges(it.second);
+    for (uint32 i = 1; i < m_backBufferWriters.size(); ++i)
+        AddEdge(m_backBufferWriters[i - 1], m_backBufferWriters[i], true);
+
+    CullPasses(passesCount);
+    SortPasses(passesCount, result);
+    ComputeLifetimes(passes, result);
+    AliasResources(result);
+    ResolveTransitions(passes, result);
+}
+
+void RenderGraphCompiler::AddAccess(const std::string& resource, uint32 pass, bool isWrite)
+{
+    std::vector<ResourceAccess>& accesses = m_accesses[resource];
+    if (!accesses.empty() && accesses.back().Pass == pass)
+        accesses.back().IsWrite |= isWrite;
+    else
+        accesses.push_back({ pass, isWrite });
+}
+
+void RenderGraphCompiler::AddEdge(uint32 from, uint32 to, bool isDataDependency)
+{
+    if (from == to)
+        return;
+    m_successors[from].push_back(to);
+    if (isDataDependency)
+        m_producers[to].push_back(from);
+}
+
+void RenderGraphCompiler::BuildEdges(const std::vector<ResourceAccess>& accesses)
+{
+    int64 lastWriter = -1;
+    for (const auto& access : accesses)
+    {
+        if (access.IsWrite)
+            lastWriter = access.Pass;
+    }
+
+    int64 prevWriter = -1;
+    size_t readersBegin = 0; // Readers of the prevWriter result, they must finish before the next write.
+    for (size_t i = 0; i < accesses.size(); ++i)
+    {
+        const ResourceAccess& access = accesses[i];
+        if (access.IsWrite)
+        {
+            if (prevWriter >= 0)
+            {
+                AddEdge(static_cast<uint32>(prevWriter), access.Pass, true);
+                for (size_t j = readersBegin; j < i; ++j)
+                    AddEdge(accesses[j].Pass, access.Pass, false);
+            }
+            prevWriter = access.Pass;
+            readersBegin = i + 1;
+        }
+        else
+        {
+            int64 producer = prevWriter >= 0 ? prevWriter : lastWriter;
+            if (producer >= 0)
+                AddEdge(static_cast<uint32>(producer), access.Pass, true);
+        }
+    }
+}
+
+void RenderGraphCompiler::CullPasses(uint32 passesCount)
+{
+    m_isAlive.assign(passesCount, false);
+    m_stack.clear();
+    for (uint32 writer : m_backBufferWriters)
+    {
+        m_isAlive[writer] = true;
+        m_stack.push_back(writer);
+    }
+
+    while (!m_stack.empty())
+    {
+        uint32 pass = m_stack.back();
+        m_stack.pop_back();
+        for (uint32 producer : m_producers[pass])
+        {
+            if (m_isAlive[producer])
+                continue;
+            m_isAlive[producer] = true;
+            m_stack.push_back(producer);
+        }
+    }
+}
+
+void RenderGraphCompiler::SortPasses(uint32 passesCount, CompiledGraph& result)
+{
+    m_inDegree.assign(passesCount, 0);
+    std::priority_queue<uint32, std::vector<uint32>, std::greater<uint32>> ready;
+    uint32 aliveCount = 0;
+    for (uint32 i = 0; i < passesCount; ++i)
+    {
+        if (!m_isAlive[i])
+        {
+            result.CulledPasses.push_back(i);
+            continue;
+        }
+        ++aliveCount;
+        for (uint32 succ : m_successors[i])
+            ++m_inDegree[succ]; // Successors of alive pass may be culled, their degree is never read.
+    }
+    for (uint32 i = 0; i < passesCount; ++i)
+    {
+        if (m_isAlive[i] && m_inDegree[i] == 0)
+            ready.push(i);
+    }
+
+    while (!ready.empty())
+    {
+        uint32 pass = ready.top();
+        ready.pop();
+        result.Passes.push_back({ pass, {} });
+        for (uint32 succ : m_successors[pass])
+        {
+            if (m_isAlive[succ] && --m_inDegree[succ] == 0)
+                ready.push(succ);
+        }
+    }
+
+    if (result.Passes.size() != aliveCount)
+    {
+        // Passes of the cycle are executed in registration order, so the frame is still rendered.
+        result.HasCycle = true;
+        for (uint32 i = 0; i < passesCount; ++i)
+        {
+            if (m_isAlive[i] && m_inDegree[i] > 0)
+                result.Passes.push_back({ i, {} });
+        }
+    }
+}
+
+void RenderGraphCompiler::ComputeLifetimes(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result)
+{
+    m_transientIndices.clear();
+    m_transientDescs.clear();
+    uint32 passesCount = static_cast<uint32>(result.Passes.size());
+    for (uint32 pos = 0; pos < passesCount; ++pos)
+    {
+        for (const auto& request : passes[result.Passes[pos].PassIndex]->GetCreationRequest())
+        {
+            auto it = m_transientIndices.find(request.ResourceName);
+            if (it != m_transientIndices.end())
+            {
+                assert(*m_transientDescs[it->second] == request.Desc && "Resource is created with different descriptors");
+                continue;
+            }
+            m_transientIndices.emplace(request.ResourceName, static_cast<uint32>(result.TransientResources.size()));
+            m_transientDescs.push_back(&request.Desc);
+            result.TransientResources.push_back({ request.ResourceName, pos, pos, 0 });
+        }
+    }
+
+    for (uint32 pos = 0; pos < passesCount; ++pos)
+    {
+        for (const auto& request : passes[result.Passes[pos].PassIndex]->GetTransitionRequests())
+        {
+            auto it = m_transientIndices.find(request.ResourceName);
+            if (it == m_transientIndices.end())
+                continue;
+            TransientResource& resource = result.TransientResources[it->second];
+            resource.FirstUse = (std::min)(resource.FirstUse, pos);
+            resource.LastUse = (std::max)(resource.LastUse, pos);
+        }
+    }
+}
+
+void RenderGraphCompiler::AliasResources(CompiledGraph& result)
+{
+    // Greedy interval assignment in order of first use: take the first compatible allocation which is free since its last use.
+    m_transientOrder.resize(result.TransientResources.size());
+    for (uint32 i = 0; i < m_transientOrder.size(); ++i)
+        m_transientOrder[i] = i;
+    std::stable_sort(m_transientOrder.begin(), m_transientOrder.end(), [&result](uint32 a, uint32 b)
+    {
+        return result.TransientResources[a].FirstUse < result.TransientResources[b].FirstUse;
+    });
+
+    m_physicalLastUses.clear();
+    for (uint32 index : m_transientOrder)
+    {
+        TransientResource& resource = result.TransientResources[index];
+        const TextureDescriptor& desc = *m_transientDescs[index];
+        result.TransientMemorySize += GetTextureSize(desc);
+
+        uint32 physical = 0;
+        for (; physical < result.PhysicalResources.size(); ++physical)
+        {
+            if (m_physicalLastUses[physical] < resource.FirstUse && result.PhysicalResources[physical] == desc)
+                break;
+        }
+        if (physical == result.PhysicalResources.size())
+        {
+            result.PhysicalResources.push_back(desc);
+            m_physicalLastUses.push_back(0);
+            result.AliasedMemorySize += GetTextureSize(desc);
+        }
+        m_physicalLastUses[physical] = resource.LastUse;
+        resource.PhysicalIndex = physical;
+    }
+}
+
+void RenderGraphCompiler::ResolveTransitions(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result) const
+{
+    for (auto& compiledPass : result.Passes)
+    {
+        for (const auto& request : passes[compiledPass.PassIndex]->GetTransitionRequests())
+        {
+            auto it = m_transientIndices.find(request.ResourceName);
+            uint32 physicalIndex = it != m_transientIndices.end() ? result.TransientResources[it->second].PhysicalIndex : InvalidPhysicalIndex;
+            compiledPass.RequestedTransitions.push_back({ request, physicalIndex });
+        }
+    }
+}
+
+void RenderGraphCompiler::ComputeTransitions(ResourceStates& states, CompiledGraph& result)
+{
+    assert(states.size() == result.PhysicalResources.size());
+    for (auto& compiledPass : result.Passes)
+    {
+        compiledPass.Transitions.clear();
+        for (const auto& transition : compiledPass.RequestedTransitions)
+        {
+            if (transition.PhysicalIndex != InvalidPhysicalIndex)
+            {
+                eResourceState& state = states[transition.PhysicalIndex];
+                if (state == transition.Request.TransitionTo)
+                    continue;
+                state = transition.Request.TransitionTo;
+            }
+            compiledPass.Transitions.push_back(transition.Request);
+        }
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/CoreTypes.h"
+#include "Render/RenderGraph/ResourcesBlackboard.h"
+
+namespace Kioto::Renderer
+{
+using ResourceStates = std::vector<eResourceState>; // Indexed by physical resource.
+
+static constexpr uint32 InvalidPhysicalIndex = -1;
+
+struct PassTransition
+{
+    ResourceTransitionRequest Request;
+    uint32 PhysicalIndex = InvalidPhysicalIndex; // Resources not created by the graph have unknown state.
+};
+
+struct CompiledPass
+{
+    uint32 PassIndex = 0; // Index of the pass in the array given to the compiler.
+    std::vector<PassTransition> RequestedTransitions; // All transitions declared by the pass.
+    std::vector<ResourceTransitionRequest> Transitions; // Only transitions which really change resource state.
+};
+
+///
+/// Resource created by one of the passes. Lives only between its first and last use, so its memory may be shared with other transient resources.
+///
+struct TransientResource
+{
+    std::string Name;
+    uint32 FirstUse = 0; // Index in CompiledGraph::Passes.
+    uint32 LastUse = 0;
+    uint32 PhysicalIndex = 0; // Index in CompiledGraph::PhysicalResources.
+};
+
+struct CompiledGraph
+{
+    std::vector<CompiledPass> Passes; // Execution order.
+    std::vector<uint32> CulledPasses;
+    std::vector<TransientResource> TransientResources; // In order of creation.
+    std::vector<TextureDescriptor> PhysicalResources; // Allocations shared by transient resources with the same descriptor and disjoint lifetimes.
+    uint64 TransientMemorySize = 0; // Peak memory if every transient resource has its own allocation.
+    uint64 AliasedMemorySize = 0; // Peak memory of the physical resources.
+    bool HasCycle = false;
+
+    void Clear();
+};
+
+///
+/// Builds dependency graph of passes from their blackboards. Pass reading a resource depends on the last pass writing it before,
+/// or on the last writer of the frame if nobody writes it before. Writers of the same resource keep registration order, readers
+/// go before the next writer. Passes which don't contribute to the back buffer are culled, the rest are sorted topologically
+/// preferring registration order. Transient resources of the executed passes are assigned to physical resources by their lifetimes.
+/// Works on blackboards only, so it can be run and checked without GPU.
+///
+class RenderGraphCompiler
+{
+public:
+    ///
+    /// passes - blackboards of the active passes in registration order.
+    ///
+    void Compile(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result);
+    ///
+    /// Fill transitions of the compiled passes which really change resource state. Compiled graph doesn't reference blackboards,
+    /// so transitions can be recomputed for a cached graph.
+    /// states - states of physical resources before the frame, updated to states after the frame.
+    ///
+    static void ComputeTransitions(ResourceStates& states, CompiledGraph& result);
+
+private:
+    struct ResourceAccess
+    {
+        uint32 Pass = 0;
+        bool IsWrite = false;
+    };
+
+    void AddAccess(const std::string& resource, uint32 pass, bool isWrite);
+    void AddEdge(uint32 from, uint32 to, bool isDataDependency);
+    void BuildEdges(const std::vector<ResourceAccess>& accesses);
+    void CullPasses(uint32 passesCount);
+    void SortPasses(uint32 passesCount, CompiledGraph& result);
+    void ComputeLifetimes(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result);
+    void AliasResources(CompiledGraph& result);
+    void ResolveTransitions(const std::vector<const ResourcesBlackboard*>& passes, CompiledGraph& result) const;
+
+    std::unordered_map<std::string, std::vector<ResourceAccess>> m_accesses;
+    std::vector<uint32> m_backBufferWriters;
+    std::vector<std::vector<uint32>> m_successors; // All ordering edges.
+    std::vector<std::vector<uint32>> m_producers; // Reversed edges of passes consuming results, write after read doesn't make a pass needed.
+    std::vector<bool> m_isAlive;
+    std::vector<uint32> m_inDegree;
+    std::vector<uint32> m_stack;
+    std::unordered_map<std::string, uint32> m_transientIndices;
+    std::vector<const TextureDescriptor*> m_transientDescs;
+    std::vector<uint32> m_transientOrder;
+    std::vector<uint32> m_physicalLastUses;
+};
+
+inline void CompiledGraph::Clear()
+{
+    Passes.clear();
+    CulledPasses.clear();
+    TransientResources.clear();
+    PhysicalResources.clear();
+    TransientMemorySize = 0;
+    AliasedMemorySize = 0;
+    HasCycle = false;
+}
+}
\ No newline at end of file
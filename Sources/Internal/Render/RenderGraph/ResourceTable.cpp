@@ -14,8 +14,8 @@ ResourceTable::ResourceTable()
 
 ResourceTable::~ResourceTable()
 {
-    for (auto& it : m_resources)
-        SafeDelete(it.second);
+    for (auto& tex : m_texturePool)
+        SafeDelete(tex);
 }
 
 PassBlackboard* ResourceTable::GetNextBlackboard()
@@ -42,28 +42,95 @@ ResourcesBlackboard* ResourceTable::GetBalackboardForPass(const RenderPass* pass
     return &it->second;
 }
 
-void ResourceTable::ProcessCreationRequest(const ResourceCreationRequest& request)
+void ResourceTable::AcquireTransientResources(const CompiledGraph& graph)
 {
-    if (m_resources.count(request.ResourceName))
+    uint32 physicalCount = static_cast<uint32>(graph.PhysicalResources.size());
+    m_isPoolTextureUsed.assign(m_texturePool.size(), false);
+    m_physicalPoolIndices.resize(physicalCount, InvalidPoolIndex);
+
+    // Keep textures of the previous frame first, so unchanged graph maps to the same textures.
+    for (uint32 i = 0; i < physicalCount; ++i)
     {
-        const TextureDescriptor& desc = m_resources[request.ResourceName]->GetDescriptor();
-        if (desc != request.Desc)
-            assert(false && "To be implemented...");
+        uint32 poolIndex = m_physicalPoolIndices[i];
+        if (poolIndex < m_texturePool.size() && !m_isPoolTextureUsed[poolIndex]
+            && m_texturePool[poolIndex]->GetDescriptor() == graph.PhysicalResources[i])
+            m_isPoolTextureUsed[poolIndex] = true;
         else
-            return;
+            m_physicalPoolIndices[i] = InvalidPoolIndex;
+    }
+
+    for (uint32 i = 0; i < physicalCount; ++i)
+    {
+        if (m_physicalPoolIndices[i] != InvalidPoolIndex)
+            continue;
+
+        const TextureDescriptor& desc = graph.PhysicalResources[i];
+        uint32 poolIndex = 0;
+        for (; poolIndex < m_texturePool.size(); ++poolIndex)
+        {
+            if (!m_isPoolTextureUsed[poolIndex] && m_texturePool[poolIndex]->GetDescriptor() == desc)
+                break;
+        }
+        if (poolIndex == m_texturePool.size())
+        {
+            Texture* tex = new Texture(desc);
+            Renderer::RegisterRenderAsset(tex);
+            m_texturePool.push_back(tex);
+            m_isPoolTextureUsed.push_back(false);
+            m_poolTextureLastUseFrames.push_back(m_frameIndex);
+        }
+        m_isPoolTextureUsed[poolIndex] = true;
+        m_physicalPoolIndices[i] = poolIndex;
     }
-    Texture* tex = new Texture(request.Desc);
-    Renderer::RegisterRenderAsset(tex);
-    m_resources[request.ResourceName] = tex;
+
+    m_resources.clear();
+    for (const auto& resource : graph.TransientResources)
+        m_resources[resource.Name] = m_texturePool[m_physicalPoolIndices[resource.PhysicalIndex]];
+
+    m_physicalStates.resize(physicalCount);
+    for (uint32 i = 0; i < physicalCount; ++i)
+        m_physicalStates[i] = m_texturePool[m_physicalPoolIndices[i]]->GetCurrentState();
 }
 
-void ResourceTable::CreateResourcesForPass(const RenderPass* pass)
+void ResourceTable::ReleaseUnusedTextures()
 {
-    ResourcesBlackboard* blackboard = GetBalackboardForPass(pass);
-    for (const auto& request : blackboard->GetCreationRequest())
+    ++m_frameIndex;
+    uint32 kept = 0;
+    for (uint32 i = 0; i < m_texturePool.size(); ++i)
     {
-        ProcessCreationRequest(request);
+        if (m_isPoolTextureUsed[i])
+        {
+            m_poolTextureLastUseFrames[i] = m_frameIndex;
+        }
+        else if (m_frameIndex - m_poolTextureLastUseFrames[i] >= TextureReleaseDelayFrames)
+        {
+            Renderer::UnregisterTexture(m_texturePool[i]);
+            SafeDelete(m_texturePool[i]);
+            continue;
+        }
+
+        if (kept != i)
+        {
+            m_texturePool[kept] = m_texturePool[i];
+            m_isPoolTextureUsed[kept] = m_isPoolTextureUsed[i];
+            m_poolTextureLastUseFrames[kept] = m_poolTextureLastUseFrames[i];
+            for (auto& poolIndex : m_physicalPoolIndices)
+            {
+                if (poolIndex == i)
+                    poolIndex = kept;
+            }
+        }
+        ++kept;
     }
+    m_texturePool.resize(kept);
+    m_isPoolTextureUsed.resize(kept);
+    m_poolTextureLastUseFrames.resize(kept);
+}
+
+void ResourceTable::CommitPhysicalStates()
+{
+    for (uint32 i = 0; i < m_physicalStates.size(); ++i)
+        m_texturePool[m_physicalPoolIndices[i]]->SetCurrentState(m_physicalStates[i]);
 }
 
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <limits>
 #include <vector>
 #include <map>
 #include <string>
 
+#include "Render/RenderGraph/RenderGraphCompiler.h"
 #include "Render/RenderGraph/ResourcesBlackboard.h"
 
 namespace Kioto::Renderer
@@ -18,24 +20,51 @@ public:
 
     PassBlackboard* GetNextBlackboard();
     ResourcesBlackboard* GetBalackboardForPass(const RenderPass* pass);
-    void ProcessCreationRequest(const ResourceCreationRequest& request);
     void ClearBlackboards();
 
-    void CreateResourcesForPass(const RenderPass* pass);
+    ///
+    /// Bind every physical resource of the graph to a pooled texture with the same descriptor and map transient resources to them.
+    /// Textures keep their physical index while the graph doesn't change, new textures are created only when the pool has no free match.
+    ///
+    void AcquireTransientResources(const CompiledGraph& graph);
+    ///
+    /// States of the physical resources of the last acquired graph. Write them back with CommitPhysicalStates after computing transitions.
+    ///
+    ResourceStates& GetPhysicalStates();
+    void CommitPhysicalStates();
+    ///
+    /// Delete pooled textures not bound to the current graph for TextureReleaseDelayFrames frames, e.g. render targets of
+    /// the old size after resize. Called once per frame. The delay is longer than frames in flight, so GPU is done with them.
+    ///
+    void ReleaseUnusedTextures();
 
     Texture* GetResource(const std::string& name);
 
 private:
+    static constexpr uint32 InvalidPoolIndex = (std::numeric_limits<uint32>::max)();
+    static constexpr uint64 TextureReleaseDelayFrames = 8;
+
     std::vector<PassBlackboard> m_blackboardsPool;
     uint32 m_currIndex = 0;
 
-    std::map<std::string, Texture*> m_resources;
+    std::map<std::string, Texture*> m_resources; // Transient resources of the current graph, aliased resources share textures.
+    std::vector<Texture*> m_texturePool; // Owns all textures created by the graph.
+    std::vector<bool> m_isPoolTextureUsed; // By the current graph.
+    std::vector<uint64> m_poolTextureLastUseFrames;
+    uint64 m_frameIndex = 0;
+    std::vector<uint32> m_physicalPoolIndices; // Pool texture of every physical resource.
+    ResourceStates m_physicalStates;
 };
 
 inline Texture* ResourceTable::GetResource(const std::string& name)
 {
     assert(m_resources.count(name) && "Resource wasn't added");
-    return m_resources[name];
+    return m_resources.at(name);
+}
+
+inline ResourceStates& ResourceTable::GetPhysicalStates()
+{
+    return m_physicalStates;
 }
 
 }
@@ -2,6 +2,7 @@
 
 #include "Render/RenderGraph/ResourcesBlackboard.h"
 
+#include "Core/CoreHelpers.h"
 #include "Render/Renderer.h"
 
 namespace Kioto::Renderer
@@ -29,18 +30,45 @@ void ResourcesBlackboard::ScheduleRead(std::string name)
 
 void ResourcesBlackboard::ScheduleWrite(std::string name)
 {
-    m_transitionRequests.push_back({ name, eResourceState::RenderTarget });
+    m_transitionRequests.push_back({ name, eResourceState::RenderTarget, true });
 }
 
 void ResourcesBlackboard::ScheduleUnorderedAccess(std::string name)
 {
-    m_transitionRequests.push_back({ name, eResourceState::UnorderedAccess });
+    m_transitionRequests.push_back({ name, eResourceState::UnorderedAccess, true });
+}
+
+void ResourcesBlackboard::ScheduleWriteBackBuffer()
+{
+    m_writesBackBuffer = true;
+}
+
+uint64 ResourcesBlackboard::GetHash() const
+{
+    uint64 hash = m_writesBackBuffer ? 1 : 0;
+    for (const auto& request : m_creationRequests)
+    {
+        const TextureDescriptor& desc = request.Desc;
+        hash = HashCombine(hash, StringToHash(request.ResourceName));
+        hash = HashCombine(hash, static_cast<uint64>(desc.Flags));
+        hash = HashCombine(hash, static_cast<uint64>(desc.Format));
+        hash = HashCombine(hash, static_cast<uint64>(desc.Dimension));
+        hash = HashCombine(hash, static_cast<uint64>(desc.InitialState));
+        hash = HashCombine(hash, (static_cast<uint64>(desc.Width) << 32) | desc.Height);
+    }
+    for (const auto& request : m_transitionRequests)
+    {
+        hash = HashCombine(hash, StringToHash(request.ResourceName));
+        hash = HashCombine(hash, (static_cast<uint64>(request.TransitionTo) << 1) | (request.IsWrite ? 1 : 0));
+    }
+    return hash;
 }
 
 void ResourcesBlackboard::Clear()
 {
     m_creationRequests.clear();
     m_transitionRequests.clear();
+    m_writesBackBuffer = false;
 }
 
 }
\ No newline at end of file
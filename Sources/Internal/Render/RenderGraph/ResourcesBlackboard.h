@@ -17,6 +17,7 @@ struct ResourceTransitionRequest
 {
     std::string ResourceName;
     eResourceState TransitionTo;
+    bool IsWrite = false;
 };
 
 class ResourcesBlackboard
@@ -30,6 +31,15 @@ public:
     void ScheduleRead(std::string name);
     void ScheduleWrite(std::string name);
     void ScheduleUnorderedAccess(std::string name);
+    ///
+    /// Mark pass as writing to the back buffer. Only such passes and passes they depend on are executed.
+    ///
+    void ScheduleWriteBackBuffer();
+    bool GetWritesBackBuffer() const;
+    ///
+    /// Get hash of all declarations. Equal hashes mean equal graph structure, so compiled graph can be reused.
+    ///
+    uint64 GetHash() const;
     const std::vector<ResourceTransitionRequest>& GetTransitionRequests() const;
     const std::vector<ResourceCreationRequest>& GetCreationRequest() const;
     void Clear();
@@ -37,6 +47,7 @@ public:
 private:
     std::vector<ResourceCreationRequest> m_creationRequests;
     std::vector<ResourceTransitionRequest> m_transitionRequests;
+    bool m_writesBackBuffer = false;
 };
 
 inline const std::vector<ResourceTransitionRequest>& ResourcesBlackboard::GetTransitionRequests() const
@@ -48,4 +59,9 @@ inline const std::vector<ResourceCreationRequest>& ResourcesBlackboard::GetCreat
 {
     return m_creationRequests;
 }
+
+inline bool ResourcesBlackboard::GetWritesBackBuffer() const
+{
+    return m_writesBackBuffer;
+}
 }
\ No newline at end of file
@@ -26,6 +26,11 @@ namespace Kioto::Renderer
             assert(m_renderObjectBuffers.count(pipelines.first) == 0);
             m_renderObjectBuffers[pipelines.first] = std::move(bufferLayout);
             m_renderObjectConstants[pipelines.first] = std::move(shader->GetRenderObjectConstants());
+
+            PassBindings& bindings = GetOrAddPassBindings(StringTable::Intern(pipelines.first));
+            bindings.State = &pipelines.second;
+            bindings.Buffers = &m_renderObjectBuffers[pipelines.first];
+            bindings.Constants = &m_renderObjectConstants[pipelines.first];
         }
     }
 
@@ -49,6 +54,7 @@ namespace Kioto::Renderer
             }
             assert(m_textureSets.count(passName) == 0);
             m_textureSets[passName] = std::move(set);
+            GetOrAddPassBindings(StringTable::Intern(passName)).Textures = &m_textureSets[passName];
             if (m_textureSets[passName].GetTexturesCount() > 0)
             {
                 // [a_vorontcov] TODO: easy to mess up. rethink
@@ -61,26 +67,45 @@ namespace Kioto::Renderer
     void RenderObject::SetTexture(const std::string& name, Texture* texture, const std::string& passName)
     {
         assert(m_textureSets.count(passName) && "Texture is missing in texture set");
-        m_textureSets[passName].SetTexture(name, texture);
+        m_textureSets.at(passName).SetTexture(name, texture);
     }
 
-    void RenderObject::PrepareConstantBuffers(const std::string& passName)
+    void RenderObject::PrepareConstantBuffers(StringId passNameId)
     {
+        static const StringId cbRenderObjectId = StringTable::Intern("cbRenderObject");
+
+        PassBindings* bindings = FindPassBindings(passNameId);
+        assert(bindings != nullptr);
+        if (m_transformVersion != 0 && bindings->TransformVersion == m_transformVersion)
+            return;
+        bindings->TransformVersion = m_transformVersion;
+
         SInp::Fallback_sinp::CbRenderObject roBuffer;
         roBuffer.ToModel = GetToModel()->GetForGPU();
         roBuffer.ToWorld = GetToWorld()->GetForGPU();
-        SetBuffer("cbRenderObject", roBuffer, passName);
+        SetBuffer(cbRenderObjectId, roBuffer, passNameId);
+    }
+
+    void RenderObject::PrepareConstantBuffers(const std::string& passName)
+    {
+        PrepareConstantBuffers(StringTable::Intern(passName));
     }
 
     void RenderObject::SetExternalCB(const std::string& passName, const std::string& cbName, ConstantBufferHandle newHandle)
     {
-        if (!m_renderObjectBuffers.count(passName))
+        SetExternalCB(StringTable::Intern(passName), StringTable::Intern(cbName), newHandle);
+    }
+
+    void RenderObject::SetExternalCB(StringId passNameId, StringId cbNameId, ConstantBufferHandle newHandle)
+    {
+        PassBindings* bindings = FindPassBindings(passNameId);
+        if (bindings == nullptr)
         {
             assert(false);
             return;
         }
-        RenderObjectBufferLayout& layout = m_renderObjectBuffers[passName];
-        auto& cb = std::find_if(layout.begin(), layout.end(), [&cbName](const ConstantBuffer& b) { return b.GetName() == cbName; });
+        RenderObjectBufferLayout& layout = *bindings->Buffers;
+        auto cb = std::find_if(layout.begin(), layout.end(), [cbNameId](const ConstantBuffer& b) { return b.GetNameId() == cbNameId; });
         if (cb == layout.end())
         {
             assert(false);
@@ -90,30 +115,52 @@ namespace Kioto::Renderer
         cb->SetHandle(newHandle);
     }
 
-    std::vector<Renderer::ConstantBufferHandle> RenderObject::GetCBHandles(const std::string& passName) const
+    FrameVector<Renderer::ConstantBufferHandle> RenderObject::GetCBHandles(const std::string& passName) const
     {
-        if (!m_renderObjectBuffers.count(passName))
+        return GetCBHandles(StringTable::Intern(passName));
+    }
+
+    FrameVector<Renderer::ConstantBufferHandle> RenderObject::GetCBHandles(StringId passNameId) const
+    {
+        const PassBindings* bindings = FindPassBindings(passNameId);
+        if (bindings == nullptr || bindings->Buffers == nullptr)
             return {};
-        const RenderObjectBufferLayout& layout = m_renderObjectBuffers.at(passName);
+        const RenderObjectBufferLayout& layout = *bindings->Buffers;
 
-        std::vector<Renderer::ConstantBufferHandle> handles;
+        FrameVector<Renderer::ConstantBufferHandle> handles;
         handles.reserve(layout.size());
         for (const auto& cb : layout)
             handles.push_back(cb.GetHandle());
         return handles;
     }
 
-    std::vector<uint32> RenderObject::GetConstants(const std::string& passName) const
+    FrameVector<uint32> RenderObject::GetConstants(const std::string& passName) const
+    {
+        return GetConstants(StringTable::Intern(passName));
+    }
+
+    FrameVector<uint32> RenderObject::GetConstants(StringId passNameId) const
     {
-        if (!m_renderObjectConstants.count(passName))
+        const PassBindings* bindings = FindPassBindings(passNameId);
+        if (bindings == nullptr || bindings->Constants == nullptr)
             return {};
-        const RenderObjectConstants& constants = m_renderObjectConstants.at(passName);
+        const RenderObjectConstants& constants = *bindings->Constants;
 
-        std::vector<uint32> values;
+        FrameVector<uint32> values;
         values.reserve(constants.size());
         for (const auto& c : constants)
             values.push_back(c.GetValue());
         return values;
     }
 
+    RenderObject::PassBindings& RenderObject::GetOrAddPassBindings(StringId passNameId)
+    {
+        PassBindings* bindings = FindPassBindings(passNameId);
+        if (bindings != nullptr)
+            return *bindings;
+        m_passBindings.push_back({});
+        m_passBindings.back().PassNameId = passNameId;
+        return m_passBindings.back();
+    }
+
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Core/DataStructures/StringTable.h"
+#include "Core/Memory/FrameAllocator.h"
 #include "Render/ShaderData.h"
 
 namespace Kioto::Renderer
@@ -18,7 +20,8 @@ public:
     /// <summary>
     ///  Internally sets all constant buffers for rendering
     /// </summary>
-    virtual void PrepareConstantBuffers(const std::string& passName);
+    virtual void PrepareConstantBuffers(StringId passNameId);
+    void PrepareConstantBuffers(const std::string& passName);
 
     void SetMaterial(Material* material, bool composeBuffersAndTextures = true);
     Material* GetMaterial() const;
@@ -32,6 +35,11 @@ public:
     void SetToModel(const Matrix4& mat);
     const Matrix4* GetToModel() const;
 
+    /// <summary>
+    /// Version of ToWorld/ToModel source, per object buffers are rebuilt only when it changes. 0 - not versioned, rebuilt every time.
+    /// </summary>
+    void SetTransformVersion(uint32 version);
+
     void ComposeAllConstantBuffers();
     void RegisterAllTextureSets();
 
@@ -39,15 +47,26 @@ public:
     /// Hijacks cb handle in the render object. This is necessary when you need to set cb as a common cb (time, light), or just set per pass buffer (camera)
     /// </summary>
     void SetExternalCB(const std::string& passName, const std::string& cbName, ConstantBufferHandle newHandle); // [a_vorontcov] TODO: really fishy. rethink
+    /// <summary>
+    /// Overloads taking ids of interned pass and buffer names don't hash or compare strings, use them for per draw setup.
+    /// Passes intern their names once with StringTable::Intern.
+    /// </summary>
+    void SetExternalCB(StringId passNameId, StringId cbNameId, ConstantBufferHandle newHandle);
 
     template <typename T>
     void SetConstant(const std::string& passName, const std::string& cName, T constant);
+    template <typename T>
+    void SetConstant(StringId passNameId, StringId cNameId, T constant);
 
-    std::vector<ConstantBufferHandle> GetCBHandles(const std::string& passName) const;
-    std::vector<uint32> GetConstants(const std::string& passName) const;
+    FrameVector<ConstantBufferHandle> GetCBHandles(const std::string& passName) const;
+    FrameVector<ConstantBufferHandle> GetCBHandles(StringId passNameId) const;
+    FrameVector<uint32> GetConstants(const std::string& passName) const;
+    FrameVector<uint32> GetConstants(StringId passNameId) const;
 
     const RenderObjectBufferLayout& GetBufferLayout(const PassName& passName);
     const TextureSet& GetTextureSet(const PassName& passName);
+    const TextureSet& GetTextureSet(StringId passNameId) const;
+    const PipelineState& GetPipelineState(StringId passNameId) const; // Pipeline state of the material for the pass.
     const std::unordered_map<PassName, RenderObjectBufferLayout>& GetBuffersLayouts() const;
     std::unordered_map<PassName, RenderObjectBufferLayout>& GetBuffersLayouts();
     void SetTexture(const std::string& name, Texture* texture, const std::string& passName);
@@ -55,10 +74,17 @@ public:
     template<typename T>
     bool SetBuffer(const std::string& name, T&& val, const PassName& passName, uint32 elemOffset = 0)
     {
-        assert(m_renderObjectBuffers.count(passName) == 1);
-        for (auto& cb : m_renderObjectBuffers[passName])
+        return SetBuffer(StringTable::Intern(name), std::forward<T>(val), StringTable::Intern(passName), elemOffset);
+    }
+
+    template<typename T>
+    bool SetBuffer(StringId nameId, T&& val, StringId passNameId, uint32 elemOffset = 0)
+    {
+        PassBindings* bindings = FindPassBindings(passNameId);
+        assert(bindings != nullptr);
+        for (auto& cb : *bindings->Buffers)
         {
-            if (cb.GetName() == name)
+            if (cb.GetNameId() == nameId)
             {
                 cb.Set(val, elemOffset);
                 return true;
@@ -68,14 +94,33 @@ public:
     }
 
 private:
+    ///
+    /// Data of the object for one pass, found by id of the pass name. Points to the values of the maps below.
+    ///
+    struct PassBindings
+    {
+        StringId PassNameId = InvalidStringId;
+        const PipelineState* State = nullptr;
+        RenderObjectBufferLayout* Buffers = nullptr;
+        RenderObjectConstants* Constants = nullptr;
+        TextureSet* Textures = nullptr;
+        uint32 TransformVersion = 0; // Transform version written to the per object buffer of the pass.
+    };
+
+    PassBindings* FindPassBindings(StringId passNameId);
+    const PassBindings* FindPassBindings(StringId passNameId) const;
+    PassBindings& GetOrAddPassBindings(StringId passNameId);
+
     Material* m_material = nullptr;
     Mesh* m_mesh = nullptr;
     std::unordered_map<PassName, RenderObjectBufferLayout> m_renderObjectBuffers;
     std::unordered_map<PassName, RenderObjectConstants> m_renderObjectConstants;
     std::unordered_map<PassName, TextureSet> m_textureSets; // [a_vorontcov] Buffers are unique for ro, but texture set is more a material thing. but does it matter for bindless textures and for this engine at all?
+    std::vector<PassBindings> m_passBindings; // Object has data for a few passes only, so linear search by id is cheaper than hashing the name.
 
     const Matrix4* m_toWorld = nullptr;
     const Matrix4* m_toModel = nullptr;
+    uint32 m_transformVersion = 0;
 };
 
 inline void RenderObject::SetMaterial(Material* material, bool composeBuffersAndTextures /* = true */)
@@ -123,6 +168,11 @@ inline const Matrix4* RenderObject::GetToModel() const
     return m_toModel;
 }
 
+inline void RenderObject::SetTransformVersion(uint32 version)
+{
+    m_transformVersion = version;
+}
+
 inline const RenderObjectBufferLayout& RenderObject::GetBufferLayout(const PassName& passName)
 {
     assert(m_renderObjectBuffers.count(passName) == 1);
@@ -135,6 +185,40 @@ inline const TextureSet& RenderObject::GetTextureSet(const PassName& passName)
     return m_textureSets.at(passName);
 }
 
+inline const TextureSet& RenderObject::GetTextureSet(StringId passNameId) const
+{
+    const PassBindings* bindings = FindPassBindings(passNameId);
+    assert(bindings != nullptr && bindings->Textures != nullptr);
+    return *bindings->Textures;
+}
+
+inline const PipelineState& RenderObject::GetPipelineState(StringId passNameId) const
+{
+    const PassBindings* bindings = FindPassBindings(passNameId);
+    assert(bindings != nullptr && bindings->State != nullptr);
+    return *bindings->State;
+}
+
+inline RenderObject::PassBindings* RenderObject::FindPassBindings(StringId passNameId)
+{
+    for (PassBindings& bindings : m_passBindings)
+    {
+        if (bindings.PassNameId == passNameId)
+            return &bindings;
+    }
+    return nullptr;
+}
+
+inline const RenderObject::PassBindings* RenderObject::FindPassBindings(StringId passNameId) const
+{
+    for (const PassBindings& bindings : m_passBindings)
+    {
+        if (bindings.PassNameId == passNameId)
+            return &bindings;
+    }
+    return nullptr;
+}
+
 inline const std::unordered_map<PassName, RenderObjectBufferLayout>& RenderObject::GetBuffersLayouts() const
 {
     return m_renderObjectBuffers;
@@ -149,13 +233,20 @@ inline std::unordered_map<PassName, RenderObjectBufferLayout>& RenderObject::Get
 template <typename T>
 inline void RenderObject::SetConstant(const std::string& passName, const std::string& cName, T constant)
 {
-    if (!m_renderObjectConstants.count(passName))
+    SetConstant(StringTable::Intern(passName), StringTable::Intern(cName), constant);
+}
+
+template <typename T>
+inline void RenderObject::SetConstant(StringId passNameId, StringId cNameId, T constant)
+{
+    PassBindings* bindings = FindPassBindings(passNameId);
+    if (bindings == nullptr)
     {
         assert(false);
         return;
     }
-    RenderObjectConstants& constants = m_renderObjectConstants[passName];
-    auto& c = std::find_if(constants.begin(), constants.end(), [&cName](const UniformConstant& c) { return c.GetName() == cName; });
+    RenderObjectConstants& constants = *bindings->Constants;
+    auto c = std::find_if(constants.begin(), constants.end(), [cNameId](const UniformConstant& c) { return c.GetNameId() == cNameId; });
     if (c == constants.end())
     {
         assert(false);
@@ -15,8 +15,13 @@ namespace Kioto
 
         RenderModeOptions RenderMode = RenderModeOptions::Final;
         Vector2i Resolution{ 1900, 1000 };
+        bool FrustumCulling = true; // Draw only objects whose bounds intersect main camera frustum.
+        bool Instancing = true; // Draw objects sharing mesh, material and textures with one instanced draw.
 
         static constexpr uint32 MaxRenderPassesCount = 128;
         static constexpr uint32 MaxRenderCommandsCount = 2048;
+        static constexpr uint32 ConstantUploadRingSize = 32 * 1024 * 1024; // Bytes of constant data of all frames in flight.
+        static constexpr uint32 ResidentConstantsSize = 16 * 1024 * 1024; // Bytes of persistent copies of per object constant buffers.
+        static constexpr uint32 PipelineCompileThreadsCount = 2; // Threads compiling pipeline states missing in the cache, 0 compiles them when material is built.
     };
 }
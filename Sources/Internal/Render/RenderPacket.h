@@ -1,8 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
+#include "Core/Memory/FrameAllocator.h"
+#include "Math/Matrix4.h"
 #include "Render/RendererPublic.h"
+#include "Render/RenderLayer.h"
 
 namespace Kioto::Renderer
 {
@@ -15,9 +19,58 @@ public:
     VertexLayoutHandle VertexLayout;
     TextureSetHandle TextureSet;
     MeshHandle Mesh;
-    std::vector<ConstantBufferHandle> ConstantBufferHandles;
-    std::vector<uint32> UniformConstants;
+    uint64 SortKey = 0;
+    uint32 InstanceCount = 1;
+    FrameVector<ConstantBufferHandle> ConstantBufferHandles;
+    FrameVector<uint32> UniformConstants;
 };
 
 using RenderPacketList = std::vector<RenderPacket>;
+
+///
+/// 64 bit key ordering packets of a pass so that packets sharing state go one after another.
+/// Opaque:      layer 2 | pass 6 | shader 10 | material 14 | texture set 12 | mesh 12 | depth 8 (front to back).
+/// Transparent: layer 2 | pass 6 | inverted depth 24 (back to front) | shader 8 | material 12 | texture set 12.
+/// Handles are truncated to their low bits, packets with colliding handles are just grouped worse.
+///
+namespace SortKey
+{
+uint64 Build(eRenderLayerType layer, RenderPassHandle pass, ShaderHandle shader, MaterialHandle material, TextureSetHandle textureSet, MeshHandle mesh, float32 depth);
+///
+/// Depth of the object origin in camera space divided by far plane, clamped to [0, 1].
+///
+float32 GetNormalizedDepth(const Matrix4& toWorld, const Matrix4& view, float32 farPlane);
+
+namespace Internal
+{
+inline uint64 Bits(uint32 value, uint32 bitsCount, uint32 shift)
+{
+    return (static_cast<uint64>(value) & ((1ull << bitsCount) - 1)) << shift;
+}
+
+inline uint32 QuantizeDepth(float32 depth, uint32 bitsCount)
+{
+    return static_cast<uint32>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float32>((1u << bitsCount) - 1));
+}
+}
+
+inline uint64 Build(eRenderLayerType layer, RenderPassHandle pass, ShaderHandle shader, MaterialHandle material, TextureSetHandle textureSet, MeshHandle mesh, float32 depth)
+{
+    using namespace Internal;
+    uint64 key = Bits(static_cast<uint32>(layer), 2, 62) | Bits(pass.GetHandle(), 6, 56);
+    if (layer == eRenderLayerType::Transparent)
+    {
+        uint32 invertedDepth = ((1u << 24) - 1) - QuantizeDepth(depth, 24);
+        return key | Bits(invertedDepth, 24, 32) | Bits(shader.GetHandle(), 8, 24) | Bits(material.GetHandle(), 12, 12) | Bits(textureSet.GetHandle(), 12, 0);
+    }
+    return key | Bits(shader.GetHandle(), 10, 46) | Bits(material.GetHandle(), 14, 32) | Bits(textureSet.GetHandle(), 12, 20)
+        | Bits(mesh.GetHandle(), 12, 8) | Bits(QuantizeDepth(depth, 8), 8, 0);
+}
+
+inline float32 GetNormalizedDepth(const Matrix4& toWorld, const Matrix4& view, float32 farPlane)
+{
+    Vector4 viewPos = Vector4(toWorld.GetTranslation(), 1.0f) * view;
+    return viewPos.z / farPlane;
+}
+}
 }
\ No newline at end of file
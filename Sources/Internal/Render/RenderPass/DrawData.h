@@ -1,15 +1,18 @@
 #pragma once
 
-#include <vector>
+#include "Core/Memory/FrameAllocator.h"
 
 namespace Kioto::Renderer
 {
 class RenderObject;
 struct Light;
 
+///
+/// Objects visible in the current frame. Lives in frame memory, so it is rebuilt every frame.
+///
 struct DrawData
 {
-    std::vector<RenderObject*> RenderObjects;
-    std::vector<Light*> Lights;
+    FrameVector<RenderObject*> RenderObjects;
+    FrameVector<Light*> Lights;
 };
 }
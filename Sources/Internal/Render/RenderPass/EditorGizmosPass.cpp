@@ -48,11 +48,12 @@ void EditorGizmosPass::SetRenderTargets(CommandList* commandList, ResourceTable&
     cmd.ClearStencil = false;
     cmd.ClearStencilValue = 0;
 
-    commandList->PushCommand(RenderCommandHelpers::CreateSetRenderTargetCommand(cmd, this));
+    RenderCommandHelpers::PushSetRenderTargetCommand(commandList, cmd, this);
 }
 
 bool EditorGizmosPass::ConfigureInputsAndOutputs(ResourcesBlackboard& resources)
 {
+    resources.ScheduleWriteBackBuffer();
     return true;
 }
 
@@ -102,12 +103,12 @@ void EditorGizmosPass::BuildRenderPackets(CommandList* commandList, ResourceTabl
         currPacket.ConstantBufferHandles = std::move(ro->GetCBHandles(m_passName));
         currPacket.Pass = GetHandle();
 
-        commandList->PushCommand(RenderCommandHelpers::CreateRenderPacketCommand(currPacket, this));
+        RenderCommandHelpers::PushRenderPacketCommand(commandList, currPacket, this);
     }
-    commandList->PushCommand(RenderCommandHelpers::CreatePassEndsCommand(this));
+    RenderCommandHelpers::PushPassEndsCommand(commandList, this);
 }
 
-void EditorGizmosPass::CreateNecessaryRenderObjects(const std::vector<Light*>& lights)
+void EditorGizmosPass::CreateNecessaryRenderObjects(const FrameVector<Light*>& lights)
 {
     int32 diff = int32(lights.size()) - int32(m_renderObjects.size());
     if (diff <= 0)
@@ -18,7 +18,7 @@ public:
 private:
     void SetRenderTargets(CommandList* commandList, ResourceTable& resources) override;
 
-    void CreateNecessaryRenderObjects(const std::vector<Light*>& lights);
+    void CreateNecessaryRenderObjects(const FrameVector<Light*>& lights);
 
     void CreateMaterial();
     void CreateQuadMesh();
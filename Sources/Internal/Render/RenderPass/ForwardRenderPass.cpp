@@ -2,8 +2,11 @@
 
 #include "Render/RenderPass/ForwardRenderPass.h"
 
+#include "Core/DataStructures/RadixSort.h"
 #include "Core/KiotoEngine.h"
+#include "Core/Memory/FrameAllocator.h"
 #include "Render/Camera.h"
+#include "Render/Geometry/Mesh.h"
 #include "Render/Material.h"
 #include "Render/Renderer.h"
 #include "Render/RenderCommand.h"
@@ -23,9 +26,17 @@ ForwardRenderPass::ForwardRenderPass()
     : RenderPass("Forward")
 {
     assert(sizeof(Light) == sizeof(SInp::Light));
+    assert(sizeof(InstanceData) == sizeof(SInp::InstanceData));
+    assert(sizeof(InstanceData) * MaxInstancesPerDraw == sizeof(SInp::InstanceBuffer));
     Renderer::RegisterRenderPass(this);
     Renderer::RegisterConstantBuffer(m_lightsBuffer);
 
+    m_cbCameraId = StringTable::Intern(Renderer::SInp::Fallback_sinp::cbCameraName);
+    m_cbEngineId = StringTable::Intern(Renderer::SInp::Fallback_sinp::cbEngineName);
+    m_lightsId = StringTable::Intern(Renderer::SInp::Fallback_sinp::lightsName);
+    m_cbInstancesId = StringTable::Intern(Renderer::SInp::Fallback_sinp::cbInstancesName);
+    m_lightsCountId = StringTable::Intern("LIGHTS_COUNT");
+
     SetRenderTargetCount(1);
 }
 
@@ -38,31 +49,167 @@ void ForwardRenderPass::BuildRenderPackets(CommandList* commandList, ResourceTab
     m_lightsBuffer.Set(m_lights);
 
 
-    for (auto ro : m_drawData->RenderObjects)
+    uint32 objectsCount = static_cast<uint32>(m_drawData->RenderObjects.size());
+    uint32* order = FrameAllocator::NewArray<uint32>(objectsCount);
+    Batch* batches = FrameAllocator::NewArray<Batch>(objectsCount);
+    uint32 batchesCount = BuildBatches(order, batches);
+
+    uint32 lightsCount = static_cast<uint32>(m_drawData->Lights.size());
+    Matrix4 view = Renderer::GetMainCamera()->GetView();
+    float32 farPlane = Renderer::GetMainCamera()->GetFarPlane();
+    RecordSorted(commandList, batchesCount, [this, order, batches, lightsCount, &view, farPlane](CommandList* chunkList, uint32 index)
     {
-        ro->SetExternalCB(m_passName, Renderer::SInp::Fallback_sinp::cbCameraName, Renderer::GetMainCamera()->GetConstantBuffer().GetHandle());
-        ro->SetExternalCB(m_passName, Renderer::SInp::Fallback_sinp::cbEngineName, Renderer::EngineBuffers::GetTimeBuffer().GetHandle());
-        ro->SetExternalCB(m_passName, Renderer::SInp::Fallback_sinp::lightsName, m_lightsBuffer.GetHandle());
-        ro->SetConstant(m_passName, "LIGHTS_COUNT", static_cast<uint32>(m_drawData->Lights.size()));
+        const Batch& batch = batches[index];
+        RenderObject* ro = m_drawData->RenderObjects[order[batch.First]];
+        ro->SetExternalCB(m_passNameId, m_cbCameraId, Renderer::GetMainCamera()->GetConstantBuffer().GetHandle());
+        ro->SetExternalCB(m_passNameId, m_cbEngineId, Renderer::EngineBuffers::GetTimeBuffer().GetHandle());
+        ro->SetExternalCB(m_passNameId, m_lightsId, m_lightsBuffer.GetHandle());
+        ro->SetConstant(m_passNameId, m_lightsCountId, lightsCount);
         Material* mat = ro->GetMaterial();
         Mesh* mesh = ro->GetMesh();
-        mat->BuildMaterialForPass(this);
 
-        ro->PrepareConstantBuffers(m_passName);
+        if (batch.Instances != nullptr)
+        {
+            // The whole batch is drawn with the buffers of its first object, per object data goes to the instance buffer.
+            UpdateInstanceBuffer(order, batch);
+            ro->SetExternalCB(m_passNameId, m_cbInstancesId, batch.Instances->Buffer->GetHandle());
+        }
+        else
+        {
+            ro->PrepareConstantBuffers(m_passNameId);
+        }
 
+        const PipelineState& state = ro->GetPipelineState(m_passNameId);
         RenderPacket currPacket = {};
         currPacket.Material = mat->GetHandle();
-        currPacket.Shader = mat->GetPipelineState(m_passName).Shader->GetHandle();
-        currPacket.TextureSet = ro->GetTextureSet(m_passName).GetHandle();
+        currPacket.Shader = state.Shader->GetHandle();
+        currPacket.TextureSet = ro->GetTextureSet(m_passNameId).GetHandle();
         currPacket.Mesh = mesh->GetHandle();
         currPacket.Pass = GetHandle();
-        currPacket.ConstantBufferHandles = std::move(ro->GetCBHandles(m_passName));
-        currPacket.UniformConstants = std::move(ro->GetConstants(m_passName));
+        currPacket.SortKey = SortKey::Build(state.LayerType, currPacket.Pass, currPacket.Shader, currPacket.Material, currPacket.TextureSet, currPacket.Mesh,
+            SortKey::GetNormalizedDepth(*ro->GetToWorld(), view, farPlane));
+        currPacket.InstanceCount = batch.Count;
+        currPacket.ConstantBufferHandles = std::move(ro->GetCBHandles(m_passNameId));
+        currPacket.UniformConstants = std::move(ro->GetConstants(m_passNameId));
+
+        RenderCommandHelpers::PushRenderPacketCommand(chunkList, currPacket, this);
+    });
+
+    RenderCommandHelpers::PushPassEndsCommand(commandList, this);
+}
+
+uint32 ForwardRenderPass::BuildBatches(uint32* order, Batch* batches)
+{
+    struct BatchItem
+    {
+        uint64 Key;
+        uint32 Index;
+        bool UsesInstances; // Shader reads per object data from the instance buffer.
+        bool IsInstanceable; // Can share the draw with other objects, transparent objects are drawn back to front one by one.
+    };
+
+    uint32 objectsCount = static_cast<uint32>(m_drawData->RenderObjects.size());
+    uint32 maxInstancesCount = KiotoCore::GetRenderSettings().Instancing ? MaxInstancesPerDraw : 1;
+    BatchItem* items = FrameAllocator::NewArray<BatchItem>(objectsCount * 2);
+    const Shader* lastShader = nullptr;
+    bool lastShaderUsesInstances = false;
+    for (uint32 i = 0; i < objectsCount; ++i)
+    {
+        RenderObject* ro = m_drawData->RenderObjects[i];
+        Material* mat = ro->GetMaterial();
+        mat->BuildMaterialForPass(this);
+        const PipelineState& state = ro->GetPipelineState(m_passNameId);
+        if (state.Shader != lastShader)
+        {
+            const RenderObjectBufferLayout& layout = state.Shader->GetBufferLayoutTemplate();
+            lastShader = state.Shader;
+            lastShaderUsesInstances = std::any_of(layout.cbegin(), layout.cend(),
+                [this](const ConstantBuffer& cb) { return cb.GetNameId() == m_cbInstancesId; });
+        }
 
-        commandList->PushCommand(RenderCommandHelpers::CreateRenderPacketCommand(currPacket, this));
+        BatchItem& item = items[i];
+        item.Key = SortKey::Build(eRenderLayerType::Opaque, GetHandle(), state.Shader->GetHandle(), mat->GetHandle(), ro->GetTextureSet(m_passNameId).GetHandle(),
+            ro->GetMesh()->GetHandle(), 0.0f);
+        item.Index = i;
+        item.UsesInstances = lastShaderUsesInstances;
+        item.IsInstanceable = lastShaderUsesInstances && state.LayerType == eRenderLayerType::Opaque;
     }
+    RadixSort(items, items + objectsCount, objectsCount, [](const BatchItem& item) { return item.Key; });
+
+    // Keys hold truncated handles, so the batch is split on any real difference of the state.
+    auto isSameDraw = [this](RenderObject* l, RenderObject* r)
+    {
+        return l->GetMaterial() == r->GetMaterial() && l->GetMesh() == r->GetMesh()
+            && l->GetTextureSet(m_passNameId).GetHandle() == r->GetTextureSet(m_passNameId).GetHandle();
+    };
 
-    commandList->PushCommand(RenderCommandHelpers::CreatePassEndsCommand(this));
+    uint32 batchesCount = 0;
+    for (uint32 i = 0; i < objectsCount; ++i)
+    {
+        order[i] = items[i].Index;
+        if (batchesCount > 0)
+        {
+            Batch& batch = batches[batchesCount - 1];
+            const BatchItem& first = items[batch.First];
+            if (items[i].IsInstanceable && first.IsInstanceable && batch.Count < maxInstancesCount && items[i].Key == first.Key
+                && isSameDraw(m_drawData->RenderObjects[first.Index], m_drawData->RenderObjects[items[i].Index]))
+            {
+                ++batch.Count;
+                continue;
+            }
+        }
+        batches[batchesCount++] = { i, 1, nullptr };
+    }
+
+    // Buffers are registered here, recording is parallel.
+    std::array<uint32, InstanceBufferSizesCount> usedBuffersCount = {};
+    for (uint32 i = 0; i < batchesCount; ++i)
+    {
+        if (!items[batches[i].First].UsesInstances)
+            continue;
+        uint32 sizeLog2 = 0;
+        while ((1u << sizeLog2) < batches[i].Count)
+            ++sizeLog2;
+        batches[i].Instances = GetInstanceBuffer(sizeLog2, usedBuffersCount[sizeLog2]++);
+    }
+    return batchesCount;
+}
+
+ForwardRenderPass::InstanceBuffer* ForwardRenderPass::GetInstanceBuffer(uint32 sizeLog2, uint32 index)
+{
+    std::vector<std::unique_ptr<InstanceBuffer>>& buffers = m_instanceBuffers[sizeLog2];
+    while (buffers.size() <= index)
+    {
+        uint16 size = static_cast<uint16>(sizeof(InstanceData) << sizeLog2);
+        auto instances = std::make_unique<InstanceBuffer>();
+        instances->Buffer = std::make_unique<ConstantBuffer>(Renderer::SInp::Fallback_sinp::cbInstancesName, 3, 1, size, 1, true);
+        instances->ToWorld.resize(1ull << sizeLog2); // Zero matrices match no world matrix, so every instance is written first time.
+        Renderer::RegisterConstantBuffer(*instances->Buffer);
+        buffers.push_back(std::move(instances));
+    }
+    return buffers[index].get();
+}
+
+void ForwardRenderPass::UpdateInstanceBuffer(const uint32* order, const Batch& batch)
+{
+    InstanceBuffer& instances = *batch.Instances;
+    InstanceData* data = instances.Buffer->GetBufferData<InstanceData>();
+    bool isChanged = false;
+    for (uint32 i = 0; i < batch.Count; ++i)
+    {
+        const RenderObject* instance = m_drawData->RenderObjects[order[batch.First + i]];
+        const Matrix4& toWorld = *instance->GetToWorld();
+        if (memcmp(&instances.ToWorld[i], &toWorld, sizeof(Matrix4)) == 0)
+            continue;
+
+        // To model matrix is derived from to world one, so it is equal too when to world didn't change.
+        instances.ToWorld[i] = toWorld;
+        data[i].ToWorld = toWorld.GetForGPU();
+        data[i].ToModel = instance->GetToModel()->GetForGPU();
+        isChanged = true;
+    }
+    if (isChanged)
+        instances.Buffer->ScheduleToUpdate();
 }
 
 void ForwardRenderPass::Cleanup()
@@ -87,7 +234,7 @@ void ForwardRenderPass::SetRenderTargets(CommandList* commandList, ResourceTable
     cmd.ClearStencil = true;
     cmd.ClearStencilValue = 0;
 
-    commandList->PushCommand(RenderCommandHelpers::CreateSetRenderTargetCommand(cmd, this));
+    RenderCommandHelpers::PushSetRenderTargetCommand(commandList, cmd, this);
 }
 
 bool ForwardRenderPass::ConfigureInputsAndOutputs(ResourcesBlackboard& resources)
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "AssetsSystem/AssetsSystem.h"
 #include "Render/RenderPass/RenderPass.h"
 #include "Render/Lighting/Light.h"
@@ -10,6 +14,9 @@ namespace Kioto::Renderer
 class ForwardRenderPass : public RenderPass
 {
 public:
+    static constexpr uint32 MaxInstancesPerDraw = 256; // Size of instances array in cbInstances, Instancing.kincl.
+    static constexpr uint32 InstanceBufferSizesCount = 9; // Instance buffers of 1, 2, 4 ... MaxInstancesPerDraw instances.
+
     ForwardRenderPass();
 
     bool ConfigureInputsAndOutputs(ResourcesBlackboard& resources) override;
@@ -17,7 +24,41 @@ public:
     void Cleanup() override;
 
 private:
+    ///
+    /// Instance buffer with copies of the source matrices of its instances. Objects of static batches don't change, so the
+    /// buffer is written and uploaded again only when one of the matrices differs, which covers both moved and replaced objects.
+    ///
+    struct InstanceBuffer
+    {
+        std::unique_ptr<ConstantBuffer> Buffer;
+        std::vector<Matrix4> ToWorld;
+    };
+
+    ///
+    /// Objects drawn with one draw: consecutive objects of the batched order sharing mesh, material and texture set.
+    /// Objects whose shader has no instance buffer are drawn one by one with their own per object buffers.
+    ///
+    struct Batch
+    {
+        uint32 First = 0;
+        uint32 Count = 0;
+        InstanceBuffer* Instances = nullptr;
+    };
+
     void SetRenderTargets(CommandList* commandList, ResourceTable& resources) override;
+    ///
+    /// Order objects so that the ones sharing mesh, material and texture set go one after another and split them into batches.
+    /// order receives object indices, returns batches count.
+    ///
+    uint32 BuildBatches(uint32* order, Batch* batches);
+    ///
+    /// Get index-th instance buffer holding up to 2^sizeLog2 instances, buffers are created on demand.
+    ///
+    InstanceBuffer* GetInstanceBuffer(uint32 sizeLog2, uint32 index);
+    ///
+    /// Write matrices of the batch objects which differ from the last written ones and queue upload if any did.
+    ///
+    void UpdateInstanceBuffer(const uint32* order, const Batch& batch);
 
     struct Lights
     {
@@ -25,5 +66,21 @@ private:
     };
     ConstantBuffer m_lightsBuffer{ "lights", 2, 1, sizeof(Lights), 1, true };
     Lights m_lights;
+
+    struct InstanceData
+    {
+        Matrix4 ToWorld;
+        Matrix4 ToModel;
+    };
+    // One buffer per instanced batch, grows to the max batches count of a frame. Batches use the smallest buffers fitting them,
+    // so that the upload size follows the instances count. Shader never reads instances past the drawn count.
+    std::array<std::vector<std::unique_ptr<InstanceBuffer>>, InstanceBufferSizesCount> m_instanceBuffers;
+
+    // Names of buffers and constants set per draw, interned once.
+    StringId m_cbCameraId = InvalidStringId;
+    StringId m_cbEngineId = InvalidStringId;
+    StringId m_lightsId = InvalidStringId;
+    StringId m_cbInstancesId = InvalidStringId;
+    StringId m_lightsCountId = InvalidStringId;
 };
 }
\ No newline at end of file
@@ -57,9 +57,9 @@ void GrayscaleRenderPass::BuildRenderPackets(CommandList* commandList, ResourceT
     currPacket.Pass = GetHandle();
     currPacket.ConstantBufferHandles = std::move(m_renderObject->GetCBHandles(m_passName));
 
-    commandList->PushCommand(RenderCommandHelpers::CreateRenderPacketCommand(currPacket, this));
+    RenderCommandHelpers::PushRenderPacketCommand(commandList, currPacket, this);
 
-    commandList->PushCommand(RenderCommandHelpers::CreatePassEndsCommand(this));
+    RenderCommandHelpers::PushPassEndsCommand(commandList, this);
 }
 
 void GrayscaleRenderPass::Cleanup()
@@ -81,7 +81,7 @@ void GrayscaleRenderPass::SetRenderTargets(CommandList* commandList, ResourceTab
     cmd.ClearStencil = false;
     cmd.ClearStencilValue = 0;
 
-    commandList->PushCommand(RenderCommandHelpers::CreateSetRenderTargetCommand(cmd, this));
+    RenderCommandHelpers::PushSetRenderTargetCommand(commandList, cmd, this);
 }
 
 bool GrayscaleRenderPass::ConfigureInputsAndOutputs(ResourcesBlackboard& resources)
@@ -89,6 +89,7 @@ bool GrayscaleRenderPass::ConfigureInputsAndOutputs(ResourcesBlackboard& resourc
     const RenderOptions& settings = KiotoCore::GetRenderSettings();
 
     resources.ScheduleRead("FwdTargetTexture");
+    resources.ScheduleWriteBackBuffer();
 
     if (settings.RenderMode == RenderOptions::RenderModeOptions::Final
         || settings.RenderMode == RenderOptions::RenderModeOptions::FinalAndWireframe)
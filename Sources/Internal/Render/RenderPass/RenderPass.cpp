@@ -20,6 +20,7 @@ RenderPass::RenderPass(const RenderPass& other)
     , m_handle(other.m_handle)
     , m_renderTargetCount(other.m_renderTargetCount)
     , m_passName(other.m_passName)
+    , m_passNameId(other.m_passNameId)
 {
 }
 }
\ No newline at end of file
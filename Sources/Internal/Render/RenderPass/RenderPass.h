@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "Core/CoreTypes.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/Memory/FrameAllocator.h"
 #include "Math/Rect.h"
 #include "Render/RenderCommand.h"
 #include "Render/RendererPublic.h"
@@ -26,6 +28,7 @@ class RenderPass // [a_vorontcov] Add render target and depth stencil resource s
 public:
     RenderPass(std::string name)
         : m_passName(name)
+        , m_passNameId(StringTable::Intern(m_passName))
     {
     }
 
@@ -72,10 +75,34 @@ public:
     RenderPassHandle GetHandle() const;
 
     const std::string& GetName() const;
+    StringId GetNameId() const;
 
 protected:
+    static constexpr uint32 RecordingGrainSize = 64;
+    static constexpr uint32 RecordedCommandSizeHint = 128; // Render packet command with a few constant buffers, chunk lists are sized by it.
+
     virtual void SetRenderTargets(CommandList* commandList, ResourceTable& resources) abstract; // Set scissor, render targets, viewports
 
+    ///
+    /// Call record(CommandList*, uint32 index) for every index in [0, count) on the job workers. Every chunk of RecordingGrainSize
+    /// indices is recorded to its own list, chunks are appended to commandList in index order, so the result equals the serial loop.
+    ///
+    template <typename F>
+    void RecordParallel(CommandList* commandList, uint32 count, F&& record);
+
+    ///
+    /// Same as RecordParallel, but recorded render packets are appended ordered by their sort keys. record must push only render packets.
+    ///
+    template <typename F>
+    void RecordSorted(CommandList* commandList, uint32 count, F&& record);
+
+    ///
+    /// Record every chunk of RecordingGrainSize indices to its own list in frame memory, sized for the chunk. Returns the lists,
+    /// chunksCount is set to their count.
+    ///
+    template <typename F>
+    CommandList* RecordChunks(uint32 count, F&& record, uint32& chunksCount);
+
     RectI m_scissor;
     RectI m_viewport;
     bool m_clearColor = true;
@@ -90,6 +117,7 @@ protected:
     uint32 m_priority = PassPriority::MainPass;
 
     std::string m_passName;
+    StringId m_passNameId = InvalidStringId;
     const DrawData* m_drawData = nullptr;
 };
 
@@ -222,4 +250,51 @@ inline const std::string& RenderPass::GetName() const
 {
     return m_passName;
 }
+
+inline StringId RenderPass::GetNameId() const
+{
+    return m_passNameId;
+}
+
+template <typename F>
+void RenderPass::RecordParallel(CommandList* commandList, uint32 count, F&& record)
+{
+    if (count <= RecordingGrainSize || JobSystem::GetWorkersCount() == 1)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            record(commandList, i);
+        return;
+    }
+
+    uint32 chunksCount = 0;
+    CommandList* chunkLists = RecordChunks(count, std::forward<F>(record), chunksCount);
+    commandList->Append(chunkLists, chunksCount);
+}
+
+template <typename F>
+void RenderPass::RecordSorted(CommandList* commandList, uint32 count, F&& record)
+{
+    uint32 chunksCount = 0;
+    CommandList* chunkLists = RecordChunks(count, std::forward<F>(record), chunksCount);
+    commandList->AppendSorted(chunkLists, chunksCount);
+}
+
+template <typename F>
+CommandList* RenderPass::RecordChunks(uint32 count, F&& record, uint32& chunksCount)
+{
+    chunksCount = (count + RecordingGrainSize - 1) / RecordingGrainSize;
+    // Lists are constructed by the jobs recording them. ParallelFor may pass several chunks in one range when it runs serially.
+    CommandList* chunkLists = static_cast<CommandList*>(FrameAllocator::Allocate(sizeof(CommandList) * chunksCount, alignof(CommandList)));
+    JobSystem::ParallelFor(0, count, RecordingGrainSize, [&record, chunkLists](uint32 begin, uint32 end)
+    {
+        for (uint32 chunkBegin = begin; chunkBegin < end; chunkBegin += RecordingGrainSize)
+        {
+            uint32 chunkEnd = (std::min)(chunkBegin + RecordingGrainSize, end);
+            CommandList* chunkList = new (chunkLists + chunkBegin / RecordingGrainSize) CommandList((chunkEnd - chunkBegin) * RecordedCommandSizeHint);
+            for (uint32 i = chunkBegin; i < chunkEnd; ++i)
+                record(chunkList, i);
+        }
+    });
+    return chunkLists;
+}
 }
\ No newline at end of file
@@ -21,34 +21,43 @@ namespace Kioto::Renderer
     {
         Renderer::RegisterRenderPass(this);
         SetRenderTargetCount(1);
+
+        m_cbCameraId = StringTable::Intern(Renderer::SInp::Wireframe_sinp::cbCameraName);
+        m_cbEngineId = StringTable::Intern(Renderer::SInp::Wireframe_sinp::cbEngineName);
     }
 
     void WireframeRenderPass::BuildRenderPackets(CommandList* commandList, ResourceTable& resources)
     {
         SetRenderTargets(commandList, resources);
-        for (auto ro : m_drawData->RenderObjects)
+        Matrix4 view = Renderer::GetMainCamera()->GetView();
+        float32 farPlane = Renderer::GetMainCamera()->GetFarPlane();
+        RecordSorted(commandList, static_cast<uint32>(m_drawData->RenderObjects.size()), [this, &view, farPlane](CommandList* chunkList, uint32 index)
         {
-            ro->SetExternalCB(m_passName, Renderer::SInp::Wireframe_sinp::cbCameraName, Renderer::GetMainCamera()->GetConstantBuffer().GetHandle());
-            ro->SetExternalCB(m_passName, Renderer::SInp::Wireframe_sinp::cbEngineName, Renderer::EngineBuffers::GetTimeBuffer().GetHandle());
+            RenderObject* ro = m_drawData->RenderObjects[index];
+            ro->SetExternalCB(m_passNameId, m_cbCameraId, Renderer::GetMainCamera()->GetConstantBuffer().GetHandle());
+            ro->SetExternalCB(m_passNameId, m_cbEngineId, Renderer::EngineBuffers::GetTimeBuffer().GetHandle());
 
             Material* mat = ro->GetMaterial();
             Mesh* mesh = ro->GetMesh();
             mat->BuildMaterialForPass(this);
 
-            ro->PrepareConstantBuffers(m_passName);
+            ro->PrepareConstantBuffers(m_passNameId);
 
+            const PipelineState& state = ro->GetPipelineState(m_passNameId);
             RenderPacket currPacket = {};
             currPacket.Material = mat->GetHandle();
-            currPacket.Shader = mat->GetPipelineState(m_passName).Shader->GetHandle();
-            currPacket.TextureSet = ro->GetTextureSet(m_passName).GetHandle();
+            currPacket.Shader = state.Shader->GetHandle();
+            currPacket.TextureSet = ro->GetTextureSet(m_passNameId).GetHandle();
             currPacket.Mesh = mesh->GetHandle();
             currPacket.Pass = GetHandle();
-            currPacket.ConstantBufferHandles = std::move(ro->GetCBHandles(m_passName));
+            currPacket.SortKey = SortKey::Build(state.LayerType, currPacket.Pass, currPacket.Shader, currPacket.Material, currPacket.TextureSet, currPacket.Mesh,
+                SortKey::GetNormalizedDepth(*ro->GetToWorld(), view, farPlane));
+            currPacket.ConstantBufferHandles = std::move(ro->GetCBHandles(m_passNameId));
 
-            commandList->PushCommand(RenderCommandHelpers::CreateRenderPacketCommand(currPacket, this));
-        }
+            RenderCommandHelpers::PushRenderPacketCommand(chunkList, currPacket, this);
+        });
 
-        commandList->PushCommand(RenderCommandHelpers::CreatePassEndsCommand(this));
+        RenderCommandHelpers::PushPassEndsCommand(commandList, this);
     }
 
     void WireframeRenderPass::Cleanup()
@@ -72,12 +81,14 @@ namespace Kioto::Renderer
         cmd.ClearStencil = isWireframe;
         cmd.ClearStencilValue = 0;
 
-        commandList->PushCommand(RenderCommandHelpers::CreateSetRenderTargetCommand(cmd, this));
+        RenderCommandHelpers::PushSetRenderTargetCommand(commandList, cmd, this);
     }
 
     bool WireframeRenderPass::ConfigureInputsAndOutputs(ResourcesBlackboard& resources)
     {
         const RenderOptions& settings = KiotoCore::GetRenderSettings();
+        resources.ScheduleWriteBackBuffer();
+
         if (settings.RenderMode == RenderOptions::RenderModeOptions::Wireframe
             || settings.RenderMode == RenderOptions::RenderModeOptions::FinalAndWireframe)
             return true;
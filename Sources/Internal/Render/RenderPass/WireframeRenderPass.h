@@ -15,5 +15,9 @@ namespace Kioto::Renderer
 
     private:
         void SetRenderTargets(CommandList* commandList, ResourceTable& resources) override;
+
+        // Names of buffers set per draw, interned once.
+        StringId m_cbCameraId = InvalidStringId;
+        StringId m_cbEngineId = InvalidStringId;
     };
 }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Renderer
+{
+///
+/// Counters of one submitted frame. Collected by the null backend, state changes are counted the same way DX12 backend sets the state.
+///
+struct RenderStats
+{
+    uint32 CommandListsCount = 0;
+    uint32 CommandsCount = 0;
+    uint64 CommandsDataSize = 0;
+    uint32 DrawsCount = 0;
+    uint32 DrawsSkipped = 0; // Draws not submitted because their pipeline state is still compiling.
+    uint32 InstancesCount = 0; // Instances drawn by all draws, greater than DrawsCount when draws are instanced.
+    uint32 PipelineStateChanges = 0;
+    uint32 RootSignatureChanges = 0;
+    uint32 TextureSetChanges = 0;
+    uint32 MeshChanges = 0;
+    uint32 RenderTargetChanges = 0;
+    uint32 ConstantBufferBindings = 0;
+    uint32 SkippedStateChanges = 0; // States not set because the previous draw has already set the same.
+    uint32 ResourceTransitions = 0;
+    uint32 RedundantTransitions = 0; // Transitions to the state resource is already in.
+    uint32 ConstantBuffersUploaded = 0;
+    uint64 ConstantDataUploaded = 0; // Bytes copied to upload buffers.
+    uint32 ConstantBuffersSkipped = 0; // Bound buffers which data hasn't changed since it was uploaded.
+    uint64 ConstantDataSkipped = 0; // Bytes of the skipped buffers.
+    uint32 PipelineStatesCompiling = 0;
+    uint32 ValidationErrors = 0;
+};
+}
\ No newline at end of file
@@ -2,23 +2,34 @@
 
 #include "Render/Renderer.h"
 
+#include <mutex>
+
 #include "IMGUI/imgui.h"
 
 #include "Core/CoreHelpers.h"
 #include "Core/Timer/GlobalTimer.h"
 #include "Render/Buffers/EngineBuffers.h"
-#include "Render/DX12/RendererDX12.h"
+#include "Render/ConstantBuffer.h"
+#include "Render/Null/RendererNull.h"
 #include "Systems/EventSystem/EngineEvents.h"
 #include "Systems/EventSystem/EventSystem.h"
 
 #include "Render/Shaders/autogen/CommonStructures.h"
 
+#if _WIN32 || _WIN64
+#include "Render/DX12/RendererDX12.h"
+#endif
+
 namespace Kioto::Renderer
 {
 namespace
 {
-RendererDX12* GameRenderer = nullptr; // [a_vorontcov] Not too cross-api for now. 
-                                      // TODO: no need for inheritance, just define the function like in namespace and #ifdef platforms (ps who cares about non dx12 anyway :) )
+// Backends have no common base, every call goes to the one created in Init through ForActiveBackend.
+#if _WIN32 || _WIN64
+RendererDX12* DxRenderer = nullptr;
+#endif
+RendererNull* NullRenderer = nullptr;
+RenderStats EmptyStats;
 
 uint16 m_height = -1;
 uint16 m_width = -1;
@@ -26,6 +37,19 @@ float32 m_aspect = 1.0f;
 
 Camera* m_mainCamera;
 
+std::mutex ResourcesMutex; // Passes record in parallel, registration and update queues of the backend are guarded by it.
+
+template <typename F>
+decltype(auto) ForActiveBackend(F&& f)
+{
+#if _WIN32 || _WIN64
+    if (DxRenderer != nullptr)
+        return f(DxRenderer);
+#endif
+    assert(NullRenderer != nullptr);
+    return f(NullRenderer);
+}
+
 void UpdateTimeBuffer()
 {
     ConstantBuffer& timeBuffer = EngineBuffers::GetTimeBuffer();
@@ -49,18 +73,25 @@ void Init(eRenderApi api, uint16 width, uint16 height)
     m_height = height;
     m_aspect = static_cast<float32>(m_width) / static_cast<float32>(m_height);
 
-    GameRenderer = new RendererDX12();
+#if _WIN32 || _WIN64
     if (api == eRenderApi::DirectX12)
-        GameRenderer->Init(width, height);
+        DxRenderer = new RendererDX12();
+#endif
+    if (api == eRenderApi::Null)
+        NullRenderer = new RendererNull();
+    ForActiveBackend([width, height](auto* renderer) { renderer->Init(width, height); });
 
     EngineBuffers::Init();
-    GameRenderer->RegisterConstantBuffer(EngineBuffers::GetTimeBuffer());
+    ForActiveBackend([](auto* renderer) { renderer->RegisterConstantBuffer(EngineBuffers::GetTimeBuffer()); });
 }
 
 void Shutdown()
 {
-    GameRenderer->Shutdown();
-    SafeDelete(GameRenderer);
+    ForActiveBackend([](auto* renderer) { renderer->Shutdown(); });
+#if _WIN32 || _WIN64
+    SafeDelete(DxRenderer);
+#endif
+    SafeDelete(NullRenderer);
 }
 
 void Resize(uint16 width, uint16 height, bool minimized)
@@ -77,23 +108,23 @@ void Resize(uint16 width, uint16 height, bool minimized)
 
     EventSystem::GlobalEventSystem.RaiseEvent(e);
 
-    GameRenderer->Resize(width, height);
+    ForActiveBackend([&](auto* renderer) { renderer->Resize(width, height); });
 }
 
 void StartFrame()
 {
-    GameRenderer->StartFrame();
+    ForActiveBackend([](auto* renderer) { renderer->StartFrame(); });
 }
 
 void ChangeFullScreenMode(bool fullScreen)
 {
-    GameRenderer->ChangeFullScreenMode(fullScreen);
+    ForActiveBackend([&](auto* renderer) { renderer->ChangeFullScreenMode(fullScreen); });
 }
 
 void Update(float32 dt) // [a_vorontcov] TODO: set frame command buffers here.
 {
     UpdateTimeBuffer();
-    GameRenderer->Update(dt);
+    ForActiveBackend([&](auto* renderer) { renderer->Update(dt); });
 
     ImGui::Begin("Stats || Renderer.cpp::Update(float dt)", NULL, ImGuiWindowFlags_NoFocusOnAppearing);
     ImGui::Text("Avg %.3f ms/F (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
@@ -102,7 +133,7 @@ void Update(float32 dt) // [a_vorontcov] TODO: set frame command buffers here.
 
 void Present()
 {
-    GameRenderer->Present();
+    ForActiveBackend([](auto* renderer) { renderer->Present(); });
 }
 
 uint16 GetWidth()
@@ -120,27 +151,45 @@ float32 GetAspect()
     return m_aspect;
 }
 
+const RenderStats& GetLastFrameStats()
+{
+#if _WIN32 || _WIN64
+    if (DxRenderer != nullptr)
+        return DxRenderer->GetLastFrameStats();
+#endif
+    if (NullRenderer != nullptr)
+        return NullRenderer->GetLastFrameStats();
+    return EmptyStats;
+}
+
 VertexLayoutHandle GenerateVertexLayout(const VertexLayout& layout)
 {
     return VertexLayoutHandle(InvalidHandle);
 
     // [a_vorontcov] TODO;
-    //return GameRenderer->GenerateVertexLayout(layout);
+    //return DxRenderer->GenerateVertexLayout(layout);
 }
 
 TextureHandle GetCurrentBackBufferHandle()
 {
-    return GameRenderer->GetCurrentBackBufferHandle();
+    return ForActiveBackend([](auto* renderer) { return renderer->GetCurrentBackBufferHandle(); });
 }
 
 TextureHandle GetDepthStencilHandle()
 {
-    return GameRenderer->GetDepthStencilHandle();
+    return ForActiveBackend([](auto* renderer) { return renderer->GetDepthStencilHandle(); });
 }
 
 void RegisterTexture(Texture* texture)
 {
-    GameRenderer->RegisterTexture(texture);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterTexture(texture); });
+}
+
+void UnregisterTexture(Texture* texture)
+{
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->UnregisterTexture(texture); });
 }
 
 template <typename T>
@@ -152,45 +201,53 @@ void RegisterRenderAsset(T* asset)
 template <>
 void RegisterRenderAsset(Texture* asset)
 {
-    GameRenderer->RegisterTexture(asset);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterTexture(asset); });
 }
 
 template <>
 void RegisterRenderAsset(Shader* asset)
 {
-    GameRenderer->RegisterShader(asset);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterShader(asset); });
 }
 
 template <>
 void RegisterRenderAsset(Mesh* asset)
 {
-    GameRenderer->RegisterMesh(asset);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterMesh(asset); });
 }
 
 void BuildMaterialForPass(Material& mat, const RenderPass* pass)
 {
-    GameRenderer->BuildMaterialForPass(mat, pass);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->BuildMaterialForPass(mat, pass); });
 }
 
 template <>
 void RegisterRenderAsset(Material* asset)
 {
-    GameRenderer->RegisterMaterial(asset);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterMaterial(asset); });
 }
 
 void RegisterRenderPass(RenderPass* renderPass)
 {
-    GameRenderer->RegisterRenderPass(renderPass);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterRenderPass(renderPass); });
 }
 
 void RegisterTextureSet(TextureSet& set)
 {
-    GameRenderer->RegisterTextureSet(set);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterTextureSet(set); });
 }
 
 void QueueTextureSetForUpdate(const TextureSet& set)
 {
-    GameRenderer->QueueTextureSetForUpdate(set);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->QueueTextureSetForUpdate(set); });
 }
 
 void SetMainCamera(Camera* camera)
@@ -203,24 +260,39 @@ Camera* GetMainCamera()
     return m_mainCamera; // by reference? depends, think bout it
 }
 
-void SubmitRenderCommands(const std::vector<RenderCommand>& commandList)
+void SubmitRenderCommands(const CommandList* commandList)
 {
-    GameRenderer->SubmitRenderCommands(commandList);
+    ForActiveBackend([&](auto* renderer) { renderer->SubmitRenderCommands(commandList); });
 }
 
 void QueueConstantBufferForUpdate(ConstantBuffer& buffer)
 {
-    GameRenderer->QueueConstantBufferForUpdate(buffer);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->QueueConstantBufferForUpdate(buffer); });
 }
 
 void RegisterConstantBuffer(ConstantBuffer& buffer)
 {
-    GameRenderer->RegisterConstantBuffer(buffer);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterConstantBuffer(buffer); });
+}
+
+void UnregisterConstantBuffer(ConstantBuffer& buffer)
+{
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->UnregisterConstantBuffer(buffer); });
 }
 
 void RegisterRenderObject(RenderObject& renderObject)
 {
-    GameRenderer->RegisterRenderObject(renderObject);
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->RegisterRenderObject(renderObject); });
+}
+
+void UnregisterRenderObject(RenderObject& renderObject)
+{
+    std::lock_guard<std::mutex> lock(ResourcesMutex);
+    ForActiveBackend([&](auto* renderer) { renderer->UnregisterRenderObject(renderObject); });
 }
 
 template void RegisterRenderAsset<Texture>(Texture* asset);
@@ -6,6 +6,7 @@
 #include "Core/CoreTypes.h"
 #include "Render/RendererPublic.h"
 #include "Render/RenderCommand.h"
+#include "Render/RenderStats.h"
 
 namespace Kioto::Renderer
 {
@@ -15,7 +16,8 @@ class RenderObject;
 
 enum class eRenderApi
 {
-    DirectX12
+    DirectX12,
+    Null // No GPU, command lists are validated and counted. Available on every platform.
 };
 
 void Init(eRenderApi api, uint16 width, uint16 height);
@@ -29,7 +31,7 @@ void ChangeFullScreenMode(bool fullScreen);
 void SetMainCamera(Camera* camera); // Set camera command buffers.
 Camera* GetMainCamera();
 
-void SubmitRenderCommands(const std::vector<RenderCommand>& commandList);
+void SubmitRenderCommands(const CommandList* commandList);
 
 void QueueTextureSetForUpdate(const TextureSet& set);
 void QueueConstantBufferForUpdate(ConstantBuffer& buffer);
@@ -38,13 +40,29 @@ template <typename T>
 void RegisterRenderAsset(T* asset);
 void RegisterRenderPass(RenderPass* renderPass);
 void RegisterTextureSet(TextureSet& set);
+///
+/// Release backend resources of the texture. GPU must be done with it, e.g. it wasn't used for more frames than are in flight.
+///
+void UnregisterTexture(Texture* texture);
 void RegisterConstantBuffer(ConstantBuffer& buffer);
+///
+/// Release backend resources of the buffer before it is deleted. Memory GPU may still read is reused after the current frame completes.
+///
+void UnregisterConstantBuffer(ConstantBuffer& buffer);
 void RegisterRenderObject(RenderObject& renderObject);
+///
+/// Unregister per object buffers of the render object before it is deleted.
+///
+void UnregisterRenderObject(RenderObject& renderObject);
 TextureHandle GetCurrentBackBufferHandle();
 TextureHandle GetDepthStencilHandle();
 KIOTO_API uint16 GetWidth();
 KIOTO_API uint16 GetHeight();
 KIOTO_API float32 GetAspect();
+///
+/// Get counters of the last presented frame. Null backend collects all of them, DX12 backend only constant buffer uploads.
+///
+KIOTO_API const RenderStats& GetLastFrameStats();
 
 VertexLayoutHandle GenerateVertexLayout(const VertexLayout& layout);
 void BuildMaterialForPass(Material& mat, const RenderPass* pass);
@@ -37,16 +37,8 @@ public:
     {
     }
 
-    SafeHandle(const SafeHandle& other)
-    {
-        this->m_handle = other.m_handle;
-    }
-
-    SafeHandle& operator=(const SafeHandle& other)
-    {
-        this->m_handle = other.m_handle;
-        return *this;
-    }
+    SafeHandle(const SafeHandle& other) = default;
+    SafeHandle& operator=(const SafeHandle& other) = default;
 
     bool operator== (const SafeHandle& other) const
     {
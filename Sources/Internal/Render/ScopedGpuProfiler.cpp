@@ -6,14 +6,14 @@
 
 namespace Kioto::Renderer
 {
-ScopedGpuProfiler::ScopedGpuProfiler(CommandList* cmdList, std::string name)
+ScopedGpuProfiler::ScopedGpuProfiler(CommandList* cmdList, StringId name)
     : m_cmdList(cmdList)
 {
-    m_cmdList->PushCommand(RenderCommandHelpers::CreateBeginGpuEventCommand(std::move(name)));
+    RenderCommandHelpers::PushBeginGpuEventCommand(m_cmdList, name);
 }
 
 ScopedGpuProfiler::~ScopedGpuProfiler()
 {
-    m_cmdList->PushCommand(RenderCommandHelpers::CreateEndGpuEventCommand());
+    RenderCommandHelpers::PushEndGpuEventCommand(m_cmdList);
 }
 }
\ No newline at end of file
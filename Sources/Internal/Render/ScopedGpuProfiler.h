@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Core/DataStructures/StringTable.h"
+
 namespace Kioto::Renderer
 {
 class CommandList;
@@ -7,7 +9,7 @@ class CommandList;
 class ScopedGpuProfiler
 {
 public:
-    ScopedGpuProfiler(CommandList* cmdList, std::string name);
+    ScopedGpuProfiler(CommandList* cmdList, StringId name);
 
     ~ScopedGpuProfiler();
 
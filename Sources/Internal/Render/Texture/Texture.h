@@ -183,6 +183,45 @@ inline bool operator!= (const TextureDescriptor& lhs, const TextureDescriptor& r
     return !(lhs == rhs);
 }
 
+///
+/// Get bits per pixel of the format. Block compressed formats return average bits per pixel.
+///
+inline uint32 GetFormatBitsPerPixel(eResourceFormat format)
+{
+    int32 f = static_cast<int32>(format);
+    if (f >= 1 && f <= 4)
+        return 128;
+    if (f >= 5 && f <= 8)
+        return 96;
+    if (f >= 9 && f <= 22)
+        return 64;
+    if ((f >= 23 && f <= 47) || (f >= 67 && f <= 69) || (f >= 87 && f <= 93) || f == 100 || f == 101 || f == 107)
+        return 32;
+    if ((f >= 48 && f <= 59) || f == 85 || f == 86 || f == 114 || f == 115 || f == 130 || f == 131)
+        return 16;
+    if ((f >= 60 && f <= 65) || (f >= 73 && f <= 78) || (f >= 82 && f <= 84) || (f >= 94 && f <= 99) || (f >= 111 && f <= 113))
+        return 8;
+    if ((f >= 70 && f <= 72) || (f >= 79 && f <= 81))
+        return 4;
+    if (f == 66)
+        return 1;
+    if (f == 102 || f == 108 || f == 109)
+        return 64;
+    if (f == 104 || f == 105 || f == 132)
+        return 24;
+    if (f == 103 || f == 106 || f == 110)
+        return 12;
+    return 0;
+}
+
+///
+/// Get estimated size of texture memory in bytes, without placement alignment.
+///
+inline uint64 GetTextureSize(const TextureDescriptor& desc)
+{
+    return static_cast<uint64>(desc.Width) * desc.Height * GetFormatBitsPerPixel(desc.Format) / 8;
+}
+
 class Texture : public Asset
 {
 public:
@@ -195,6 +234,7 @@ public:
 
     const TextureDescriptor& GetDescriptor() const;
     eResourceState GetCurrentState() const;
+    void SetCurrentState(eResourceState state); // State expected after already scheduled transitions.
 
 private:
     TextureHandle m_handle;
@@ -229,4 +269,9 @@ inline eResourceState Texture::GetCurrentState() const
     return m_currentState;
 }
 
+inline void Texture::SetCurrentState(eResourceState state)
+{
+    m_currentState = state;
+}
+
 }
\ No newline at end of file
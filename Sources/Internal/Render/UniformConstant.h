@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "Core/CoreTypes.h"
+#include "Core/DataStructures/StringTable.h"
 
 namespace Kioto::Renderer
 {
@@ -21,9 +22,11 @@ public:
     uint16 GetSpace() const;
 
     const std::string& GetName() const;
+    StringId GetNameId() const;
 
 private:
     std::string m_name;
+    StringId m_nameId = InvalidStringId;
     uint32 m_value;
     uint16 m_index;
     uint16 m_space;
@@ -31,6 +34,7 @@ private:
 
 inline UniformConstant::UniformConstant(const std::string& name, uint16 index, uint16 space)
     : m_name(name)
+    , m_nameId(StringTable::Intern(name))
     , m_index(index)
     , m_space(space)
     , m_value(0)
@@ -64,4 +68,9 @@ inline const std::string& UniformConstant::GetName() const
     return m_name;
 }
 
+inline StringId UniformConstant::GetNameId() const
+{
+    return m_nameId;
+}
+
 }
\ No newline at end of file
@@ -13,12 +13,13 @@ namespace Kioto
 {
 CameraSystem::CameraSystem()
 {
-    m_components.reserve(4);
+    DeclareRead<TransformComponent>();
+    DeclareWrite<CameraComponent>();
+    DeclareMainThreadOnly(); // Updates camera constant buffers and the main camera of the renderer.
 }
 
 CameraSystem::~CameraSystem()
 {
-    m_components.clear();
 }
 
 void CameraSystem::Init()
@@ -36,38 +37,39 @@ void CameraSystem::Init()
 
 void CameraSystem::OnEntityAdd(Entity* entity)
 {
-    CameraComponent* t = entity->GetComponent<CameraComponent>();
-    if (t == nullptr)
-        return;
-    m_components.push_back(t);
 }
 
 void CameraSystem::OnEntityRemove(Entity* entity)
 {
     CameraComponent* t = entity->GetComponent<CameraComponent>();
-    if (t == nullptr)
-        return;
-    auto it = std::find(m_components.begin(), m_components.end(), t);
-    if (it != m_components.end())
-        m_components.erase(it);
+    if (t != nullptr && m_mainCamera == &t->GetCamera())
+        m_mainCamera = nullptr;
 }
 
 void CameraSystem::Update(float32 dt)
 {
-    for (CameraComponent* camComponent : m_components)
+    CameraComponent::GetPoolS().ForEach(GetSceneIndex(), [this](CameraComponent& camComponent)
     {
-        Renderer::Camera& currCam = camComponent->GetCamera();
-        if (camComponent->GetIsMain())
+        Renderer::Camera& currCam = camComponent.GetCamera();
+        if (camComponent.GetIsMain())
             m_mainCamera = &currCam;
 
-        UpdateView(camComponent);
+        bool isMoved = camComponent.m_transformVersion != camComponent.m_transform->GetVersion();
+        if (!isMoved && !currCam.GetIsProjectionDirty())
+            return;
+
+        if (isMoved)
+        {
+            UpdateView(&camComponent);
+            camComponent.m_transformVersion = camComponent.m_transform->GetVersion();
+        }
 
         if (currCam.GetIsProjectionDirty())
             currCam.UpdateProjectionMatrix();
 
         currCam.UpdateViewProjectionMatrix();
-        currCam.UpdateConstantBuffer(); // [a_vorontcov] TODO: Do in when something was really changed.
-    }
+        currCam.UpdateConstantBuffer();
+    });
     Renderer::SetMainCamera(m_mainCamera);
 }
 
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <vector>
-
 #include "Core/CoreTypes.h"
 #include "Core/Core.h"
 
@@ -35,7 +33,6 @@ private:
     void UpdateView(CameraComponent* cam);
 
     Renderer::Camera* m_mainCamera = nullptr;
-    std::vector<CameraComponent*> m_components;
 };
 
 inline const Renderer::Camera* CameraSystem::GetMainCamera() const
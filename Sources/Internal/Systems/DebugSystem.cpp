@@ -4,6 +4,8 @@
 
 #include "Core/KiotoEngine.h"
 #include "Render/RenderOptions.h"
+#include "Systems/EventSystem/EngineEvents.h"
+#include "Systems/EventSystem/EventSystem.h"
 
 #include "IMGUI/imgui.h"
 
@@ -11,6 +13,7 @@ namespace Kioto
 {
     DebugSystem::DebugSystem()
     {
+        DeclareMainThreadOnly();
     }
 
     DebugSystem::~DebugSystem()
@@ -48,6 +51,7 @@ namespace Kioto
                 {
                     current_item = items[n];
                     KiotoCore::GetRenderSettings().RenderMode = renderModeOptions[n];
+                    EventSystem::GlobalEventSystem.RaiseEvent(std::make_shared<OnRenderSettingsChanged>());
                 }
                 if (is_selected)
                     ImGui::SetItemDefaultFocus();
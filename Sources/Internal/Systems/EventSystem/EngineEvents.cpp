@@ -18,4 +18,9 @@ void* OnMainWindowResized::GetEventData()
 {
     return &m_data;
 }
+
+void* OnRenderSettingsChanged::GetEventData()
+{
+    return nullptr;
+}
 }
\ No newline at end of file
@@ -47,4 +47,15 @@ public:
 private:
     Data m_data{};
 };
+
+struct OnRenderSettingsChanged : public Event
+{
+    DECLARE_EVENT(OnRenderSettingsChanged);
+
+public:
+    OnRenderSettingsChanged() = default;
+    ~OnRenderSettingsChanged() override = default;
+
+    void* GetEventData() override;
+};
 }
\ No newline at end of file
@@ -3,12 +3,18 @@
 #include "Systems/ImguiEditorSystem.h"
 
 #include "Core/ECS/Entity.h"
+#include "Core/Input/Input.h"
+#include "Core/KiotoEngine.h"
+#include "Core/Scene.h"
 
 #include "Component/TransformComponent.h"
 #include "Component/LightComponent.h"
 #include "Component/RenderComponent.h"
 #include "Render/RenderObject.h"
 #include "Render/Material.h"
+#include "Render/Camera.h"
+#include "Render/Renderer.h"
+#include "Systems/RenderSystem.h"
 
 #include "Render/Color.h"
 
@@ -18,43 +24,55 @@ namespace Kioto
 {
 ImguiEditorSystem::ImguiEditorSystem()
 {
+    DeclareMainThreadOnly();
     m_entities.reserve(512);
 }
 
 ImguiEditorSystem::~ImguiEditorSystem()
 {
     m_entities.clear();
+    m_entitiesNames.clear();
+    m_entitiesPositions.clear();
 }
 
 void ImguiEditorSystem::OnEntityAdd(Entity* entity)
 {
-    auto it = std::find(m_entities.begin(), m_entities.end(), entity);
-    assert(it == m_entities.end());
+    uint32 index = entity->GetId().Index;
+    if (index >= m_entitiesPositions.size())
+        m_entitiesPositions.resize(index + 1, EntityId::InvalidIndex);
+    assert(m_entitiesPositions[index] == EntityId::InvalidIndex);
 
+    m_entitiesPositions[index] = static_cast<uint32>(m_entities.size());
     m_entities.push_back(entity);
     m_entitiesNames.push_back(entity->GetName().c_str());
 }
 
 void ImguiEditorSystem::OnEntityRemove(Entity* entity)
 {
-    auto it = std::find(m_entities.begin(), m_entities.end(), entity);
-    assert(it != m_entities.end());
-
-    const char* name = entity->GetName().c_str();
-    m_entitiesNames.erase(std::find(m_entitiesNames.begin(), m_entitiesNames.end(), name));
-    m_entities.erase(it);
+    uint32 index = entity->GetId().Index;
+    uint32 position = m_entitiesPositions[index];
+    assert(position != EntityId::InvalidIndex);
+
+    Entity* last = m_entities.back();
+    m_entities[position] = last;
+    m_entitiesNames[position] = m_entitiesNames.back();
+    m_entitiesPositions[last->GetId().Index] = position;
+    m_entities.pop_back();
+    m_entitiesNames.pop_back();
+    m_entitiesPositions[index] = EntityId::InvalidIndex;
 }
 
 void ImguiEditorSystem::Update(float32 dt)
 {
-    static int selectedEntityIndex = 1;
+    if (Input::GetMouseDown(eMouseCodes::MouseLeft) && !ImGui::GetIO().WantCaptureMouse)
+        PickEntity();
 
     //ImGui::ShowDemoWindow();
 
     ImGui::Begin("Scene", NULL, ImGuiWindowFlags_NoFocusOnAppearing);
-    ImGui::ListBox("", &selectedEntityIndex, m_entitiesNames.data(), int(m_entitiesNames.size()), 15);
+    ImGui::ListBox("", &m_selectedEntityIndex, m_entitiesNames.data(), int(m_entitiesNames.size()), 15);
 
-    const Entity* selectedEntity = m_entities[selectedEntityIndex];
+    const Entity* selectedEntity = m_entities[m_selectedEntityIndex];
 
     TransformComponent* transform = selectedEntity->GetTransform();
     DrawComponentEditor(transform);
@@ -195,4 +213,26 @@ void ImguiEditorSystem::DrawComponentEditor(TransformComponent* transform)
     }
 }
 
+void ImguiEditorSystem::PickEntity()
+{
+    const Renderer::Camera* camera = Renderer::GetMainCamera();
+    RenderSystem* renderSystem = GetScene()->GetRenderSystem();
+    Matrix4 invVP;
+    if (camera == nullptr || renderSystem == nullptr || !camera->GetVP().Inversed(invVP))
+        return;
+
+    // Unproject cursor on near and far planes, ray parameter 0..1 covers the whole view depth.
+    const ImGuiIO& io = ImGui::GetIO();
+    float32 x = 2.0f * io.MousePos.x / io.DisplaySize.x - 1.0f;
+    float32 y = 1.0f - 2.0f * io.MousePos.y / io.DisplaySize.y;
+    Vector4 nearPoint = Vector4(x, y, 0.0f, 1.0f) * invVP;
+    Vector4 farPoint = Vector4(x, y, 1.0f, 1.0f) * invVP;
+    Vector3 origin = nearPoint.GetVec3() * (1.0f / nearPoint.w);
+    Vector3 direction = farPoint.GetVec3() * (1.0f / farPoint.w) - origin;
+
+    RenderComponent* picked = renderSystem->RayCast(origin, direction, 1.0f);
+    if (picked != nullptr)
+        m_selectedEntityIndex = static_cast<int>(m_entitiesPositions[picked->GetEntity()->GetId().Index]);
+}
+
 }
\ No newline at end of file
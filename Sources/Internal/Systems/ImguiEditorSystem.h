@@ -28,8 +28,14 @@ private:
     void DrawComponentEditor(LightComponent* lightComponent);
     void DrawComponentEditor(RenderComponent* renderComponent);
     void DrawComponentEditor(TransformComponent* transform);
+    ///
+    /// Select entity whose render component is under the mouse cursor.
+    ///
+    void PickEntity();
 
     std::vector<Entity*> m_entities;
     std::vector<const char*> m_entitiesNames; // [a_vorontcov] meh :(
+    std::vector<uint32> m_entitiesPositions; // Position in m_entities by entity id index.
+    int m_selectedEntityIndex = 1;
 };
 }
\ No newline at end of file
@@ -3,9 +3,14 @@
 #include "Systems/RenderSystem.h"
 
 #include "AssetsSystem/AssetsSystem.h"
+#include "Component/CameraComponent.h"
 #include "Component/LightComponent.h"
 #include "Component/RenderComponent.h"
 #include "Core/ECS/Entity.h"
+#include "Core/KiotoEngine.h"
+#include "Core/Scene.h"
+#include "Render/Camera.h"
+#include "Render/Culling.h"
 #include "Render/Geometry/Mesh.h"
 #include "Render/Material.h"
 #include "Render/Shader.h"
@@ -15,18 +20,30 @@
 #include "Render/RenderPass/WireframeRenderPass.h"
 #include "Render/RenderPass/GrayscaleRenderPass.h"
 #include "Render/RenderPass/EditorGizmosPass.h"
+#include "Systems/EventSystem/EngineEvents.h"
+#include "Systems/EventSystem/EventSystem.h"
+#include "Systems/TransformSystem.h"
 
 namespace Kioto
 {
 static constexpr uint32 MAX_LIGHTS_COUNT = 256;
 
+namespace
+{
+BoundingBox GetWorldBounds(const RenderComponent* rc)
+{
+    return rc->GetRenderObject()->GetMesh()->GetBoundingBox().Transformed(rc->GetEntity()->GetTransform()->GetToWorld());
+}
+}
+
 RenderSystem::RenderSystem()
 {
+    DeclareRead<TransformComponent>();
+    DeclareRead<CameraComponent>();
+    DeclareWrite<RenderComponent>();
+    DeclareWrite<LightComponent>();
+    DeclareMainThreadOnly();
     m_renderPasses.reserve(Kioto::RenderOptions::MaxRenderPassesCount);
-    m_drawData.RenderObjects.reserve(2048);
-    m_drawData.Lights.reserve(MAX_LIGHTS_COUNT);
-    m_components.reserve(2048);
-    m_lights.reserve(256);
 }
 
 void RenderSystem::Init()
@@ -36,46 +53,64 @@ void RenderSystem::Init()
     AddRenderPass(new Renderer::EditorGizmosPass());
     AddRenderPass(new Renderer::GrayscaleRenderPass());
     AddRenderPass(new Renderer::WireframeRenderPass());
+
+    // Passes declare resources depending on render mode and resolution, other frames replay the compiled graph.
+    EventSystem::GlobalEventSystem.Subscribe<OnMainWindowResized>({ [this](std::shared_ptr<Event> e) { m_renderGraph.Invalidate(); } }, this);
+    EventSystem::GlobalEventSystem.Subscribe<OnRenderSettingsChanged>({ [this](std::shared_ptr<Event> e) { m_renderGraph.Invalidate(); } }, this);
 }
 
 void RenderSystem::OnEntityAdd(Entity* entity)
 {
-    ParseLights(entity);
     ParseRenderComponents(entity);
 }
 
 void RenderSystem::OnEntityRemove(Entity* entity)
 {
-    TryRemoveLight(entity);
     TryRemoveRenderComponent(entity);
 }
 
 void RenderSystem::Update(float32 dt)
 {
-    for (auto rc : m_components)
+    UpdateSpatialIndex();
+
+    Renderer::DrawData drawData;
+    FrameVector<Renderer::RenderObject*> renderObjects;
+    renderObjects.reserve(RenderComponent::GetPoolS().GetAliveCount());
+    drawData.Lights.reserve((std::min)(LightComponent::GetPoolS().GetAliveCount(), MAX_LIGHTS_COUNT));
+
+    auto addRenderObject = [&renderObjects](RenderComponent& rc)
     {
-        if (!rc->GetIsEnabled())
-            continue;
-        Renderer::RenderObject* ro = rc->GetRenderObject();
-        TransformComponent* tc = rc->GetEntity()->GetTransform();
+        Renderer::RenderObject* ro = rc.GetRenderObject();
+        if (!rc.GetIsEnabled() || ro == nullptr)
+            return;
+        TransformComponent* tc = rc.GetEntity()->GetTransform();
         ro->SetToWorld(tc->GetToWorld());
         ro->SetToModel(tc->GetToModel());
-        m_drawData.RenderObjects.push_back(ro); // [a_vorontcov] TODO: Don't like copying this around.
+        ro->SetTransformVersion(tc->GetVersion());
+        renderObjects.push_back(ro); // [a_vorontcov] TODO: Don't like copying this around.
+    };
+
+    Renderer::Camera* camera = Renderer::GetMainCamera();
+    if (KiotoCore::GetRenderSettings().FrustumCulling && camera != nullptr)
+    {
+        // Hierarchy rejects whole groups of boxes outside the view, spheres of the rest are tested one by one.
+        m_spatialIndex.QueryFrustum(camera->GetFrustum(), [&addRenderObject](RenderComponent* rc) { addRenderObject(*rc); });
+        Renderer::Culling::CullRenderObjects(camera->GetFrustum(), renderObjects, drawData.RenderObjects);
     }
-    for (auto l : m_lights)
+    else
     {
-        if (!l->GetIsEnabled())
-            continue;
-        l->GetLight()->Position = l->GetEntity()->GetTransform()->GetWorldPosition();
-        m_drawData.Lights.push_back(l->GetLight());
+        RenderComponent::GetPoolS().ForEach(GetSceneIndex(), addRenderObject);
+        drawData.RenderObjects = std::move(renderObjects);
     }
-    for (auto pass : m_renderPasses)
-        m_renderGraph.AddPass(pass);
-
+    LightComponent::GetPoolS().ForEach(GetSceneIndex(), [&drawData](LightComponent& l)
+    {
+        if (!l.GetIsEnabled())
+            return;
+        l.GetLight()->Position = l.GetEntity()->GetTransform()->GetWorldPosition();
+        drawData.Lights.push_back(l.GetLight());
+    });
     m_renderGraph.SheduleGraph();
-    m_renderGraph.Execute(m_drawData);
-    m_drawData.RenderObjects.clear();
-    m_drawData.Lights.clear();
+    m_renderGraph.Execute(drawData);
 }
 
 void RenderSystem::Draw()
@@ -85,29 +120,53 @@ void RenderSystem::Draw()
 
 void RenderSystem::Shutdown()
 {
+    EventSystem::GlobalEventSystem.Unsubscribe(this);
+    m_renderGraph.Clear();
+    m_spatialIndex.Clear();
     for (auto it : m_renderPasses)
         SafeDelete(it);
     m_renderPasses.clear();
-    m_lights.clear();
 }
 
 void RenderSystem::AddRenderPass(Renderer::RenderPass* pass)
 {
     m_renderPasses.push_back(pass);
+    m_renderGraph.AddPass(pass);
 }
 
 void RenderSystem::RemoveRenderPass(Renderer::RenderPass* pass)
 {
     m_renderPasses.erase(std::remove(m_renderPasses.begin(), m_renderPasses.end(), pass), m_renderPasses.end());
+    m_renderGraph.RemovePass(pass);
     SafeDelete(pass);
 }
 
-void RenderSystem::ParseLights(Entity* entity)
+RenderComponent* RenderSystem::RayCast(const Vector3& origin, const Vector3& direction, float32 maxDistance) const
 {
-    LightComponent* light = entity->GetComponent<LightComponent>();
-    if (light == nullptr)
-        return;
-    m_lights.push_back(light);
+    // Leaves are fattened, so hits are refined with exact world boxes.
+    Vector3 invDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    RenderComponent* closest = nullptr;
+    float32 closestDistance = maxDistance;
+    m_spatialIndex.RayCast(origin, direction, maxDistance, [&](RenderComponent* rc, float32 distance)
+    {
+        if (rc->GetIsEnabled() && GetWorldBounds(rc).IntersectsRay(origin, invDirection, closestDistance, distance))
+        {
+            closest = rc;
+            closestDistance = distance;
+        }
+        return closestDistance;
+    });
+    return closest;
+}
+
+void RenderSystem::UpdateSpatialIndex()
+{
+    for (TransformComponent* t : GetScene()->GetTransformSystem()->GetMovedTransforms())
+    {
+        RenderComponent* rc = t->GetEntity()->GetComponent<RenderComponent>();
+        if (rc != nullptr && rc->GetSpatialProxy() != BoundingVolumeHierarchy<RenderComponent*>::InvalidProxy)
+            m_spatialIndex.Move(rc->GetSpatialProxy(), GetWorldBounds(rc));
+    }
 }
 
 void RenderSystem::ParseRenderComponents(Entity* entity)
@@ -128,18 +187,7 @@ void RenderSystem::ParseRenderComponents(Entity* entity)
     Renderer::RegisterRenderObject(*ro);
 
     renderComponent->SetRenderObject(ro);
-
-    m_components.push_back(renderComponent);
-}
-
-void RenderSystem::TryRemoveLight(Entity* entity)
-{
-    LightComponent* light = entity->GetComponent<LightComponent>();
-    if (light == nullptr)
-        return;
-    auto it = std::find(m_lights.begin(), m_lights.end(), light);
-    if (it != m_lights.end())
-        m_lights.erase(it);
+    renderComponent->SetSpatialProxy(m_spatialIndex.Insert(GetWorldBounds(renderComponent), renderComponent));
 }
 
 void RenderSystem::TryRemoveRenderComponent(Entity* entity)
@@ -147,14 +195,16 @@ void RenderSystem::TryRemoveRenderComponent(Entity* entity)
     RenderComponent* t = entity->GetComponent<RenderComponent>();
     if (t == nullptr)
         return;
-    auto it = std::find(m_components.begin(), m_components.end(), t);
-    if (it != m_components.end())
+    if (t->GetSpatialProxy() != BoundingVolumeHierarchy<RenderComponent*>::InvalidProxy)
     {
-        Renderer::RenderObject* ro = t->GetRenderObject();
-        SafeDelete(ro);
-        t->SetRenderObject(nullptr);
-        m_components.erase(it);
+        m_spatialIndex.Remove(t->GetSpatialProxy());
+        t->SetSpatialProxy(BoundingVolumeHierarchy<RenderComponent*>::InvalidProxy);
     }
+    Renderer::RenderObject* ro = t->GetRenderObject();
+    if (ro != nullptr)
+        Renderer::UnregisterRenderObject(*ro);
+    SafeDelete(ro);
+    t->SetRenderObject(nullptr);
 }
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Core/CoreTypes.h"
 #include "Core/Core.h"
+#include "Core/DataStructures/BoundingVolumeHierarchy.h"
 #include "Core/ECS/SceneSystem.h"
 
 #include "Render/RenderGraph/RenderGraph.h"
@@ -16,7 +17,6 @@ class RenderObject;
 class ForwardRenderPass;
 }
 
-class LightComponent;
 class RenderComponent;
 
 class RenderSystem : public SceneSystem
@@ -35,20 +35,33 @@ public:
     void AddRenderPass(Renderer::RenderPass* pass);
     void RemoveRenderPass(Renderer::RenderPass* pass);
 
+    ///
+    /// Get enabled render component whose world bounds are hit first by the ray origin + t * direction, 0 <= t <= maxDistance.
+    /// Returns nullptr if nothing is hit. Used for editor picking.
+    ///
+    KIOTO_API RenderComponent* RayCast(const Vector3& origin, const Vector3& direction, float32 maxDistance) const;
+
+    ///
+    /// Get world bounds of render components for custom frustum, sphere and box queries.
+    ///
+    const BoundingVolumeHierarchy<RenderComponent*>& GetSpatialIndex() const;
+
 private:
-    void ParseLights(Entity* entity);
     void ParseRenderComponents(Entity* entity);
-
-    void TryRemoveLight(Entity* entity);
     void TryRemoveRenderComponent(Entity* entity);
+    void UpdateSpatialIndex();
 
     std::vector<Renderer::RenderPass*> m_renderPasses;
-    std::vector<RenderComponent*> m_components;
-    std::vector<LightComponent*> m_lights;
 
-    Renderer::DrawData m_drawData;
     Renderer::ForwardRenderPass* m_forwardRenderPass = nullptr;
 
     Renderer::RenderGraph m_renderGraph;
+
+    BoundingVolumeHierarchy<RenderComponent*> m_spatialIndex; // World boxes of render components, moved along with their transforms.
 };
+
+inline const BoundingVolumeHierarchy<RenderComponent*>& RenderSystem::GetSpatialIndex() const
+{
+    return m_spatialIndex;
+}
 }
\ No newline at end of file
@@ -3,59 +3,251 @@
 #include "Systems/TransformSystem.h"
 
 #include "Core/ECS/Entity.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Math/MathBatch.h"
 
 namespace Kioto
 {
+namespace
+{
+bool IsUniform(const Vector3& scale)
+{
+    return Math::IsFloatEqual(scale.x, scale.y) && Math::IsFloatEqual(scale.x, scale.z);
+}
+}
+
 TransformSystem::TransformSystem()
 {
-    m_components.reserve(512);
+    DeclareWrite<TransformComponent>();
 }
 
 TransformSystem::~TransformSystem()
 {
-    m_components.clear();
+    for (auto& level : m_levels)
+    {
+        for (auto t : level)
+            t->m_system = nullptr;
+    }
+    m_levels.clear();
+    m_dirtyLevels.clear();
 }
 
 void TransformSystem::OnEntityAdd(Entity* entity)
 {
     TransformComponent* t = entity->GetTransform();
-    if (t == nullptr) // [a_vorontcov] o.O
+    if (t == nullptr)
         return;
-    m_components.push_back(t);
+    t->m_system = this;
+    t->m_isDirty = true;
+    AddToLevels(t);
 }
 
 void TransformSystem::OnEntityRemove(Entity* entity)
 {
     TransformComponent* t = entity->GetTransform();
-    if (t == nullptr) // [a_vorontcov] o.O
+    if (t == nullptr || t->m_system != this)
         return;
-    auto it = std::find(m_components.begin(), m_components.end(), t);
-    if (it != m_components.end())
-        m_components.erase(it);
+    RemoveFromLevels(t);
+    RemoveFromMoved(t);
+    t->m_system = nullptr;
 }
 
 void TransformSystem::Update(float32 dt)
 {
-    for (TransformComponent* currTransform : m_components)
+    m_movedTransforms.clear();
+    for (size_t depth = 0; ; ++depth)
     {
-        if (currTransform->GetDirty())
         {
-            ComposeMatricies(currTransform);
-            currTransform->RemoveDirty();
+            std::lock_guard<std::mutex> lock(m_dirtyMutex);
+            if (depth >= m_dirtyLevels.size())
+                break;
+            // Flags are reset before composing, transforms moved meanwhile go to the emptied list and are composed next frame.
+            m_composing.swap(m_dirtyLevels[depth]);
+            for (auto t : m_composing)
+                t->RemoveDirty();
         }
+        if (m_composing.empty())
+            continue;
+
+        JobSystem::ParallelFor(0, static_cast<uint32>(m_composing.size()), ComposeGrainSize, [this](uint32 begin, uint32 end)
+        {
+            ComposeMatricies(m_composing.data() + begin, end - begin);
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(m_dirtyMutex);
+            for (auto t : m_composing)
+            {
+                for (auto child : t->m_children)
+                {
+                    if (child->m_system == this && !child->m_isDirty.exchange(true))
+                        AddToDirty(child);
+                }
+            }
+        }
+        for (auto t : m_composing)
+        {
+            t->m_movedIndex = static_cast<uint32>(m_movedTransforms.size());
+            m_movedTransforms.push_back(t);
+        }
+        m_composing.clear();
+    }
+}
+
+void TransformSystem::ComposeMatricies(TransformComponent* const* transforms, uint32 count)
+{
+    // Local and world matrices are composed by batch calls for up to ComposeBatchSize transforms gathered into arrays,
+    // the rest depends on per transform scale and is finished one by one.
+    Vector3 positions[ComposeBatchSize];
+    Quaternion rotations[ComposeBatchSize];
+    Vector3 scales[ComposeBatchSize];
+    Matrix4 toParent[ComposeBatchSize];
+    Matrix4 parentToWorld[ComposeBatchSize];
+    Matrix4 toWorld[ComposeBatchSize];
+
+    // Transforms of one level have the same depth, so either all of them have parents or none.
+    const bool hasParents = transforms[0]->m_parent != nullptr;
+    for (uint32 batchBegin = 0; batchBegin < count; batchBegin += ComposeBatchSize)
+    {
+        uint32 batchCount = (std::min)(ComposeBatchSize, count - batchBegin);
+        for (uint32 i = 0; i < batchCount; ++i)
+        {
+            const TransformComponent* t = transforms[batchBegin + i];
+            positions[i] = t->m_localPosition;
+            rotations[i] = t->m_localRotation;
+            scales[i] = t->m_localScale;
+            if (hasParents)
+                parentToWorld[i] = t->m_parent->m_toWorld;
+        }
+
+        Math::Batch::ComposeMatrices(positions, rotations, scales, toParent, batchCount);
+        if (hasParents)
+            Math::Batch::MultiplyMatrices(toParent, parentToWorld, toWorld, batchCount);
+
+        for (uint32 i = 0; i < batchCount; ++i)
+            FinishCompose(transforms[batchBegin + i], toParent[i], hasParents ? toWorld[i] : toParent[i]);
+    }
+}
+
+void TransformSystem::FinishCompose(TransformComponent* t, const Matrix4& toParent, const Matrix4& toWorld)
+{
+    t->m_toParent = toParent;
+    t->m_toWorld = toWorld;
+
+    bool isScaleUniform = IsUniform(t->m_localScale);
+    float32 uniformScale = t->m_localScale.x;
+    const TransformComponent* parent = t->m_parent;
+    if (parent != nullptr)
+    {
+        t->m_worldRotation = parent->m_worldRotation * t->m_localRotation;
+        isScaleUniform = isScaleUniform && parent->m_isWorldScaleUniform;
+        uniformScale *= parent->m_worldUniformScale;
+    }
+    else
+    {
+        t->m_worldRotation = t->m_localRotation;
+    }
+    t->m_worldPosition = t->m_toWorld.GetTranslation();
+    t->m_isWorldScaleUniform = isScaleUniform;
+    t->m_worldUniformScale = uniformScale;
+    ++t->m_version;
+
+    if (isScaleUniform && Math::IsFloatEqual(uniformScale, 1.0f))
+    {
+        t->m_toModel = t->m_toWorld.InversedOrthonorm();
+    }
+    else if (isScaleUniform)
+    {
+        t->m_toModel = t->m_toWorld.InversedUniformScale(uniformScale);
+    }
+    else
+    {
+        bool isInversed = t->m_toWorld.Inversed(t->m_toModel);
+        assert(isInversed);
     }
 }
 
-void TransformSystem::ComposeMatricies(TransformComponent* t)
+void TransformSystem::AddToLevels(TransformComponent* t)
 {
-    const Vector3& pos = t->GetWorldPosition();
-    Matrix4 toWorld = t->GetWorldRotation().ToMatrix();
-    toWorld.SetTranslation(pos);
-    t->SetToWorld(toWorld);
+    uint32 depth = 0;
+    for (auto p = t->m_parent; p != nullptr; p = p->m_parent)
+        ++depth;
 
-    Matrix4 toModel{};
-    assert(toWorld.Inversed(toModel));
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    if (depth >= m_levels.size())
+    {
+        m_levels.resize(depth + 1);
+        m_dirtyLevels.resize(depth + 1);
+    }
+    auto& level = m_levels[depth];
+    t->m_depth = depth;
+    t->m_levelIndex = static_cast<uint32>(level.size());
+    level.push_back(t);
+    if (t->m_isDirty.load())
+        AddToDirty(t);
+}
+
+void TransformSystem::RemoveFromLevels(TransformComponent* t)
+{
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    auto& level = m_levels[t->m_depth];
+    TransformComponent* last = level.back();
+    level[t->m_levelIndex] = last;
+    last->m_levelIndex = t->m_levelIndex;
+    level.pop_back();
+    RemoveFromDirty(t);
+}
+
+void TransformSystem::OnParentChanged(TransformComponent* t)
+{
+    RemoveFromLevels(t);
+    AddToLevels(t);
+    for (auto child : t->m_children)
+    {
+        if (child->m_system == this)
+            OnParentChanged(child);
+    }
+}
 
-    t->SetToModel(toModel);
+void TransformSystem::RemoveFromMoved(TransformComponent* t)
+{
+    if (t->m_movedIndex >= m_movedTransforms.size() || m_movedTransforms[t->m_movedIndex] != t)
+        return;
+    TransformComponent* last = m_movedTransforms.back();
+    m_movedTransforms[t->m_movedIndex] = last;
+    last->m_movedIndex = t->m_movedIndex;
+    m_movedTransforms.pop_back();
+}
+
+void TransformSystem::MarkDirty(TransformComponent* t)
+{
+    std::lock_guard<std::mutex> lock(m_dirtyMutex);
+    AddToDirty(t);
+}
+
+bool TransformSystem::IsInDirty(const TransformComponent* t) const
+{
+    const auto& dirty = m_dirtyLevels[t->m_depth];
+    return t->m_dirtyIndex < dirty.size() && dirty[t->m_dirtyIndex] == t;
+}
+
+void TransformSystem::AddToDirty(TransformComponent* t)
+{
+    if (IsInDirty(t))
+        return;
+    auto& dirty = m_dirtyLevels[t->m_depth];
+    t->m_dirtyIndex = static_cast<uint32>(dirty.size());
+    dirty.push_back(t);
+}
+
+void TransformSystem::RemoveFromDirty(TransformComponent* t)
+{
+    if (!IsInDirty(t))
+        return;
+    auto& dirty = m_dirtyLevels[t->m_depth];
+    TransformComponent* last = dirty.back();
+    dirty[t->m_dirtyIndex] = last;
+    last->m_dirtyIndex = t->m_dirtyIndex;
+    dirty.pop_back();
 }
 }
\ No newline at end of file
@@ -1,29 +1,74 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include "Core/CoreTypes.h"
 #include "Core/Core.h"
 
 #include "Core/ECS/SceneSystem.h"
+#include "Math/Matrix4.h"
 
 namespace Kioto
 {
 class TransformComponent;
 
+///
+/// Composes world matrices of transforms. Transforms are kept in flat arrays per hierarchy depth, dirty transforms
+/// are tracked in the same per depth way. Only dirty levels are visited, level by level so parents are always composed
+/// before their children, transforms of one level are composed in parallel.
+///
 class TransformSystem : public SceneSystem
 {
 public:
-    TransformSystem();
-    ~TransformSystem() override;
+    KIOTO_API TransformSystem();
+    KIOTO_API ~TransformSystem() override;
 
     void OnEntityAdd(Entity* entity) override;
     void OnEntityRemove(Entity* entity) override;
     KIOTO_API void Update(float32 dt) override;
 
+    ///
+    /// Get transforms whose world matrices were composed by the last update, so that systems after it update only moved objects.
+    ///
+    const std::vector<TransformComponent*>& GetMovedTransforms() const;
+
 private:
-    void ComposeMatricies(TransformComponent* t);
+    ///
+    /// Compose matrices of count transforms of one depth level.
+    ///
+    void ComposeMatricies(TransformComponent* const* transforms, uint32 count);
+    void FinishCompose(TransformComponent* t, const Matrix4& toParent, const Matrix4& toWorld);
+    void AddToLevels(TransformComponent* t);
+    void RemoveFromLevels(TransformComponent* t);
+    void OnParentChanged(TransformComponent* t);
+    ///
+    /// Swap remove from the moved list, order of moved transforms is not kept.
+    ///
+    void RemoveFromMoved(TransformComponent* t);
+    void MarkDirty(TransformComponent* t);
+    ///
+    /// Dirty lists are changed under m_dirtyMutex only. The list is the source of truth, the flag of a transform may be
+    /// set before its MarkDirty takes the lock.
+    ///
+    bool IsInDirty(const TransformComponent* t) const;
+    void AddToDirty(TransformComponent* t);
+    void RemoveFromDirty(TransformComponent* t);
+
+    static constexpr uint32 ComposeGrainSize = 256;
+    static constexpr uint32 ComposeBatchSize = 64; // Transforms gathered on stack for one batch call.
+
+    std::vector<std::vector<TransformComponent*>> m_levels;
+    std::vector<std::vector<TransformComponent*>> m_dirtyLevels;
+    std::vector<TransformComponent*> m_composing; // Dirty list of the level being composed, swapped out of m_dirtyLevels.
+    std::vector<TransformComponent*> m_movedTransforms;
+    std::mutex m_dirtyMutex; // Transforms can be moved from jobs of other systems.
 
-    std::vector<TransformComponent*> m_components;
+    friend class TransformComponent;
 };
+
+inline const std::vector<TransformComponent*>& TransformSystem::GetMovedTransforms() const
+{
+    return m_movedTransforms;
+}
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+#include "Render/HandleTable.h"
+
+namespace Kioto::Tests
+{
+namespace
+{
+using namespace Renderer;
+
+using TestTable = HandleTable<TextureHandle, uint32>;
+
+void TestValuesAreFoundByHandles()
+{
+    TestTable table;
+    table[TextureHandle(3)] = 30;
+    table[TextureHandle(5000)] = 50;
+    KIOTO_CHECK(table.GetSize() == 2);
+    KIOTO_CHECK(table.Find(TextureHandle(3)) != nullptr && *table.Find(TextureHandle(3)) == 30);
+    KIOTO_CHECK(table.Find(TextureHandle(5000)) != nullptr && *table.Find(TextureHandle(5000)) == 50);
+    KIOTO_CHECK(!table.Contains(TextureHandle(4)));
+    KIOTO_CHECK(!table.Contains(TextureHandle(100000)));
+}
+
+void TestRemoveMovesLastValue()
+{
+    TestTable table;
+    table[TextureHandle(1)] = 10;
+    table[TextureHandle(2)] = 20;
+    table[TextureHandle(3)] = 30;
+    KIOTO_CHECK(table.Remove(TextureHandle(1)));
+    KIOTO_CHECK(!table.Remove(TextureHandle(1)));
+    KIOTO_CHECK(table.GetSize() == 2);
+    KIOTO_CHECK(!table.Contains(TextureHandle(1)));
+    KIOTO_CHECK(*table.Find(TextureHandle(2)) == 20);
+    KIOTO_CHECK(*table.Find(TextureHandle(3)) == 30);
+}
+
+void TestHandlesOfReleasedPageAreAddedAgain()
+{
+    // Removing the only handle of a page releases the page, the next handle of the page allocates it again.
+    TestTable table;
+    table[TextureHandle(2048)] = 1;
+    table.Remove(TextureHandle(2048));
+    KIOTO_CHECK(table.IsEmpty());
+    KIOTO_CHECK(!table.Contains(TextureHandle(2049)));
+    table[TextureHandle(2049)] = 2;
+    KIOTO_CHECK(*table.Find(TextureHandle(2049)) == 2);
+    KIOTO_CHECK(!table.Contains(TextureHandle(2048)));
+}
+
+void TestReservedHandlesAreStored()
+{
+    TestTable table;
+    table[TextureHandle(DefaultBackBufferHandle)] = 1;
+    table[TextureHandle(TestTable::MaxHandle)] = 2;
+    table[TextureHandle(7)] = 3;
+    KIOTO_CHECK(*table.Find(TextureHandle(DefaultBackBufferHandle)) == 1);
+    KIOTO_CHECK(*table.Find(TextureHandle(TestTable::MaxHandle)) == 2);
+
+    // Removal moves the value of handle 7 in place of a reserved handle value.
+    KIOTO_CHECK(table.Remove(TextureHandle(DefaultBackBufferHandle)));
+    KIOTO_CHECK(!table.Contains(TextureHandle(DefaultBackBufferHandle)));
+    KIOTO_CHECK(*table.Find(TextureHandle(7)) == 3);
+    KIOTO_CHECK(*table.Find(TextureHandle(TestTable::MaxHandle)) == 2);
+}
+}
+
+void RunHandleTableTests()
+{
+    TestValuesAreFoundByHandles();
+    TestRemoveMovesLastValue();
+    TestHandlesOfReleasedPageAreAddedAgain();
+    TestReservedHandlesAreStored();
+}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+#include "Component/CameraComponent.h"
+#include "Component/RenderComponent.h"
+#include "Component/TransformComponent.h"
+#include "Core/ECS/Entity.h"
+#include "Core/KiotoEngine.h"
+#include "Core/Scene.h"
+
+namespace Kioto::Tests
+{
+namespace
+{
+constexpr uint32 HeadlessFramesCount = 64;
+constexpr uint32 HeadlessObjectsCount = 32;
+
+void CreateHeadlessScene()
+{
+    Scene* scene = new Scene("HeadlessTests");
+    SetScene(scene);
+
+    Entity* camera = new Entity();
+    camera->SetName("Camera");
+    camera->AddComponent(new TransformComponent());
+    CameraComponent* cameraComponent = new CameraComponent(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    cameraComponent->SetIsMain(true);
+    camera->AddComponent(cameraComponent);
+    camera->GetTransform()->SetLocalPosition({ 0.0f, 0.0f, -20.0f });
+    scene->AddEntity(camera);
+
+    for (uint32 i = 0; i < HeadlessObjectsCount; ++i)
+    {
+        Entity* entity = new Entity();
+        entity->SetName("Box" + std::to_string(i));
+        entity->AddComponent(new TransformComponent());
+        RenderComponent* renderComponent = new RenderComponent();
+        renderComponent->SetMaterial("Materials/UnlitRandMbrick.mt");
+        renderComponent->SetMesh("Models/Cube.glb");
+        entity->AddComponent(renderComponent);
+        entity->GetTransform()->SetLocalPosition({ static_cast<float32>(i % 8) * 2.0f - 8.0f, static_cast<float32>(i / 8) * 2.0f - 4.0f, 0.0f });
+        scene->AddEntity(entity);
+    }
+}
+
+///
+/// Engine is initialized once per process, so all headless cases check the same run.
+///
+const HeadlessRunResult& GetHeadlessRun()
+{
+    static HeadlessRunResult result = KiotoHeadlessMain("", HeadlessFramesCount, &CreateHeadlessScene);
+    return result;
+}
+
+void TestHeadlessFramesAreValid()
+{
+    const HeadlessRunResult& result = GetHeadlessRun();
+    KIOTO_CHECK(result.FramesCount == HeadlessFramesCount);
+    KIOTO_CHECK(result.DrawsCount >= static_cast<uint64>(HeadlessFramesCount) * HeadlessObjectsCount / 2);
+    KIOTO_CHECK(result.ValidationErrors == 0);
+}
+
+void TestHeadlessSteadyFramesDontAllocate()
+{
+    const HeadlessRunResult& result = GetHeadlessRun();
+    KIOTO_CHECK(result.SteadyFramesCount > 0);
+    if (result.SteadyHeapAllocationsCount > 0)
+        std::printf("Heap allocations in %u steady state frames: %llu\n", result.SteadyFramesCount, result.SteadyHeapAllocationsCount);
+    KIOTO_CHECK(result.SteadyHeapAllocationsCount == 0);
+}
+}
+
+void RunHeadlessTests()
+{
+    TestHeadlessFramesAreValid();
+    TestHeadlessSteadyFramesDontAllocate();
+}
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "Render/PipelineCache.h"
+#include "Render/PipelineCompileQueue.h"
+#include "Render/PipelineState.h"
+#include "Render/VertexLayout.h"
+
+namespace Kioto::Tests
+{
+namespace
+{
+using namespace Renderer;
+
+struct KeyInput
+{
+    PipelineState State;
+    uint64 ShaderHash = 1;
+    VertexLayout Layout = VertexLayout::LayoutPos3Norm3Uv2;
+    std::vector<uint32> RenderTargetFormats{ 28 };
+    uint32 DepthStencilFormat = 44;
+
+    uint64 ComputeKey() const
+    {
+        return PipelineCache::ComputeKey(State, ShaderHash, Layout, RenderTargetFormats.data(), static_cast<uint32>(RenderTargetFormats.size()), DepthStencilFormat);
+    }
+};
+
+std::vector<byte> MakeBlob(uint32 size, byte first)
+{
+    std::vector<byte> blob(size);
+    for (uint32 i = 0; i < size; ++i)
+        blob[i] = static_cast<byte>(first + i);
+    return blob;
+}
+
+void TestKeyDependsOnEveryField()
+{
+    const uint64 baseKey = KeyInput().ComputeKey();
+    KIOTO_CHECK(KeyInput().ComputeKey() == baseKey);
+
+    const std::vector<std::function<void(KeyInput&)>> changes =
+    {
+        [](KeyInput& in) { in.State.LayerType = eRenderLayerType::Transparent; },
+        [](KeyInput& in) { in.State.Fill = eFillMode::Wireframe; },
+        [](KeyInput& in) { in.State.Cull = eCullMode::None; },
+        [](KeyInput& in) { in.State.Ztest = eZTest::Less; },
+        [](KeyInput& in) { in.State.FrontFaceStencilDesc.StencilFailOp = eStencilOp::Keep; },
+        [](KeyInput& in) { in.State.FrontFaceStencilDesc.StencilDepthFailOp = eStencilOp::Keep; },
+        [](KeyInput& in) { in.State.FrontFaceStencilDesc.StencilPassOp = eStencilOp::Keep; },
+        [](KeyInput& in) { in.State.BackFaceStencilDesc.StencilPassOp = eStencilOp::Replace; },
+        [](KeyInput& in) { in.State.StencilWriteMask = 0x1; },
+        [](KeyInput& in) { in.State.StencilReadMask = 0x1; },
+        [](KeyInput& in) { in.State.SrcBlend = eBlendModes::One; },
+        [](KeyInput& in) { in.State.DstBlend = eBlendModes::Zero; },
+        [](KeyInput& in) { in.State.BlendOp = eBlendOps::Substract; },
+        [](KeyInput& in) { in.State.ColorMask = eColorMask::Red; },
+        [](KeyInput& in) { in.State.Zwrite = false; },
+        [](KeyInput& in) { in.State.EnableStencill = true; },
+        [](KeyInput& in) { in.State.EnableDepth = true; },
+        [](KeyInput& in) { in.State.WindingCCW = false; },
+        [](KeyInput& in) { in.ShaderHash = 2; },
+        [](KeyInput& in) { in.Layout = VertexLayout::LayoutPos3Norm3; },
+        [](KeyInput& in) { in.RenderTargetFormats[0] = 29; },
+        [](KeyInput& in) { in.RenderTargetFormats.push_back(28); },
+        [](KeyInput& in) { in.DepthStencilFormat = 45; },
+    };
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        KeyInput in;
+        changes[i](in);
+        if (in.ComputeKey() == baseKey)
+            std::printf("Pipeline key doesn't depend on field change %zu\n", i);
+        KIOTO_CHECK(in.ComputeKey() != baseKey);
+    }
+
+    // Shader pointer differs between runs, shaders are identified by bytecode hash only.
+    KeyInput in;
+    in.State.Shader = reinterpret_cast<Shader*>(&in);
+    KIOTO_CHECK(in.ComputeKey() == baseKey);
+}
+
+void TestSerializationRoundTrip()
+{
+    PipelineCache cache;
+    cache.SetDeviceTag(7);
+    cache.Store(1, MakeBlob(16, 0));
+    cache.Store(2, MakeBlob(300, 5));
+    cache.Store(3, {});
+    KIOTO_CHECK(cache.GetIsDirty());
+    std::vector<byte> data = cache.Serialize();
+
+    PipelineCache loaded;
+    loaded.SetDeviceTag(7);
+    KIOTO_CHECK(loaded.Deserialize(data.data(), data.size()));
+    KIOTO_CHECK(loaded.GetEntriesCount() == 3);
+    KIOTO_CHECK(!loaded.GetIsDirty());
+    std::vector<byte> blob;
+    KIOTO_CHECK(loaded.Find(1, blob) && blob == MakeBlob(16, 0));
+    KIOTO_CHECK(loaded.Find(2, blob) && blob == MakeBlob(300, 5));
+    KIOTO_CHECK(loaded.Find(3, blob) && blob.empty());
+    KIOTO_CHECK(!loaded.Find(4, blob));
+}
+
+void TestBrokenFilesAreRejected()
+{
+    PipelineCache cache;
+    cache.SetDeviceTag(7);
+    cache.Store(1, MakeBlob(64, 0));
+    cache.Store(2, MakeBlob(64, 100));
+    const std::vector<byte> data = cache.Serialize();
+
+    PipelineCache loaded;
+    loaded.SetDeviceTag(7);
+    KIOTO_CHECK(!loaded.Deserialize(data.data(), data.size() - 1));
+    KIOTO_CHECK(loaded.GetEntriesCount() == 0);
+    KIOTO_CHECK(!loaded.Deserialize(data.data(), 10));
+    KIOTO_CHECK(!loaded.Deserialize(nullptr, 0));
+
+    std::vector<byte> corrupted = data;
+    corrupted.back() ^= 0xFF;
+    KIOTO_CHECK(!loaded.Deserialize(corrupted.data(), corrupted.size()));
+    KIOTO_CHECK(loaded.GetEntriesCount() == 0);
+
+    std::vector<byte> badMagic = data;
+    badMagic[0] ^= 0xFF;
+    KIOTO_CHECK(!loaded.Deserialize(badMagic.data(), badMagic.size()));
+
+    std::vector<byte> trailing = data;
+    trailing.push_back(0);
+    KIOTO_CHECK(!loaded.Deserialize(trailing.data(), trailing.size()));
+
+    PipelineCache otherDevice;
+    otherDevice.SetDeviceTag(8);
+    KIOTO_CHECK(!otherDevice.Deserialize(data.data(), data.size()));
+    KIOTO_CHECK(otherDevice.GetEntriesCount() == 0);
+
+    KIOTO_CHECK(loaded.Deserialize(data.data(), data.size()));
+    KIOTO_CHECK(loaded.GetEntriesCount() == 2);
+}
+
+void TestQueueWithoutThreadsRunsJobsImmediately()
+{
+    PipelineCompileQueue<uint32> queue;
+    KIOTO_CHECK(!queue.GetIsStarted());
+    uint32 runsCount = 0;
+    KIOTO_CHECK(queue.Enqueue(1, [&runsCount]() { ++runsCount; return 10u; }));
+    KIOTO_CHECK(runsCount == 1);
+    KIOTO_CHECK(queue.IsPending(1));
+    KIOTO_CHECK(!queue.Enqueue(1, [&runsCount]() { ++runsCount; return 11u; }));
+    KIOTO_CHECK(runsCount == 1);
+    KIOTO_CHECK(queue.Enqueue(2, []() { return 20u; }));
+
+    std::vector<std::pair<uint64, uint32>> results;
+    queue.CollectCompleted([&results](uint64 key, uint32 result) { results.emplace_back(key, result); });
+    KIOTO_CHECK(results.size() == 2);
+    KIOTO_CHECK(results.size() == 2 && results[0] == std::make_pair(1ull, 10u) && results[1] == std::make_pair(2ull, 20u));
+    KIOTO_CHECK(queue.GetPendingCount() == 0);
+    KIOTO_CHECK(queue.Enqueue(1, []() { return 12u; }));
+}
+
+void TestQueueWithThreadsCompletesAllJobs()
+{
+    constexpr uint32 JobsCount = 64;
+    PipelineCompileQueue<uint64> queue;
+    queue.Start(2);
+    KIOTO_CHECK(queue.GetIsStarted());
+    for (uint32 i = 0; i < JobsCount; ++i)
+        KIOTO_CHECK(queue.Enqueue(i, [i]() { return static_cast<uint64>(i) * 3; }));
+
+    std::vector<uint32> resultsCount(JobsCount, 0);
+    uint32 collectedCount = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (collectedCount < JobsCount && std::chrono::steady_clock::now() < deadline)
+    {
+        queue.CollectCompleted([&](uint64 key, uint64 result)
+        {
+            KIOTO_CHECK(key < JobsCount && result == key * 3);
+            if (key < JobsCount)
+                ++resultsCount[key];
+            ++collectedCount;
+        });
+        std::this_thread::yield();
+    }
+    KIOTO_CHECK(collectedCount == JobsCount);
+    for (uint32 i = 0; i < JobsCount; ++i)
+        KIOTO_CHECK(resultsCount[i] == 1);
+    KIOTO_CHECK(queue.GetPendingCount() == 0);
+
+    queue.Stop();
+    KIOTO_CHECK(!queue.GetIsStarted());
+}
+}
+
+void RunPipelineCacheTests()
+{
+    TestKeyDependsOnEveryField();
+    TestSerializationRoundTrip();
+    TestBrokenFilesAreRejected();
+    TestQueueWithoutThreadsRunsJobsImmediately();
+    TestQueueWithThreadsCompletesAllJobs();
+}
+}
\ No newline at end of file
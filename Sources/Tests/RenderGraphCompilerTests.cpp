@@ -0,0 +1,196 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Render/RenderGraph/RenderGraphCompiler.h"
+
+namespace Kioto::Tests
+{
+namespace
+{
+using namespace Renderer;
+
+TextureDescriptor MakeDescriptor(uint32 width, uint32 height)
+{
+    TextureDescriptor desc;
+    desc.Format = eResourceFormat::Format_R8G8B8A8_UNORM;
+    desc.InitialState = eResourceState::Common;
+    desc.Width = width;
+    desc.Height = height;
+    return desc;
+}
+
+std::vector<const ResourcesBlackboard*> GetPointers(const std::vector<ResourcesBlackboard>& passes)
+{
+    std::vector<const ResourcesBlackboard*> res;
+    for (const auto& pass : passes)
+        res.push_back(&pass);
+    return res;
+}
+
+std::vector<uint32> GetOrder(const CompiledGraph& graph)
+{
+    std::vector<uint32> res;
+    for (const auto& pass : graph.Passes)
+        res.push_back(pass.PassIndex);
+    return res;
+}
+
+const CompiledPass* FindPass(const CompiledGraph& graph, uint32 passIndex)
+{
+    auto it = std::find_if(graph.Passes.begin(), graph.Passes.end(), [passIndex](const CompiledPass& pass) { return pass.PassIndex == passIndex; });
+    return it != graph.Passes.end() ? &*it : nullptr;
+}
+
+void TestReaderRegisteredBeforeWriter()
+{
+    // Pass 0 reads the result of pass 1, so pass 1 goes first although it is registered later.
+    std::vector<ResourcesBlackboard> passes(2);
+    passes[0].ScheduleRead("Shadow");
+    passes[0].ScheduleWriteBackBuffer();
+    passes[1].NewTexture("Shadow", MakeDescriptor(512, 512));
+    passes[1].ScheduleWrite("Shadow");
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(!graph.HasCycle);
+    KIOTO_CHECK(GetOrder(graph) == std::vector<uint32>({ 1, 0 }));
+    KIOTO_CHECK(graph.CulledPasses.empty());
+}
+
+void TestRegistrationOrderIsKept()
+{
+    // Independent back buffer writers keep registration order.
+    std::vector<ResourcesBlackboard> passes(3);
+    for (auto& pass : passes)
+        pass.ScheduleWriteBackBuffer();
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(GetOrder(graph) == std::vector<uint32>({ 0, 1, 2 }));
+}
+
+void TestUnusedPassesAreCulled()
+{
+    // Pass 1 output is never read and pass 1 doesn't write the back buffer.
+    std::vector<ResourcesBlackboard> passes(3);
+    passes[0].NewTexture("Color", MakeDescriptor(64, 64));
+    passes[0].ScheduleWrite("Color");
+    passes[1].NewTexture("Unused", MakeDescriptor(64, 64));
+    passes[1].ScheduleWrite("Unused");
+    passes[2].ScheduleRead("Color");
+    passes[2].ScheduleWriteBackBuffer();
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(GetOrder(graph) == std::vector<uint32>({ 0, 2 }));
+    KIOTO_CHECK(graph.CulledPasses == std::vector<uint32>({ 1 }));
+    KIOTO_CHECK(graph.TransientResources.size() == 1);
+}
+
+void TestCycleIsReported()
+{
+    std::vector<ResourcesBlackboard> passes(2);
+    passes[0].ScheduleRead("X");
+    passes[0].ScheduleWrite("Y");
+    passes[0].ScheduleWriteBackBuffer();
+    passes[1].ScheduleRead("Y");
+    passes[1].ScheduleWrite("X");
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(graph.HasCycle);
+    // Passes of the cycle fall back to registration order.
+    KIOTO_CHECK(GetOrder(graph) == std::vector<uint32>({ 0, 1 }));
+}
+
+void TestTransientResourcesAreAliased()
+{
+    // Chain of passes each reading the previous texture: T0 and T2 lifetimes don't overlap, so they share memory.
+    std::vector<ResourcesBlackboard> passes(4);
+    const TextureDescriptor desc = MakeDescriptor(256, 256);
+    passes[0].NewTexture("T0", desc);
+    passes[0].ScheduleWrite("T0");
+    passes[1].ScheduleRead("T0");
+    passes[1].NewTexture("T1", desc);
+    passes[1].ScheduleWrite("T1");
+    passes[2].ScheduleRead("T1");
+    passes[2].NewTexture("T2", desc);
+    passes[2].ScheduleWrite("T2");
+    passes[3].ScheduleRead("T2");
+    passes[3].ScheduleWriteBackBuffer();
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(graph.TransientResources.size() == 3);
+    KIOTO_CHECK(graph.PhysicalResources.size() == 2);
+    if (graph.TransientResources.size() == 3)
+    {
+        KIOTO_CHECK(graph.TransientResources[0].PhysicalIndex == graph.TransientResources[2].PhysicalIndex);
+        KIOTO_CHECK(graph.TransientResources[0].PhysicalIndex != graph.TransientResources[1].PhysicalIndex);
+    }
+    KIOTO_CHECK(graph.AliasedMemorySize < graph.TransientMemorySize);
+
+    // Different descriptors are never aliased.
+    passes[2].Clear();
+    passes[2].ScheduleRead("T1");
+    passes[2].NewTexture("T2", MakeDescriptor(128, 128));
+    passes[2].ScheduleWrite("T2");
+    compiler.Compile(GetPointers(passes), graph);
+    KIOTO_CHECK(graph.PhysicalResources.size() == 3);
+}
+
+void TestOnlyStateChangesAreTransitions()
+{
+    // Pass 1 writes the texture in the state pass 0 left it in, so only pass 0 and the reader transition it.
+    std::vector<ResourcesBlackboard> passes(3);
+    passes[0].NewTexture("Color", MakeDescriptor(64, 64));
+    passes[0].ScheduleWrite("Color");
+    passes[1].ScheduleWrite("Color");
+    passes[2].ScheduleRead("Color");
+    passes[2].ScheduleWriteBackBuffer();
+
+    RenderGraphCompiler compiler;
+    CompiledGraph graph;
+    compiler.Compile(GetPointers(passes), graph);
+    ResourceStates states;
+    for (const auto& desc : graph.PhysicalResources)
+        states.push_back(desc.InitialState);
+    RenderGraphCompiler::ComputeTransitions(states, graph);
+
+    const CompiledPass* first = FindPass(graph, 0);
+    const CompiledPass* second = FindPass(graph, 1);
+    const CompiledPass* reader = FindPass(graph, 2);
+    KIOTO_CHECK(first != nullptr && second != nullptr && reader != nullptr);
+    if (first == nullptr || second == nullptr || reader == nullptr)
+        return;
+    KIOTO_CHECK(first->Transitions.size() == 1 && first->Transitions[0].TransitionTo == eResourceState::RenderTarget);
+    KIOTO_CHECK(second->Transitions.empty());
+    KIOTO_CHECK(reader->Transitions.size() == 1 && reader->Transitions[0].TransitionTo == eResourceState::PixelShaderResource);
+    KIOTO_CHECK(states.size() == 1 && states[0] == eResourceState::PixelShaderResource);
+
+    // Next frame starts from the states left by this one, the writer transitions the texture back.
+    RenderGraphCompiler::ComputeTransitions(states, graph);
+    KIOTO_CHECK(first->Transitions.size() == 1 && first->Transitions[0].TransitionTo == eResourceState::RenderTarget);
+    KIOTO_CHECK(second->Transitions.empty());
+}
+}
+
+void RunRenderGraphCompilerTests()
+{
+    TestReaderRegisteredBeforeWriter();
+    TestRegistrationOrderIsKept();
+    TestUnusedPassesAreCulled();
+    TestCycleIsReported();
+    TestTransientResourcesAreAliased();
+    TestOnlyStateChangesAreTransitions();
+}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdio>
+
+#include "Core/CoreTypes.h"
+
+namespace Kioto::Tests
+{
+///
+/// Count of failed checks of the run, tests executable returns it as the exit code.
+///
+inline uint32 FailedChecksCount = 0;
+
+///
+/// Test groups, each group is one function running all its cases.
+///
+void RunRenderGraphCompilerTests();
+void RunHandleTableTests();
+void RunHeadlessTests();
+void RunPipelineCacheTests();
+void RunUploadRingAllocatorTests();
+}
+
+///
+/// Check condition and report file and line on failure. Execution continues, so one run reports all failed checks.
+///
+#define KIOTO_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++Kioto::Tests::FailedChecksCount; \
+        } \
+    } while (false)
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+///
+/// Tests of engine parts which don't need window or GPU, engine runs on null render backend. Returns count of failed checks.
+///
+int main()
+{
+    Kioto::Tests::RunRenderGraphCompilerTests();
+    Kioto::Tests::RunHandleTableTests();
+    Kioto::Tests::RunUploadRingAllocatorTests();
+    Kioto::Tests::RunPipelineCacheTests();
+    Kioto::Tests::RunHeadlessTests();
+
+    std::printf("Failed checks: %u\n", Kioto::Tests::FailedChecksCount);
+    return static_cast<int>(Kioto::Tests::FailedChecksCount);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "stdafx.h"
+
+#include "Tests/Tests.h"
+
+#include "Render/Buffers/UploadRingAllocator.h"
+
+namespace Kioto::Tests
+{
+namespace
+{
+using namespace Renderer;
+
+void TestAllocationsAreAligned()
+{
+    UploadRingAllocator ring(4096);
+    KIOTO_CHECK(ring.Allocate(1) == 0);
+    KIOTO_CHECK(ring.Allocate(300) == 256);
+    KIOTO_CHECK(ring.Allocate(256) == 768);
+    KIOTO_CHECK(ring.GetUsedSize() == 1024);
+    KIOTO_CHECK(ring.GetFrameUsedSize() == 1024);
+}
+
+void TestFramesAreReclaimedByFence()
+{
+    UploadRingAllocator ring(4096);
+    ring.Allocate(512);
+    ring.FinishFrame(1);
+    ring.Allocate(1024);
+    ring.FinishFrame(2);
+    KIOTO_CHECK(ring.GetFrameUsedSize() == 0);
+    KIOTO_CHECK(ring.GetOldestFenceValue() == 1);
+
+    ring.Reclaim(0);
+    KIOTO_CHECK(ring.GetUsedSize() == 1536);
+    ring.Reclaim(1);
+    KIOTO_CHECK(ring.GetUsedSize() == 1024);
+    KIOTO_CHECK(ring.GetOldestFenceValue() == 2);
+    ring.Reclaim(5);
+    KIOTO_CHECK(ring.GetUsedSize() == 0);
+    KIOTO_CHECK(ring.GetOldestFenceValue() == 0);
+
+    // Frame without allocations holds nothing and is not tracked.
+    ring.FinishFrame(6);
+    KIOTO_CHECK(ring.GetOldestFenceValue() == 0);
+}
+
+void TestAllocationWrapsAround()
+{
+    UploadRingAllocator ring(1024);
+    KIOTO_CHECK(ring.Allocate(512) == 0);
+    ring.FinishFrame(1);
+    KIOTO_CHECK(ring.Allocate(256) == 512);
+    ring.FinishFrame(2);
+    ring.Reclaim(1);
+
+    // 256 bytes are left at the end, 512 don't fit there, so they go to the freed start and the end is skipped.
+    KIOTO_CHECK(ring.Allocate(512) == 0);
+    KIOTO_CHECK(ring.GetUsedSize() == 1024);
+    ring.FinishFrame(3);
+
+    // Skipped end is freed with the frame which has wrapped.
+    ring.Reclaim(2);
+    KIOTO_CHECK(ring.GetUsedSize() == 768);
+    KIOTO_CHECK(ring.Allocate(256) == 512);
+    ring.FinishFrame(4);
+    ring.Reclaim(4);
+    KIOTO_CHECK(ring.GetUsedSize() == 0);
+}
+
+void TestFullRingReturnsInvalidOffset()
+{
+    UploadRingAllocator ring(1024);
+    KIOTO_CHECK(ring.Allocate(2048) == UploadRingAllocator::InvalidOffset);
+    KIOTO_CHECK(ring.Allocate(1024) == 0);
+    KIOTO_CHECK(ring.Allocate(1) == UploadRingAllocator::InvalidOffset);
+    ring.FinishFrame(1);
+
+    ring.Reclaim(1);
+    KIOTO_CHECK(ring.Allocate(1024) == 0);
+    ring.FinishFrame(2);
+
+    // Free space at the end and at the start is not contiguous, so it doesn't hold an allocation larger than either part.
+    ring.Reclaim(2);
+    KIOTO_CHECK(ring.Allocate(512) == 0);
+    ring.FinishFrame(3);
+    KIOTO_CHECK(ring.Allocate(256) == 512);
+    ring.FinishFrame(4);
+    ring.Reclaim(3);
+    KIOTO_CHECK(ring.GetUsedSize() == 256);
+    KIOTO_CHECK(ring.Allocate(768) == UploadRingAllocator::InvalidOffset);
+    KIOTO_CHECK(ring.Allocate(512) == 0);
+}
+}
+
+void RunUploadRingAllocatorTests()
+{
+    TestAllocationsAreAligned();
+    TestFramesAreReclaimedByFence();
+    TestAllocationWrapsAround();
+    TestFullRingReturnsInvalidOffset();
+}
+}
\ No newline at end of file